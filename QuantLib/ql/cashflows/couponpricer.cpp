@@ -33,6 +33,23 @@ using boost::dynamic_pointer_cast;
 
 namespace QuantLib {
 
+//===========================================================================//
+//                         FloatingRateCouponPricer                          //
+//===========================================================================//
+
+    std::vector<Rate> FloatingRateCouponPricer::swapletRates(const Leg& leg) {
+        std::vector<Rate> rates(leg.size(), Null<Rate>());
+        for (Size i=0; i<leg.size(); ++i) {
+            boost::shared_ptr<FloatingRateCoupon> c =
+                dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            if (c) {
+                initialize(*c);
+                rates[i] = swapletRate();
+            }
+        }
+        return rates;
+    }
+
 //===========================================================================//
 //                              BlackIborCouponPricer                        //
 //===========================================================================//
@@ -66,6 +83,104 @@ namespace QuantLib {
         coupon_ = &coupon;
     }
 
+    std::vector<Rate> BlackIborCouponPricer::swapletRates(const Leg& leg) {
+
+        std::vector<Rate> fixings(leg.size(), Null<Rate>());
+        std::vector<Rate> rates(leg.size(), Null<Rate>());
+        std::vector<boost::shared_ptr<IborCoupon> > coupons(leg.size());
+
+        Date today = Settings::instance().evaluationDate();
+        bool enforceTodaysFixings =
+            Settings::instance().enforcesTodaysHistoricFixings();
+
+        // pre-scan: past fixings are read from the index history
+        // (retrieved once per index) while the coupons to be
+        // projected are collected together with their dates
+        std::string historyName;
+        const TimeSeries<Real>* history = 0;
+        Handle<YieldTermStructure> curve;
+        std::vector<Size> projected;
+        std::vector<Date> dates;
+        for (Size i=0; i<leg.size(); ++i) {
+            coupons[i] = dynamic_pointer_cast<IborCoupon>(leg[i]);
+            const boost::shared_ptr<IborCoupon>& c = coupons[i];
+            if (!c) {
+                boost::shared_ptr<FloatingRateCoupon> f =
+                    dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+                if (f) {
+                    initialize(*f);
+                    rates[i] = swapletRate();
+                }
+                continue;
+            }
+
+            const boost::shared_ptr<IborIndex>& index = c->iborIndex();
+            Date fixingDate = c->fixingDate();
+            if (fixingDate <= today) {
+                if (history == 0 || index->name() != historyName) {
+                    historyName = index->name();
+                    history = &IndexManager::instance().getHistory(historyName);
+                }
+                if (fixingDate < today || enforceTodaysFixings) {
+                    // do not catch exceptions
+                    QL_REQUIRE(index->isValidFixingDate(fixingDate),
+                               fixingDate << " is not a valid fixing date");
+                    Rate pastFixing = (*history)[fixingDate];
+                    QL_REQUIRE(pastFixing != Null<Real>(),
+                               "Missing " << index->name() <<
+                               " fixing for " << fixingDate);
+                    fixings[i] = pastFixing;
+                    continue;
+                } else if (index->isValidFixingDate(fixingDate)) {
+                    fixings[i] = (*history)[fixingDate];
+                    if (fixings[i] != Null<Rate>())
+                        continue;
+                    // otherwise fall through and forecast
+                }
+            }
+
+            if (curve.empty()) {
+                curve = index->forwardingTermStructure();
+                QL_REQUIRE(!curve.empty(),
+                           "null term structure set to this instance of " <<
+                           index->name());
+            }
+            if (index->forwardingTermStructure().currentLink() ==
+                                                        curve.currentLink()) {
+                projected.push_back(i);
+                dates.push_back(c->fixingValueDate());
+                dates.push_back(c->fixingEndDate());
+            } else {
+                // a different forwarding curve; projected separately
+                fixings[i] = c->indexFixing();
+            }
+        }
+
+        // projection: all discount factors at once
+        if (!projected.empty()) {
+            std::vector<DiscountFactor> discounts = curve->discount(dates);
+            for (Size j=0; j<projected.size(); ++j) {
+                Size i = projected[j];
+                fixings[i] = (discounts[2*j]/discounts[2*j+1] - 1.0) /
+                    coupons[i]->spanningTime();
+            }
+        }
+
+        for (Size i=0; i<leg.size(); ++i) {
+            const boost::shared_ptr<IborCoupon>& c = coupons[i];
+            if (!c)
+                continue;
+            if (c->isInArrears()) {
+                // the convexity adjustment needs the full setup
+                initialize(*c);
+                rates[i] = gearing_ * adjustedFixing(fixings[i]) + spread_;
+            } else {
+                rates[i] = c->gearing() * fixings[i] + c->spread();
+            }
+        }
+        return rates;
+    }
+
     Real BlackIborCouponPricer::optionletPrice(Option::Type optionType,
                                                Real effStrike) const {
         Date fixingDate = coupon_->fixingDate();
@@ -52,6 +52,18 @@ namespace QuantLib {
         virtual Rate floorletRate(Rate effectiveFloor) const = 0;
         virtual void initialize(const FloatingRateCoupon& coupon) = 0;
         //@}
+        //! \name Leg-level interface
+        //@{
+        /*! Returns the swaplet rates of the floating-rate coupons in
+            the given leg as calculated by this pricer; a null rate is
+            returned in place of any other cash flow.
+
+            The default implementation initializes the pricer on
+            each coupon in turn.  Derived pricers can override it so
+            that calculations are shared across the leg.
+        */
+        virtual std::vector<Rate> swapletRates(const Leg& leg);
+        //@}
         //! \name Observer interface
         //@{
         void update(){notifyObservers();}
@@ -87,6 +99,11 @@ namespace QuantLib {
                                         Handle<OptionletVolatilityStructure>())
         : IborCouponPricer(v) {};
         virtual void initialize(const FloatingRateCoupon& coupon);
+        /*! Projects the forward rates of all Ibor coupons in the leg
+            with a single call to the forwarding curve, after a
+            pre-scan retrieving past fixings from the index history.
+        */
+        virtual std::vector<Rate> swapletRates(const Leg& leg);
         /* */
         Real swapletPrice() const;
         Rate swapletRate() const;
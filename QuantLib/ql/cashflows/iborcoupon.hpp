@@ -53,6 +53,15 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period over which the fixing is forecast
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the period over which the fixing is forecast
+        /*! This might differ from the index maturity when the
+            par-coupon approximation is used.
+        */
+        const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! year fraction between fixing value and end dates
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
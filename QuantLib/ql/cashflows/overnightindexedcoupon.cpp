@@ -22,7 +22,7 @@
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/vectors.hpp>
-#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 
 using std::vector;
 using boost::shared_ptr;
@@ -53,10 +53,26 @@ namespace QuantLib {
 
                 // already fixed part
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
+                const TimeSeries<Real>& history =
+                    IndexManager::instance().getHistory(index->name());
+                Size nPast = std::lower_bound(fixingDates.begin(),
+                                              fixingDates.end(), today)
+                           - fixingDates.begin();
+                while (i<nPast) {
+                    if (i == 1 && nPast > 2) {
+                        // the inner fixings are compounded by the index
+                        // table; the first and last periods might have
+                        // different accruals and are managed here
+                        Real innerFactor =
+                            index->compoundFactor(fixingDates[1],
+                                                  fixingDates[nPast-1]);
+                        if (innerFactor != Null<Real>()) {
+                            compoundFactor *= innerFactor;
+                            i = nPast-1;
+                        }
+                    }
                     // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                    Rate pastFixing = history[fixingDates[i]];
                     QL_REQUIRE(pastFixing != Null<Real>(),
                                "Missing " << index->name() <<
                                " fixing for " << fixingDates[i]);
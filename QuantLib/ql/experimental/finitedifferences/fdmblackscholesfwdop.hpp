@@ -36,7 +36,9 @@ namespace QuantLib {
         FdmBlackScholesFwdOp(
             const boost::shared_ptr<FdmMesher>& mesher,
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
-            Real strike, Size direction);
+            Real strike, Size direction,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>());
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -62,6 +64,7 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
         const Real strike_;
+        const Real illegalLocalVolOverwrite_;
         const Size direction_;
     };
 }
@@ -0,0 +1,368 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/math/integrals/discreteintegrals.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
+#include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdmfwdsurfacesolver.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class Scheme>
+        void rollforward(Scheme& scheme, Array& p,
+                         Time from, Time to, Size steps) {
+            const Time dt = (to - from)/steps;
+            scheme.setStep(dt);
+            for (Size i=1; i < steps; ++i)
+                scheme.step(p, from + i*dt);
+            scheme.step(p, to);
+        }
+
+        Disposable<Matrix> npvMatrix(const FdmFwdSurfaceSolver& solver,
+                                     const YieldTermStructure& rTS,
+                                     const std::vector<Real>& strikes,
+                                     Option::Type type) {
+            const std::vector<Time>& maturities = solver.maturities();
+
+            Matrix npvs(strikes.size(), maturities.size());
+            for (Size j=0; j < maturities.size(); ++j) {
+                const DiscountFactor df = rTS.discount(maturities[j]);
+                for (Size i=0; i < strikes.size(); ++i) {
+                    npvs[i][j] = df*solver.expectation(
+                                  j, PlainVanillaPayoff(type, strikes[i]));
+                }
+            }
+            return npvs;
+        }
+    }
+
+    FdmFwdSurfaceSolver::FdmFwdSurfaceSolver(
+        const boost::shared_ptr<FdmMesherComposite>& mesher,
+        const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+        const Array& p0,
+        const std::vector<Time>& maturities,
+        Size timeSteps,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc)
+    : mesher_(mesher), fwdOp_(fwdOp), p0_(p0),
+      maturities_(maturities),
+      timeSteps_(timeSteps), dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc) {
+
+        QL_REQUIRE(!maturities_.empty(), "no maturities given");
+        QL_REQUIRE(maturities_.front() > 0.0,
+                   "positive maturities required");
+        for (Size i=1; i < maturities_.size(); ++i)
+            QL_REQUIRE(maturities_[i] > maturities_[i-1],
+                       "maturities must be sorted and unique");
+        QL_REQUIRE(p0_.size() == mesher_->layout()->size(),
+                   "inconsistent size of the initial density");
+        QL_REQUIRE(timeSteps_ > 0, "at least one time step required");
+    }
+
+    const std::vector<Time>& FdmFwdSurfaceSolver::maturities() const {
+        return maturities_;
+    }
+
+    const Array& FdmFwdSurfaceSolver::density(Size i) const {
+        QL_REQUIRE(i < maturities_.size(), "index (" << i << ") out of range");
+        calculate();
+        return densities_[i];
+    }
+
+    Real FdmFwdSurfaceSolver::expectation(Size i,
+                                          const Payoff& payoff) const {
+        const Array& p = density(i);
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+
+        Array f(layout->size());
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            const Size idx = iter.index();
+            f[idx] = payoff(std::exp(mesher_->location(iter, 0)))*p[idx];
+        }
+
+        return FdmMesherIntegral(mesher_,
+                                 DiscreteSimpsonIntegral()).integrate(f);
+    }
+
+    void FdmFwdSurfaceSolver::performCalculations() const {
+        const Time horizon = maturities_.back();
+
+        densities_.clear();
+        densities_.reserve(maturities_.size());
+
+        Array p = p0_;
+        Time t = 0.0;
+        Size dampingSteps = dampingSteps_;
+        for (Size i=0; i < maturities_.size(); ++i) {
+            const Time maturity = maturities_[i];
+            const Size steps = std::max(Size(1),
+                Size(timeSteps_*(maturity - t)/horizon + 0.5));
+            const Time dt = (maturity - t)/steps;
+
+            const Size implicitSteps = std::min(dampingSteps, steps);
+            const Time dampingTo = (implicitSteps == steps)
+                                   ? maturity : t + implicitSteps*dt;
+            if (implicitSteps) {
+                ImplicitEulerScheme implicitEvolver(fwdOp_);
+                rollforward(implicitEvolver, p, t, dampingTo, implicitSteps);
+                dampingSteps -= implicitSteps;
+            }
+
+            const Size remaining = steps - implicitSteps;
+            if (remaining) {
+                switch (schemeDesc_.type) {
+                  case FdmSchemeDesc::HundsdorferType:
+                    {
+                        HundsdorferScheme evolver(schemeDesc_.theta,
+                                                  schemeDesc_.mu, fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  case FdmSchemeDesc::DouglasType:
+                    {
+                        DouglasScheme evolver(schemeDesc_.theta, fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  case FdmSchemeDesc::CraigSneydType:
+                    {
+                        CraigSneydScheme evolver(schemeDesc_.theta,
+                                                 schemeDesc_.mu, fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  case FdmSchemeDesc::ModifiedCraigSneydType:
+                    {
+                        ModifiedCraigSneydScheme evolver(schemeDesc_.theta,
+                                                         schemeDesc_.mu,
+                                                         fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  case FdmSchemeDesc::ImplicitEulerType:
+                    {
+                        ImplicitEulerScheme evolver(fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  case FdmSchemeDesc::ExplicitEulerType:
+                    {
+                        ExplicitEulerScheme evolver(fwdOp_);
+                        rollforward(evolver, p, dampingTo, maturity,
+                                    remaining);
+                    }
+                    break;
+                  default:
+                    QL_FAIL("Unknown scheme type");
+                }
+            }
+
+            densities_.push_back(p);
+            t = maturity;
+        }
+    }
+
+    Disposable<Array> FdmFwdSurfaceSolver::diracDelta(
+                          const boost::shared_ptr<FdmMesherComposite>& mesher,
+                          const std::vector<Real>& x) {
+
+        const std::vector<boost::shared_ptr<Fdm1dMesher> >& meshers
+            = mesher->getFdm1dMeshers();
+        QL_REQUIRE(x.size() == meshers.size(),
+                   "inconsistent number of dimensions");
+
+        // one-dimensional weights, split between the two neighbours
+        // of the given point and normalized to a unit integral
+        std::vector<std::vector<Real> > weights(meshers.size());
+        for (Size d=0; d < meshers.size(); ++d) {
+            const std::vector<Real>& loc = meshers[d]->locations();
+            const Size n = loc.size();
+            QL_REQUIRE(n > 3 && loc[1] <= x[d] && loc[n-2] >= x[d],
+                       "point " << x[d] << " not inside the mesher "
+                       "in direction " << d);
+
+            weights[d].resize(n, 0.0);
+
+            const Size upper = std::upper_bound(loc.begin(), loc.end()-1,
+                                                x[d]) - loc.begin();
+            const Size lower = upper-1;
+
+            if (close_enough(loc[lower], x[d])) {
+                weights[d][lower] = 2.0/(loc[lower+1] - loc[lower-1]);
+            }
+            else if (close_enough(loc[upper], x[d])) {
+                weights[d][upper] = 2.0/(loc[upper+1] - loc[upper-1]);
+            }
+            else {
+                const Real dx = loc[upper] - loc[lower];
+                weights[d][lower] = (loc[upper] - x[d])/dx
+                                    * 2.0/(loc[lower+1] - loc[lower-1]);
+                weights[d][upper] = (x[d] - loc[lower])/dx
+                                    * 2.0/(loc[upper+1] - loc[upper-1]);
+            }
+        }
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+
+        Array p(layout->size());
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            Real w = 1.0;
+            for (Size d=0; d < meshers.size(); ++d)
+                w *= weights[d][iter.coordinates()[d]];
+            p[iter.index()] = w;
+        }
+
+        return p;
+    }
+
+
+    FdmBlackScholesFwdSurfaceSolver::FdmBlackScholesFwdSurfaceSolver(
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const std::vector<Time>& maturities,
+        Size xGrid, Size tGrid, Size dampingSteps,
+        bool localVol, Real illegalLocalVolOverwrite,
+        const FdmSchemeDesc& schemeDesc)
+    : rTS_(process->riskFreeRate().currentLink()) {
+
+        QL_REQUIRE(!maturities.empty(), "no maturities given");
+        const Real s0 = process->x0();
+
+        const boost::shared_ptr<FdmMesherComposite> mesher(
+            new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(
+                    xGrid, process, maturities.back(), s0,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(s0, 0.1)))));
+
+        const boost::shared_ptr<FdmLinearOpComposite> fwdOp(
+            new FdmBlackScholesFwdOp(mesher, process, s0, 0,
+                                     localVol, illegalLocalVolOverwrite));
+
+        solver_ = boost::shared_ptr<FdmFwdSurfaceSolver>(
+            new FdmFwdSurfaceSolver(
+                mesher, fwdOp,
+                FdmFwdSurfaceSolver::diracDelta(
+                    mesher, std::vector<Real>(1, std::log(s0))),
+                maturities, tGrid, dampingSteps, schemeDesc));
+    }
+
+    Real FdmBlackScholesFwdSurfaceSolver::npv(Size i, Real strike,
+                                              Option::Type type) const {
+        return rTS_->discount(solver_->maturities().at(i))
+            * solver_->expectation(i, PlainVanillaPayoff(type, strike));
+    }
+
+    Disposable<Matrix> FdmBlackScholesFwdSurfaceSolver::npvs(
+        const std::vector<Real>& strikes, Option::Type type) const {
+        return npvMatrix(*solver_, *rTS_, strikes, type);
+    }
+
+
+    FdmHestonFwdSurfaceSolver::FdmHestonFwdSurfaceSolver(
+        const boost::shared_ptr<HestonProcess>& process,
+        const std::vector<Time>& maturities,
+        Size xGrid, Size vGrid, Size tGrid, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc)
+    : rTS_(process->riskFreeRate().currentLink()) {
+
+        QL_REQUIRE(!maturities.empty(), "no maturities given");
+        const Time maturity = maturities.back();
+
+        const Real s0    = process->s0()->value();
+        const Real v0    = process->v0();
+        const Real kappa = process->kappa();
+        const Real theta = process->theta();
+        const Real sigma = process->sigma();
+
+        // mean and variance of the variance at the last maturity
+        const Real e = std::exp(-kappa*maturity);
+        const Real vMean = theta + (v0 - theta)*e;
+        const Real vVar = v0*sigma*sigma*e*(1.0 - e)/kappa
+                        + theta*sigma*sigma*(1.0 - e)*(1.0 - e)/(2.0*kappa);
+        const Real vMax = std::max(v0, vMean) + 6.0*std::sqrt(vVar);
+        const Real vMin = std::min(0.0001, 0.01*v0);
+
+        const boost::shared_ptr<Fdm1dMesher> varianceMesher(
+            new Concentrating1dMesher(vMin, vMax, vGrid,
+                                      std::pair<Real, Real>(vMin, 0.1)));
+
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMesher(
+                xGrid,
+                FdmBlackScholesMesher::processHelper(
+                    process->s0(), process->riskFreeRate(),
+                    process->dividendYield(),
+                    1.4*std::sqrt(std::max(v0, theta))),
+                maturity, s0, Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(s0, 0.1)));
+
+        const boost::shared_ptr<FdmMesherComposite> mesher(
+            new FdmMesherComposite(equityMesher, varianceMesher));
+
+        const boost::shared_ptr<FdmLinearOpComposite> fwdOp(
+            new FdmHestonFwdOp(mesher, process,
+                               FdmSquareRootFwdOp::Power));
+
+        std::vector<Real> x0(2);
+        x0[0] = std::log(s0);
+        x0[1] = v0;
+
+        solver_ = boost::shared_ptr<FdmFwdSurfaceSolver>(
+            new FdmFwdSurfaceSolver(
+                mesher, fwdOp, FdmFwdSurfaceSolver::diracDelta(mesher, x0),
+                maturities, tGrid, dampingSteps, schemeDesc));
+    }
+
+    Real FdmHestonFwdSurfaceSolver::npv(Size i, Real strike,
+                                        Option::Type type) const {
+        return rTS_->discount(solver_->maturities().at(i))
+            * solver_->expectation(i, PlainVanillaPayoff(type, strike));
+    }
+
+    Disposable<Matrix> FdmHestonFwdSurfaceSolver::npvs(
+        const std::vector<Real>& strikes, Option::Type type) const {
+        return npvMatrix(*solver_, *rTS_, strikes, type);
+    }
+}
@@ -0,0 +1,155 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmfwdsurfacesolver.hpp
+    \brief Fokker-Planck forward solvers for surfaces of European options
+*/
+
+#ifndef quantlib_fdm_fwd_surface_solver_hpp
+#define quantlib_fdm_fwd_surface_solver_hpp
+
+#include <ql/option.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class Payoff;
+    class HestonProcess;
+    class YieldTermStructure;
+    class FdmMesherComposite;
+    class FdmLinearOpComposite;
+    class GeneralizedBlackScholesProcess;
+
+    //! Fokker-Planck forward solver
+    /*! The transition density is evolved forward in time with the
+        given forward operator, starting from the given density at
+        time zero, and stored at each of the given maturities.  The
+        expectation of any payoff at any of the maturities can then be
+        calculated by integrating it against the stored density,
+        hence a whole surface of European options is priced with a
+        single solve.
+
+        The time steps are distributed among the maturities according
+        to their distance; the first damping steps use the implicit
+        Euler scheme in order to smooth the initial density.  The
+        first direction of the mesher must be the log of the
+        underlying.
+    */
+    class FdmFwdSurfaceSolver : public LazyObject {
+      public:
+        FdmFwdSurfaceSolver(
+            const boost::shared_ptr<FdmMesherComposite>& mesher,
+            const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+            const Array& p0,
+            const std::vector<Time>& maturities,
+            Size timeSteps,
+            Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas());
+
+        const std::vector<Time>& maturities() const;
+        //! density at the i-th maturity
+        const Array& density(Size i) const;
+        //! undiscounted expectation of the payoff at the i-th maturity
+        Real expectation(Size i, const Payoff& payoff) const;
+
+        //! discrete Dirac delta at the given point of the mesh
+        static Disposable<Array> diracDelta(
+                          const boost::shared_ptr<FdmMesherComposite>& mesher,
+                          const std::vector<Real>& x);
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        const boost::shared_ptr<FdmMesherComposite> mesher_;
+        const boost::shared_ptr<FdmLinearOpComposite> fwdOp_;
+        const Array p0_;
+        const std::vector<Time> maturities_;
+        const Size timeSteps_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+
+        mutable std::vector<Array> densities_;
+    };
+
+
+    //! Black-Scholes surface of European options priced with one solve
+    /*! The initial density is a Dirac delta at the spot.  Unless
+        local volatility is used, the Black volatility at the spot
+        is used for the whole surface.
+
+        \warning the solver takes a snapshot of the process at
+                 construction and does not observe it.
+    */
+    class FdmBlackScholesFwdSurfaceSolver {
+      public:
+        FdmBlackScholesFwdSurfaceSolver(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const std::vector<Time>& maturities,
+            Size xGrid = 401, Size tGrid = 200, Size dampingSteps = 2,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas());
+
+        //! discounted value of the option at the i-th maturity
+        Real npv(Size i, Real strike, Option::Type type) const;
+        //! option values with strikes along rows and maturities along columns
+        Disposable<Matrix> npvs(const std::vector<Real>& strikes,
+                                Option::Type type) const;
+
+        const FdmFwdSurfaceSolver& solver() const { return *solver_; }
+
+      private:
+        const boost::shared_ptr<YieldTermStructure> rTS_;
+        boost::shared_ptr<FdmFwdSurfaceSolver> solver_;
+    };
+
+
+    //! Heston surface of European options priced with one solve
+    /*! The initial density is a Dirac delta at the spot and at the
+        initial variance.  The variance direction uses the power
+        transformation of the square-root forward operator, which
+        keeps the solution stable close to zero variance.
+
+        \warning the solver takes a snapshot of the process at
+                 construction and does not observe it.
+    */
+    class FdmHestonFwdSurfaceSolver {
+      public:
+        FdmHestonFwdSurfaceSolver(
+            const boost::shared_ptr<HestonProcess>& process,
+            const std::vector<Time>& maturities,
+            Size xGrid = 201, Size vGrid = 101, Size tGrid = 100,
+            Size dampingSteps = 10,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+
+        //! discounted value of the option at the i-th maturity
+        Real npv(Size i, Real strike, Option::Type type) const;
+        //! option values with strikes along rows and maturities along columns
+        Disposable<Matrix> npvs(const std::vector<Real>& strikes,
+                                Option::Type type) const;
+
+        const FdmFwdSurfaceSolver& solver() const { return *solver_; }
+
+      private:
+        const boost::shared_ptr<YieldTermStructure> rTS_;
+        boost::shared_ptr<FdmFwdSurfaceSolver> solver_;
+    };
+}
+
+#endif
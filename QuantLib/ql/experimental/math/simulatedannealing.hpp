@@ -69,6 +69,11 @@ namespace QuantLib {
 
         EndCriteria::Type minimize(Problem &P, const EndCriteria &ec);
 
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(
+                                              new SimulatedAnnealing(*this));
+        }
+
       private:
 
         const Scheme scheme_;
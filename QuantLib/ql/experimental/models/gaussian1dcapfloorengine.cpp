@@ -38,6 +38,8 @@ namespace QuantLib {
         CapFloor::Type type = arguments_.type;
 
         Array z = model_->yGrid(stddevs_, integrationPoints_);
+        const Matrix &w = model_->gaussianPolynomialIntegralWeights(
+            stddevs_, integrationPoints_);
         Array p(z.size());
 
         for (Size i = 0; i < optionlets; ++i) {
@@ -100,31 +102,26 @@ namespace QuantLib {
                         Real price = 0.0;
                         for (Size j = 0; j < z.size() - 1; j++) {
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, payoff.cCoefficients()[j],
+                                payoff.cCoefficients()[j],
                                 payoff.bCoefficients()[j],
-                                payoff.aCoefficients()[j], p[j], z[j], z[j],
-                                z[j + 1]);
+                                payoff.aCoefficients()[j], p[j], w, j);
                         }
                         if (extrapolatePayoff_) {
                             if (flatPayoffExtrapolation_) {
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                        z[z.size() - 2], z[z.size() - 1],
-                                        100.0);
+                                        0.0, 0.0, 0.0, p[z.size() - 2], w,
+                                        z.size() - 1);
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                        z[0]);
+                                        0.0, 0.0, 0.0, p[0], w, z.size());
                             } else {
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
                                         payoff.cCoefficients()[z.size() - 2],
                                         payoff.bCoefficients()[z.size() - 2],
                                         payoff.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0);
+                                        p[z.size() - 2], w, z.size() - 1);
                             }
                         }
                         values[i] =
@@ -172,29 +169,26 @@ namespace QuantLib {
                         Real price = 0.0;
                         for (Size j = 0; j < z.size() - 1; j++) {
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, payoff.cCoefficients()[j],
+                                payoff.cCoefficients()[j],
                                 payoff.bCoefficients()[j],
-                                payoff.aCoefficients()[j], p[j], z[j], z[j],
-                                z[j + 1]);
+                                payoff.aCoefficients()[j], p[j], w, j);
                         }
                         if (extrapolatePayoff_) {
                             if (flatPayoffExtrapolation_) {
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                        z[z.size() - 2], z[z.size() - 1],
-                                        100.0);
+                                        0.0, 0.0, 0.0, p[z.size() - 2], w,
+                                        z.size() - 1);
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                        z[0]);
+                                        0.0, 0.0, 0.0, p[0], w, z.size());
                             } else {
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff.cCoefficients()[0],
+                                        payoff.cCoefficients()[0],
                                         payoff.bCoefficients()[0],
-                                        payoff.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]);
+                                        payoff.aCoefficients()[0], p[0], w,
+                                        z.size());
                             }
                         }
                         floorlet = price *
@@ -136,6 +136,8 @@ namespace QuantLib {
             npv1a(2 * integrationPoints_ + 1, 0.0); // arrays for npvs of the
                                                     // underlying
         Array z = model_->yGrid(stddevs_, integrationPoints_);
+        const Matrix &w = model_->gaussianPolynomialIntegralWeights(
+            stddevs_, integrationPoints_);
         Array p(z.size(), 0.0), pa(z.size(), 0.0);
 
         Date event1 = Null<Date>(), event0;
@@ -238,74 +240,66 @@ namespace QuantLib {
                         CubicInterpolation::Lagrange, 0.0);
                     for (Size i = 0; i < z.size() - 1; i++) {
                         price += model_->gaussianShiftedPolynomialIntegral(
-                                     0.0, payoff1.cCoefficients()[i],
-                                     payoff1.bCoefficients()[i],
-                                     payoff1.aCoefficients()[i], p[i], z[i],
-                                     z[i], z[i + 1]) *
+                            payoff1.cCoefficients()[i],
+                            payoff1.bCoefficients()[i],
+                            payoff1.aCoefficients()[i], p[i], w, i) *
                                  zSpreadDf;
                         pricea += model_->gaussianShiftedPolynomialIntegral(
-                                      0.0, payoff1a.cCoefficients()[i],
-                                      payoff1a.bCoefficients()[i],
-                                      payoff1a.aCoefficients()[i], pa[i], z[i],
-                                      z[i], z[i + 1]) *
+                            payoff1a.cCoefficients()[i],
+                            payoff1a.bCoefficients()[i],
+                            payoff1a.aCoefficients()[i], pa[i], w, i) *
                                   zSpreadDf;
                     }
                     if (extrapolatePayoff_) {
                         if (flatPayoffExtrapolation_) {
                             price +=
                                 model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
+                                    0.0, 0.0, 0.0, p[z.size() - 2], w,
+                                    z.size() - 1) *
                                 zSpreadDf;
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                         0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                         z[0]) *
+                                0.0, 0.0, 0.0, p[0], w, z.size()) *
                                      zSpreadDf;
                             pricea +=
                                 model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, pa[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
+                                    0.0, 0.0, 0.0, pa[z.size() - 2], w,
+                                    z.size() - 1) *
                                 zSpreadDf;
                             pricea += model_->gaussianShiftedPolynomialIntegral(
-                                          0.0, 0.0, 0.0, 0.0, pa[0], z[0],
-                                          -100.0, z[0]) *
+                                0.0, 0.0, 0.0, pa[0], w, z.size()) *
                                       zSpreadDf;
                         } else {
                             if (type == Option::Call)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
                                         payoff1.cCoefficients()[z.size() - 2],
                                         payoff1.bCoefficients()[z.size() - 2],
                                         payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
+                                        p[z.size() - 2], w, z.size() - 1) *
                                     zSpreadDf;
                             if (type == Option::Put)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
+                                        payoff1.cCoefficients()[0],
                                         payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]) *
+                                        payoff1.aCoefficients()[0], p[0], w,
+                                        z.size()) *
                                     zSpreadDf;
                             if (type == Option::Call)
                                 pricea +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
                                         payoff1a.cCoefficients()[z.size() - 2],
                                         payoff1a.bCoefficients()[z.size() - 2],
                                         payoff1a.aCoefficients()[z.size() - 2],
-                                        pa[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
+                                        pa[z.size() - 2], w, z.size() - 1) *
                                     zSpreadDf;
                             if (type == Option::Put)
                                 pricea +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1a.cCoefficients()[0],
+                                        payoff1a.cCoefficients()[0],
                                         payoff1a.bCoefficients()[0],
-                                        payoff1a.aCoefficients()[0], pa[0],
-                                        z[0], -100.0, z[0]) *
+                                        payoff1a.aCoefficients()[0], pa[0], w,
+                                        z.size()) *
                                     zSpreadDf;
                         }
                     }
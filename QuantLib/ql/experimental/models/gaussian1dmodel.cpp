@@ -27,28 +27,63 @@ namespace QuantLib {
                                  const Real y,
                                  boost::shared_ptr<IborIndex> iborIdx) const {
 
-        QL_REQUIRE(iborIdx != NULL, "no ibor index given");
+        Date valueDate, endDate;
+        Real dcf;
+        if (isFixed(fixing, iborIdx, valueDate, endDate, dcf))
+            return iborIdx->fixing(fixing);
 
-        calculate();
+        Handle<YieldTermStructure> yts =
+            iborIdx->forwardingTermStructure(); // might be empty, then use
+                                                // model curve
 
-        if (fixing <=
-            (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1)))
-            return iborIdx->fixing(fixing);
+        return (zerobond(valueDate, referenceDate, y, yts) -
+                zerobond(endDate, referenceDate, y, yts)) /
+               (dcf * zerobond(endDate, referenceDate, y, yts));
+    }
+
+    const Disposable<Array>
+    Gaussian1dModel::forwardRate(const Date &fixing, const Date &referenceDate,
+                                 const Array &y,
+                                 boost::shared_ptr<IborIndex> iborIdx) const {
+
+        Date valueDate, endDate;
+        Real dcf;
+        if (isFixed(fixing, iborIdx, valueDate, endDate, dcf)) {
+            Array result(y.size(), iborIdx->fixing(fixing));
+            return result;
+        }
 
         Handle<YieldTermStructure> yts =
             iborIdx->forwardingTermStructure(); // might be empty, then use
                                                 // model curve
 
-        Date valueDate = iborIdx->valueDate(fixing);
-        Date endDate = iborIdx->fixingCalendar().advance(
+        Array end = zerobond(endDate, referenceDate, y, yts);
+        Array result = zerobond(valueDate, referenceDate, y, yts);
+        for (Size i = 0; i < y.size(); i++)
+            result[i] = (result[i] - end[i]) / (dcf * end[i]);
+        return result;
+    }
+
+    bool Gaussian1dModel::isFixed(const Date &fixing,
+                                  const boost::shared_ptr<IborIndex> &iborIdx,
+                                  Date &valueDate, Date &endDate,
+                                  Real &dcf) const {
+
+        QL_REQUIRE(iborIdx != NULL, "no ibor index given");
+
+        calculate();
+
+        if (fixing <=
+            (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1)))
+            return true;
+
+        valueDate = iborIdx->valueDate(fixing);
+        endDate = iborIdx->fixingCalendar().advance(
             valueDate, iborIdx->tenor(), iborIdx->businessDayConvention(),
             iborIdx->endOfMonth());
         // FIXME Here we should use the calculation date calendar ?
-        Real dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
-
-        return (zerobond(valueDate, referenceDate, y, yts) -
-                zerobond(endDate, referenceDate, y, yts)) /
-               (dcf * zerobond(endDate, referenceDate, y, yts));
+        dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
+        return false;
     }
 
     const Real
@@ -158,16 +193,20 @@ namespace QuantLib {
 
         Array yg = yGrid(yStdDevs, yGridPoints, fixingTime, referenceTime, y);
         Array z = yGrid(yStdDevs, yGridPoints);
+        const Matrix &w = gaussianPolynomialIntegralWeights(yStdDevs,
+                                                            yGridPoints);
+        const Size n = z.size();
 
+        Array expValDsc = zerobond(valueDate, expiry, yg, yts);
+        Array discount = zerobond(maturity, expiry, yg, yts) / expValDsc;
+        Array nmr = numeraire(fixingTime, yg, yts);
         Array p(yg.size());
 
         for (Size i = 0; i < yg.size(); i++) {
-            Real expValDsc = zerobond(valueDate, expiry, yg[i], yts);
-            Real discount = zerobond(maturity, expiry, yg[i], yts) / expValDsc;
             p[i] = std::max((type == Option::Call ? 1.0 : -1.0) *
-                                (discount - strike),
+                                (discount[i] - strike),
                             0.0) /
-                   numeraire(fixingTime, yg[i], yts) * expValDsc;
+                   nmr[i] * expValDsc[i];
         }
 
         CubicInterpolation payoff(z.begin(), z.end(), p.begin(),
@@ -176,30 +215,27 @@ namespace QuantLib {
                                   CubicInterpolation::Lagrange, 0.0);
 
         Real price = 0.0;
-        for (Size i = 0; i < z.size() - 1; i++) {
+        for (Size i = 0; i < n - 1; i++) {
             price += gaussianShiftedPolynomialIntegral(
-                0.0, payoff.cCoefficients()[i], payoff.bCoefficients()[i],
-                payoff.aCoefficients()[i], p[i], z[i], z[i], z[i + 1]);
+                payoff.cCoefficients()[i], payoff.bCoefficients()[i],
+                payoff.aCoefficients()[i], p[i], w, i);
         }
         if (extrapolatePayoff) {
             if (flatPayoffExtrapolation) {
                 price += gaussianShiftedPolynomialIntegral(
-                    0.0, 0.0, 0.0, 0.0, p[z.size() - 2], z[z.size() - 2],
-                    z[z.size() - 1], 100.0);
+                    0.0, 0.0, 0.0, p[n - 2], w, n - 1);
                 price += gaussianShiftedPolynomialIntegral(
-                    0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0, z[0]);
+                    0.0, 0.0, 0.0, p[0], w, n);
             } else {
                 if (type == Option::Call)
                     price += gaussianShiftedPolynomialIntegral(
-                        0.0, payoff.cCoefficients()[z.size() - 2],
-                        payoff.bCoefficients()[z.size() - 2],
-                        payoff.aCoefficients()[z.size() - 2], p[z.size() - 2],
-                        z[z.size() - 2], z[z.size() - 1], 100.0);
+                        payoff.cCoefficients()[n - 2],
+                        payoff.bCoefficients()[n - 2],
+                        payoff.aCoefficients()[n - 2], p[n - 2], w, n - 1);
                 if (type == Option::Put)
                     price += gaussianShiftedPolynomialIntegral(
-                        0.0, payoff.cCoefficients()[0],
-                        payoff.bCoefficients()[0], payoff.aCoefficients()[0],
-                        p[0], z[0], -100.0, z[0]);
+                        payoff.cCoefficients()[0], payoff.bCoefficients()[0],
+                        payoff.aCoefficients()[0], p[0], w, n);
             }
         }
 
@@ -249,6 +285,64 @@ namespace QuantLib {
             a * h * h * h * h - b * h * h * h + c * h * h - d * h + e, x0, x1);
     }
 
+    const Matrix &
+    Gaussian1dModel::gaussianPolynomialIntegralWeights(const Real yStdDevs,
+                                                       const int gridPoints)
+        const {
+
+        // the number of standard deviations is usually the same for
+        // all calls, hence it is looked up among the few grids with
+        // the given number of points rather than used as a key
+        std::list<std::pair<Real, Matrix> > &cached =
+            integralWeights_[gridPoints];
+        for (std::list<std::pair<Real, Matrix> >::const_iterator i =
+                 cached.begin();
+             i != cached.end(); ++i) {
+            if (i->first == yStdDevs)
+                return i->second;
+        }
+
+        Array z = yGrid(yStdDevs, gridPoints);
+        const Size n = z.size();
+        Matrix w(n + 1, 4);
+        for (Size j = 0; j <= n; j++) {
+            // the intervals of the grid, then the two extrapolations
+            Real h = j < n - 1 ? z[j] : (j == n - 1 ? z[n - 2] : z[0]);
+            Real x0 = j < n - 1 ? z[j] : (j == n - 1 ? z[n - 1] : -100.0);
+            Real x1 = j < n - 1 ? z[j + 1] : (j == n - 1 ? 100.0 : z[0]);
+            for (Size k = 0; k < 4; k++) {
+                w[j][k] = gaussianShiftedPolynomialIntegral(
+                    0.0, k == 3 ? 1.0 : 0.0, k == 2 ? 1.0 : 0.0,
+                    k == 1 ? 1.0 : 0.0, k == 0 ? 1.0 : 0.0, h, x0, x1);
+            }
+        }
+
+        cached.push_back(std::make_pair(yStdDevs, w));
+        return cached.back().second;
+    }
+
+    const Disposable<Array>
+    Gaussian1dModel::numeraireImpl(const Time t, const Array &y,
+                                   const Handle<YieldTermStructure> &yts)
+        const {
+
+        Array result(y.size());
+        for (Size i = 0; i < y.size(); i++)
+            result[i] = numeraireImpl(t, y[i], yts);
+        return result;
+    }
+
+    const Disposable<Array>
+    Gaussian1dModel::zerobondImpl(const Time T, const Time t, const Array &y,
+                                  const Handle<YieldTermStructure> &yts)
+        const {
+
+        Array result(y.size());
+        for (Size i = 0; i < y.size(); i++)
+            result[i] = zerobondImpl(T, t, y[i], yts);
+        return result;
+    }
+
     const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
                                                    const int gridPoints,
                                                    const Real T, const Real t,
@@ -30,6 +30,7 @@
 #include <ql/models/model.hpp>
 #include <ql/models/parameter.hpp>
 #include <ql/math/interpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/indexes/swapindex.hpp>
@@ -51,6 +52,8 @@
 #endif
 #include <boost/math/special_functions/erf.hpp>
 #include <boost/unordered_map.hpp>
+#include <list>
+#include <map>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
@@ -98,6 +101,31 @@ namespace QuantLib {
                             const Handle<YieldTermStructure> &yts =
                                 Handle<YieldTermStructure>()) const;
 
+        /*! Vectorized versions of the above for a whole grid of
+            values of the state variable; the parts that do not depend
+            on the state are computed only once for all points */
+
+        const Disposable<Array>
+        numeraire(const Time t, const Array &y,
+                  const Handle<YieldTermStructure> &yts =
+                      Handle<YieldTermStructure>()) const;
+
+        const Disposable<Array>
+        zerobond(const Time T, const Time t, const Array &y,
+                 const Handle<YieldTermStructure> &yts =
+                     Handle<YieldTermStructure>()) const;
+
+        const Disposable<Array>
+        numeraire(const Date &referenceDate, const Array &y,
+                  const Handle<YieldTermStructure> &yts =
+                      Handle<YieldTermStructure>()) const;
+
+        const Disposable<Array>
+        zerobond(const Date &maturity, const Date &referenceDate,
+                 const Array &y,
+                 const Handle<YieldTermStructure> &yts =
+                     Handle<YieldTermStructure>()) const;
+
         const Real zerobondOption(
             const Option::Type &type, const Date &expiry, const Date &valueDate,
             const Date &maturity, const Rate strike,
@@ -114,6 +142,12 @@ namespace QuantLib {
                                boost::shared_ptr<IborIndex> iborIdx =
                                    boost::shared_ptr<IborIndex>()) const;
 
+        const Disposable<Array>
+        forwardRate(const Date &fixing, const Date &referenceDate,
+                    const Array &y,
+                    boost::shared_ptr<IborIndex> iborIdx =
+                        boost::shared_ptr<IborIndex>()) const;
+
         const Real swapRate(const Date &fixing, const Period &tenor,
                             const Date &referenceDate = Null<Date>(),
                             const Real y = 0.0,
@@ -146,6 +180,37 @@ namespace QuantLib {
             const Real a, const Real b, const Real c, const Real d,
             const Real e, const Real h, const Real x0, const Real x1);
 
+        /*! Returns the integrals of the shifted monomials
+        \f[ (x-h)^k, k=0,\dots,3 \f]
+        against the standard normal density for the grid
+        $z$ = yGrid(yStdDevs, gridPoints) of $n$ points as a
+        $(n+1) \times 4$ matrix. Row $i<n-1$ refers to the interval
+        $[z_i,z_{i+1}]$ with $h=z_i$, row $n-1$ to $[z_{n-1},100]$
+        with $h=z_{n-2}$ and row $n$ to $[-100,z_0]$ with $h=z_0$,
+        i.e. to the extrapolation of the outermost pieces of a spline
+        on the grid. The weights only depend on the grid and are
+        computed once and then reused by all instruments.
+
+        \warning the weights are cached in the model without any
+                 synchronization, hence this method (as well as the
+                 pricing methods calling it) must not be used
+                 concurrently from several threads.
+        */
+        const Matrix &gaussianPolynomialIntegralWeights(const Real yStdDevs,
+                                                        const int gridPoints)
+            const;
+
+        /*! Computes the integral
+        \f[ {2\pi}^{-0.5} \int p(x) \exp{-0.5*x*x} \mathrm{d}x \f]
+        with
+        \f[ p(x) = b(x-h)^3+c(x-h)^2+d(x-h)+e \f]
+        where the integration bounds and the shift $h$ are given by
+        row i of the weights returned by gaussianPolynomialIntegralWeights.
+        */
+        const static Real gaussianShiftedPolynomialIntegral(
+            const Real b, const Real c, const Real d, const Real e,
+            const Matrix &weights, const Size i);
+
         /*! Generates a grid of values for the standardized state variable $y$
            at time $T$
             conditional on $y(t)=y$, covering yStdDevs standard deviations
@@ -191,6 +256,18 @@ namespace QuantLib {
 
         mutable CacheType swapCache_;
 
+        // keyed on the number of grid points, see
+        // gaussianPolynomialIntegralWeights(); lists keep the returned
+        // references valid when further grids are added
+        mutable std::map<int, std::list<std::pair<Real, Matrix> > >
+            integralWeights_;
+
+        // returns true if the fixing is known, otherwise the value
+        // date, end date and accrual fraction of the index period
+        bool isFixed(const Date &fixing,
+                     const boost::shared_ptr<IborIndex> &iborIdx,
+                     Date &valueDate, Date &endDate, Real &dcf) const;
+
       protected:
         // we let derived classes register with the termstructure
         Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -208,6 +285,17 @@ namespace QuantLib {
         zerobondImpl(const Time T, const Time t, const Real y,
                      const Handle<YieldTermStructure> &yts) const = 0;
 
+        // the default implementations of the vectorized methods loop
+        // over the scalar ones, models should override them to share
+        // the computations that do not depend on the state
+        virtual const Disposable<Array>
+        numeraireImpl(const Time t, const Array &y,
+                      const Handle<YieldTermStructure> &yts) const;
+
+        virtual const Disposable<Array>
+        zerobondImpl(const Time T, const Time t, const Array &y,
+                     const Handle<YieldTermStructure> &yts) const;
+
         void performCalculations() const {
             evaluationDate_ = Settings::instance().evaluationDate();
             enforcesTodaysHistoricFixings_ = Settings::instance().enforcesTodaysHistoricFixings();
@@ -282,6 +370,46 @@ namespace QuantLib {
                         y, yts);
     }
 
+    inline const Disposable<Array>
+    Gaussian1dModel::numeraire(const Time t, const Array &y,
+                               const Handle<YieldTermStructure> &yts) const {
+
+        return numeraireImpl(t, y, yts);
+    }
+
+    inline const Disposable<Array>
+    Gaussian1dModel::zerobond(const Time T, const Time t, const Array &y,
+                              const Handle<YieldTermStructure> &yts) const {
+        return zerobondImpl(T, t, y, yts);
+    }
+
+    inline const Disposable<Array>
+    Gaussian1dModel::numeraire(const Date &referenceDate, const Array &y,
+                               const Handle<YieldTermStructure> &yts) const {
+
+        return numeraire(termStructure()->timeFromReference(referenceDate), y,
+                         yts);
+    }
+
+    inline const Disposable<Array>
+    Gaussian1dModel::zerobond(const Date &maturity, const Date &referenceDate,
+                              const Array &y,
+                              const Handle<YieldTermStructure> &yts) const {
+
+        return zerobond(termStructure()->timeFromReference(maturity),
+                        referenceDate != Null<Date>()
+                            ? termStructure()->timeFromReference(referenceDate)
+                            : 0.0,
+                        y, yts);
+    }
+
+    inline const Real Gaussian1dModel::gaussianShiftedPolynomialIntegral(
+        const Real b, const Real c, const Real d, const Real e,
+        const Matrix &weights, const Size i) {
+        return e * weights[i][0] + d * weights[i][1] + c * weights[i][2] +
+               b * weights[i][3];
+    }
+
 }
 
 #endif
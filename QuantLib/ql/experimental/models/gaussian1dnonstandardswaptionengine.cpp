@@ -160,6 +160,9 @@ namespace QuantLib {
         Array npv0(2 * integrationPoints_ + 1, 0.0),
             npv1(2 * integrationPoints_ + 1, 0.0);
         Array z = model_->yGrid(stddevs_, integrationPoints_);
+        const Matrix &w = model_->gaussianPolynomialIntegralWeights(
+            stddevs_, integrationPoints_);
+        const Size n = z.size();
         Array p(z.size(), 0.0);
 
         Date expiry1 = Null<Date>(), expiry0;
@@ -183,6 +186,82 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
+            // the exercise values are computed on the whole grid at once
+            // with the vectorized model methods
+
+            Array exerciseValue;
+            if (expiry0 > settlement) {
+                Array floatingLegNpv(z.size(), 0.0);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(
+                                                 expiry0,
+                                                 arguments_.floatingPayDates
+                                                     [l])));
+                    Array amount;
+                    if (arguments_.floatingIsRedemptionFlow[l])
+                        amount = Array(z.size(), arguments_.floatingCoupons[l]);
+                    else
+                        amount = arguments_.floatingNominal[l] *
+                                 arguments_.floatingAccrualTimes[l] *
+                                 (arguments_.floatingGearings[l] *
+                                      model_->forwardRate(
+                                          arguments_.floatingFixingDates[l],
+                                          expiry0, z,
+                                          arguments_.swap->iborIndex()) +
+                                  arguments_.floatingSpreads[l]);
+                    floatingLegNpv +=
+                        amount *
+                        model_->zerobond(arguments_.floatingPayDates[l],
+                                         expiry0, z, discountCurve_) *
+                        zSpreadDf;
+                }
+                Array fixedLegNpv(z.size(), 0.0);
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(
+                                                 expiry0,
+                                                 arguments_.fixedPayDates[l])));
+                    fixedLegNpv +=
+                        arguments_.fixedCoupons[l] *
+                        model_->zerobond(arguments_.fixedPayDates[l], expiry0,
+                                         z, discountCurve_) *
+                        zSpreadDf;
+                }
+                Real rebate = 0.0;
+                Real zSpreadDf = 1.0;
+                Date rebateDate = expiry0;
+                if (rebatedExercise != NULL) {
+                    rebate = rebatedExercise->rebate(idx);
+                    rebateDate = rebatedExercise->rebatePaymentDate(idx);
+                    zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(expiry0,
+                                                          rebateDate)));
+                }
+                exerciseValue =
+                    ((type == Option::Call ? 1.0 : -1.0) *
+                         (floatingLegNpv - fixedLegNpv) +
+                     rebate * model_->zerobond(rebateDate, expiry0, z,
+                                               discountCurve_) *
+                         zSpreadDf) /
+                    model_->numeraire(expiry0Time, z, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -210,43 +289,37 @@ namespace QuantLib {
                         CubicInterpolation::Spline, true,
                         CubicInterpolation::Lagrange, 0.0,
                         CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < z.size() - 1; i++) {
+                    for (Size i = 0; i < n - 1; i++) {
                         price += model_->gaussianShiftedPolynomialIntegral(
-                                     0.0, payoff1.cCoefficients()[i],
+                                     payoff1.cCoefficients()[i],
                                      payoff1.bCoefficients()[i],
-                                     payoff1.aCoefficients()[i], p[i], z[i],
-                                     z[i], z[i + 1]) *
+                                     payoff1.aCoefficients()[i], p[i], w, i) *
                                  zSpreadDf;
                     }
                     if (extrapolatePayoff_) {
                         if (flatPayoffExtrapolation_) {
-                            price +=
-                                model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
-                                zSpreadDf;
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                         0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                         z[0]) *
+                                         0.0, 0.0, 0.0, p[n - 2], w, n - 1) *
+                                     zSpreadDf;
+                            price += model_->gaussianShiftedPolynomialIntegral(
+                                         0.0, 0.0, 0.0, p[0], w, n) *
                                      zSpreadDf;
                         } else {
                             if (type == Option::Call)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1.cCoefficients()[z.size() - 2],
-                                        payoff1.bCoefficients()[z.size() - 2],
-                                        payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
+                                        payoff1.cCoefficients()[n - 2],
+                                        payoff1.bCoefficients()[n - 2],
+                                        payoff1.aCoefficients()[n - 2],
+                                        p[n - 2], w, n - 1) *
                                     zSpreadDf;
                             if (type == Option::Put)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
+                                        payoff1.cCoefficients()[0],
                                         payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]) *
+                                        payoff1.aCoefficients()[0], p[0], w,
+                                        n) *
                                     zSpreadDf;
                         }
                     }
@@ -254,81 +327,8 @@ namespace QuantLib {
 
                 npv0[k] = price;
 
-                if (expiry0 > settlement) {
-                    Real floatingLegNpv = 0.0;
-                    for (Size l = k1; l < arguments_.floatingCoupons.size();
-                         l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(-oas_->value() *
-                                           (model_->termStructure()
-                                                ->dayCounter()
-                                                .yearFraction(
-                                                     expiry0,
-                                                     arguments_.floatingPayDates
-                                                         [l])));
-                        Real amount;
-                        if (arguments_.floatingIsRedemptionFlow[l])
-                            amount = arguments_.floatingCoupons[l];
-                        else
-                            amount = arguments_.floatingNominal[l] *
-                                     arguments_.floatingAccrualTimes[l] *
-                                     (arguments_.floatingGearings[l] *
-                                          model_->forwardRate(
-                                              arguments_.floatingFixingDates[l],
-                                              expiry0, z[k],
-                                              arguments_.swap->iborIndex()) +
-                                      arguments_.floatingSpreads[l]);
-                        floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real fixedLegNpv = 0.0;
-                    for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_.fixedPayDates[l])));
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real rebate = 0.0;
-                    Real zSpreadDf = 1.0;
-                    Date rebateDate = expiry0;
-                    if (rebatedExercise != NULL) {
-                        rebate = rebatedExercise->rebate(idx);
-                        rebateDate = rebatedExercise->rebatePaymentDate(idx);
-                        zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(expiry0, rebateDate)));
-                    }
-                    npv0[k] = std::max(
-                        npv0[k],
-                        ((type == Option::Call ? 1.0 : -1.0) *
-                             (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                            model_->numeraire(expiry0Time, z[k],
-                                              discountCurve_));
-                }
+                if (expiry0 > settlement)
+                    npv0[k] = std::max(npv0[k], exerciseValue[k]);
             }
 
             npv1.swap(npv0);
@@ -50,6 +50,9 @@ namespace QuantLib {
         Array npv0(2 * integrationPoints_ + 1, 0.0),
             npv1(2 * integrationPoints_ + 1, 0.0);
         Array z = model_->yGrid(stddevs_, integrationPoints_);
+        const Matrix &w = model_->gaussianPolynomialIntegralWeights(
+            stddevs_, integrationPoints_);
+        const Size n = z.size();
         Array p(z.size(), 0.0);
 
         Date expiry1 = Null<Date>(), expiry0;
@@ -74,28 +77,49 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
-            // a lazy object is not thread safe, neither is the caching
-            // in gsrprocess. therefore we trigger computations here such
-            // that neither lazy object recalculation nor write access
-            // during caching occurs in the parallized loop below.
-            // this is known to work for the gsr and markov functional
-            // model implementations of Gaussian1dModel
-#ifdef _OPENMP
+            // the exercise values are computed on the whole grid at once
+            // with the vectorized model methods. Since neither the lazy
+            // object nor the caching in gsrprocess are thread safe, this
+            // is also the only place where the model is queried, the
+            // parallelized loop below only rolls back the npvs.
+            Array exerciseValue;
             if (expiry0 > settlement) {
+                Array floatingLegNpv(z.size(), 0.0);
                 for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
-                    model_->forwardRate(arguments_.floatingFixingDates[l],
-                                        expiry0, 0.0,
-                                        arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
+                    floatingLegNpv +=
+                        arguments_.nominal *
+                        arguments_.floatingAccrualTimes[l] *
+                        (arguments_.floatingSpreads[l] +
+                         model_->forwardRate(arguments_.floatingFixingDates[l],
+                                             expiry0, z,
+                                             arguments_.swap->iborIndex())) *
+                        model_->zerobond(arguments_.floatingPayDates[l],
+                                         expiry0, z, discountCurve_);
                 }
+                Array fixedLegNpv(z.size(), 0.0);
                 for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
+                    fixedLegNpv +=
+                        arguments_.fixedCoupons[l] *
+                        model_->zerobond(arguments_.fixedPayDates[l], expiry0,
+                                         z, discountCurve_);
+                }
+                exerciseValue = (type == Option::Call ? 1.0 : -1.0) *
+                                (floatingLegNpv - fixedLegNpv) /
+                                model_->numeraire(expiry0Time, z,
+                                                  discountCurve_);
+            }
+
+            // the state process is evaluated here for the same reason
+            std::vector<Array> yg;
+            if (expiry1Time != Null<Real>()) {
+                for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
+                     k++) {
+                    yg.push_back(model_->yGrid(stddevs_, integrationPoints_,
+                                               expiry1Time, expiry0Time,
+                                               expiry0 > settlement ? z[k]
+                                                                    : 0.0));
                 }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
             }
-#endif
 
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -103,86 +127,54 @@ namespace QuantLib {
 
                 Real price = 0.0;
                 if (expiry1Time != Null<Real>()) {
-                    Array yg = model_->yGrid(stddevs_, integrationPoints_,
-                                             expiry1Time, expiry0Time,
-                                             expiry0 > settlement ? z[k] : 0.0);
                     CubicInterpolation payoff0(
                         z.begin(), z.end(), npv1.begin(),
                         CubicInterpolation::Spline, true,
                         CubicInterpolation::Lagrange, 0.0,
                         CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
-                        p[i] = payoff0(yg[i], true);
+                    for (Size i = 0; i < yg[k].size(); i++) {
+                        p[i] = payoff0(yg[k][i], true);
                     }
                     CubicInterpolation payoff1(
                         z.begin(), z.end(), p.begin(),
                         CubicInterpolation::Spline, true,
                         CubicInterpolation::Lagrange, 0.0,
                         CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < z.size() - 1; i++) {
+                    for (Size i = 0; i < n - 1; i++) {
                         price += model_->gaussianShiftedPolynomialIntegral(
-                            0.0, payoff1.cCoefficients()[i],
+                            payoff1.cCoefficients()[i],
                             payoff1.bCoefficients()[i],
-                            payoff1.aCoefficients()[i], p[i], z[i], z[i],
-                            z[i + 1]);
+                            payoff1.aCoefficients()[i], p[i], w, i);
                     }
                     if (extrapolatePayoff_) {
                         if (flatPayoffExtrapolation_) {
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                z[z.size() - 2], z[z.size() - 1], 100.0);
+                                0.0, 0.0, 0.0, p[n - 2], w, n - 1);
                             price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0, z[0]);
+                                0.0, 0.0, 0.0, p[0], w, n);
                         } else {
                             if (type == Option::Call)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1.cCoefficients()[z.size() - 2],
-                                        payoff1.bCoefficients()[z.size() - 2],
-                                        payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0);
+                                        payoff1.cCoefficients()[n - 2],
+                                        payoff1.bCoefficients()[n - 2],
+                                        payoff1.aCoefficients()[n - 2],
+                                        p[n - 2], w, n - 1);
                             if (type == Option::Put)
                                 price +=
                                     model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
+                                        payoff1.cCoefficients()[0],
                                         payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]);
+                                        payoff1.aCoefficients()[0], p[0], w,
+                                        n);
                         }
                     }
                 }
 
                 npv0[k] = price;
 
-                if (expiry0 > settlement) {
-                    Real floatingLegNpv = 0.0;
-                    for (Size l = k1; l < arguments_.floatingCoupons.size();
-                         l++) {
-                        floatingLegNpv +=
-                            arguments_.nominal *
-                            arguments_.floatingAccrualTimes[l] *
-                            (arguments_.floatingSpreads[l] +
-                             model_->forwardRate(
-                                 arguments_.floatingFixingDates[l], expiry0,
-                                 z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
-                    }
-                    Real fixedLegNpv = 0.0;
-                    for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
-                    }
-                    npv0[k] = std::max(npv0[k],
-                                       (type == Option::Call ? 1.0 : -1.0) *
-                                           (floatingLegNpv - fixedLegNpv) /
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
-                }
+                if (expiry0 > settlement)
+                    npv0[k] = std::max(npv0[k], exerciseValue[k]);
             }
 
             npv1.swap(npv0);
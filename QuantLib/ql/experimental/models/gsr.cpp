@@ -210,4 +210,57 @@ namespace QuantLib {
         return zerobond(p->getForwardMeasureTime(), t, y, yts);
     }
 
+    const Disposable<Array>
+    Gsr::zerobondImpl(const Time T, const Time t, const Array &y,
+                      const Handle<YieldTermStructure> &yts) const {
+
+        calculate();
+
+        if (t == 0.0) {
+            Array result(y.size(), yts.empty()
+                                       ? this->termStructure()->discount(T, true)
+                                       : yts->discount(T, true));
+            return result;
+        }
+
+        boost::shared_ptr<GsrProcess> p =
+            boost::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+        // everything but the state variable is the same for all points
+        Real stdDev = p->stdDeviation(0.0, 0.0, t);
+        Real expectation = stateProcess_->expectation(0.0, 0.0, t);
+        Real gtT = p->G(t, T, 0.0);
+        Real convexity = -0.5 * p->y(t) * gtT * gtT;
+
+        Real d = yts.empty() ? termStructure()->discount(T, true) /
+                                   termStructure()->discount(t, true)
+                             : yts->discount(T, true) / yts->discount(t, true);
+
+        Array result(y.size());
+        for (Size i = 0; i < y.size(); i++) {
+            Real x = y[i] * stdDev + expectation;
+            result[i] = d * exp(-x * gtT + convexity);
+        }
+        return result;
+    }
+
+    const Disposable<Array>
+    Gsr::numeraireImpl(const Time t, const Array &y,
+                       const Handle<YieldTermStructure> &yts) const {
+
+        calculate();
+
+        boost::shared_ptr<GsrProcess> p =
+            boost::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+        if (t == 0) {
+            Array result(y.size(),
+                         yts.empty() ? this->termStructure()->discount(
+                                           p->getForwardMeasureTime(), true)
+                                     : yts->discount(p->getForwardMeasureTime()));
+            return result;
+        }
+        return zerobond(p->getForwardMeasureTime(), t, y, yts);
+    }
+
 }
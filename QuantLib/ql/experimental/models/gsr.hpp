@@ -150,6 +150,14 @@ namespace QuantLib {
         const Real zerobondImpl(const Time T, const Time t, const Real y,
                                 const Handle<YieldTermStructure> &yts) const;
 
+        const Disposable<Array>
+        numeraireImpl(const Time t, const Array &y,
+                      const Handle<YieldTermStructure> &yts) const;
+
+        const Disposable<Array>
+        zerobondImpl(const Time T, const Time t, const Array &y,
+                     const Handle<YieldTermStructure> &yts) const;
+
         void generateArguments() {
             boost::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
             notifyObservers();
@@ -229,6 +229,8 @@ namespace QuantLib {
 
         discreteNumeraire_ = boost::shared_ptr<Matrix>(new Matrix(
             times_.size(), 2 * modelSettings_.yGridPoints_ + 1, 1.0));
+        tabulatedRates_ =
+            Matrix(times_.size(), y_.size(), Null<Real>());
         for (Size i = 0; i < times_.size(); i++) {
             boost::shared_ptr<Interpolation> numInt(new CubicInterpolation(
                 y_.begin(), y_.end(), discreteNumeraire_->row_begin(i),
@@ -468,6 +470,9 @@ namespace QuantLib {
         modelOutputs_.adjustmentFactors_.clear();
         modelOutputs_.digitalsAdjustmentFactors_.clear();
 
+        // initial width of the bracket for warm starts
+        const Real warmStartStep = 0.0005;
+
         int idx = times_.size() - 2;
 
         for (std::map<Date, CalibrationPoint>::reverse_iterator
@@ -502,6 +507,7 @@ namespace QuantLib {
                 digitalsCorrectionFactor);
 
             Real digital = 0.0, swapRate, swapRate0;
+            std::vector<Real> digitals(y_.size()), swapRates(y_.size());
 
             for (int c = 0;
                  c == 0 || (c == 1 && (modelSettings_.adjustments_ &
@@ -514,9 +520,9 @@ namespace QuantLib {
                         digitalsCorrectionFactor;
                 }
 
+                // the digital prices are accumulated from the upper end
+                // of the grid before the market rates are solved for
                 digital = 0.0;
-                swapRate0 =
-                    modelSettings_.upperRateBound_ / 2.0; // initial guess
                 for (int j = y_.size() - 1; j >= 0; j--) {
 
                     Real integral = 0.0;
@@ -562,33 +568,63 @@ namespace QuantLib {
                     }
 
                     digital += integral * numeraire0 * digitalsCorrectionFactor;
+                    digitals[j] = digital;
+                }
 
-                    if (digital >= i->second.minRateDigital_)
-                        swapRate = modelSettings_.lowerRateBound_;
-                    else {
-                        if (digital <= i->second.maxRateDigital_)
-                            swapRate = modelSettings_.upperRateBound_;
-                        else {
-                            swapRate = marketSwapRate(i->first, i->second,
-                                                      digital, swapRate0);
-                            if (j < (int)y_.size() - 1 &&
-                                swapRate > swapRate0) {
-                                QL_MFMESSAGE(
-                                    modelOutputs_,
-                                    "WARNING: swap rate is decreasing in y for "
-                                    "t="
-                                        << times_[idx] << ", j=" << j
-                                        << " (y, swap rate) is (" << y_[j]
-                                        << "," << swapRate
-                                        << ") but for j=" << j + 1 << " it is ("
-                                        << y_[j + 1] << "," << swapRate0
-                                        << ") --- reset rate to " << swapRate0
-                                        << " in node j=" << j);
-                                swapRate = swapRate0;
-                            }
+                // in the second pass the rates of the first one are the
+                // natural guesses, otherwise those of the last tabulation
+                // are used if warm starts are enabled; with a guess for
+                // each node the rates are solved for independently
+                bool warmStart = c == 1 || modelSettings_.warmStart_;
+                for (Size j = 0; j < y_.size(); j++) {
+                    if (c == 0)
+                        swapRates[j] = tabulatedRates_[idx][j];
+                    if (swapRates[j] == Null<Real>())
+                        warmStart = false;
+                }
+
+                if (warmStart) {
+                    // the smile section is evaluated once before, so
+                    // that lazy calculations are not done concurrently
+                    marketDigitalPrice(i->first, i->second, Option::Call,
+                                       i->second.atm_);
+                    std::vector<std::string> errors(y_.size());
+                    #pragma omp parallel for
+                    for (long j = 0; j < long(y_.size()); j++) {
+                        try {
+                            swapRates[j] =
+                                gridSwapRate(i->first, i->second, digitals[j],
+                                             swapRates[j], warmStartStep);
+                        } catch (std::exception &e) {
+                            errors[j] = e.what();
+                        } catch (...) {
+                            errors[j] = "unknown error";
                         }
                     }
-                    swapRate0 = swapRate;
+                    for (Size j = 0; j < y_.size(); j++)
+                        QL_REQUIRE(errors[j].empty(), errors[j]);
+                }
+
+                // otherwise each rate is the guess for the next one
+                swapRate0 =
+                    modelSettings_.upperRateBound_ / 2.0; // initial guess
+                for (int j = y_.size() - 1; j >= 0; j--) {
+                    swapRate = warmStart ? swapRates[j]
+                                         : gridSwapRate(i->first, i->second,
+                                                        digitals[j], swapRate0);
+                    if (j < (int)y_.size() - 1 && swapRate > swapRate0) {
+                        QL_MFMESSAGE(
+                            modelOutputs_,
+                            "WARNING: swap rate is decreasing in y for t="
+                                << times_[idx] << ", j=" << j
+                                << " (y, swap rate) is (" << y_[j] << ","
+                                << swapRate << ") but for j=" << j + 1
+                                << " it is (" << y_[j + 1] << "," << swapRate0
+                                << ") --- reset rate to " << swapRate0
+                                << " in node j=" << j);
+                        swapRate = swapRate0;
+                    }
+                    swapRate0 = swapRates[j] = swapRate;
                     Real numeraire =
                         1.0 / (swapRate * discreteDeflatedAnnuities[j] +
                                deflatedFinalPayments[j]);
@@ -596,6 +632,9 @@ namespace QuantLib {
                 }
             }
 
+            std::copy(swapRates.begin(), swapRates.end(),
+                      tabulatedRates_.row_begin(idx));
+
             if (modelSettings_.adjustments_ & ModelSettings::AdjustYts) {
                 numeraire_[idx]->update();
                 Real modelDeflatedZerobond = deflatedZerobond(times_[idx], 0.0);
@@ -773,15 +812,21 @@ namespace QuantLib {
         Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
         Real stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
 
+        // the numeraire is evaluated on the Gauss Hermite points of
+        // all states at once
+        const Size m = modelSettings_.gaussHermitePoints_;
+        Array ya(y.size() * m);
         for (Size j = 0; j < y.size(); j++) {
-            Array ya(modelSettings_.gaussHermitePoints_);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                ya[i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
-                        stdDev_0_T;
+            for (Size i = 0; i < m; i++) {
+                ya[j * m + i] =
+                    (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
+                    stdDev_0_T;
             }
-            Array res = numeraireArray(T, ya);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                result[j] += normalIntegralW_[i] / res[i];
+        }
+        Array res = numeraireArray(T, ya);
+        for (Size j = 0; j < y.size(); j++) {
+            for (Size i = 0; i < m; i++) {
+                result[j] += normalIntegralW_[i] / res[j * m + i];
             }
         }
 
@@ -819,6 +864,45 @@ namespace QuantLib {
                                      termStructure()->discount(T)));
     }
 
+    const Disposable<Array> MarkovFunctional::numeraireImpl(
+        const Time t, const Array &y,
+        const Handle<YieldTermStructure> &yts) const {
+
+        if (t == 0) {
+            Array result(y.size(),
+                         yts.empty() ? this->termStructure()->discount(
+                                           numeraireTime(), true)
+                                     : yts->discount(numeraireTime()));
+            return result;
+        }
+
+        Array result = numeraireArray(t, y);
+        if (!yts.empty())
+            result *= yts->discount(numeraireTime()) / yts->discount(t) *
+                      termStructure()->discount(t) /
+                      termStructure()->discount(numeraireTime());
+        return result;
+    }
+
+    const Disposable<Array> MarkovFunctional::zerobondImpl(
+        const Time T, const Time t, const Array &y,
+        const Handle<YieldTermStructure> &yts) const {
+
+        if (t == 0.0) {
+            Array result(y.size(), yts.empty()
+                                       ? this->termStructure()->discount(T, true)
+                                       : yts->discount(T, true));
+            return result;
+        }
+
+        Array result = zerobondArray(T, t, y);
+        if (!yts.empty())
+            result *= yts->discount(T) / yts->discount(t) *
+                      termStructure()->discount(t) /
+                      termStructure()->discount(T);
+        return result;
+    }
+
     const Real MarkovFunctional::deflatedZerobond(Time T, Time t,
                                                   Real y) const {
 
@@ -826,17 +910,46 @@ namespace QuantLib {
         return deflatedZerobondArray(T, t, ya)[0];
     }
 
+    const Real MarkovFunctional::gridSwapRate(const Date &expiry,
+                                              const CalibrationPoint &p,
+                                              const Real digitalPrice,
+                                              const Real guess,
+                                              const Real step) const {
+
+        if (digitalPrice >= p.minRateDigital_)
+            return modelSettings_.lowerRateBound_;
+        if (digitalPrice <= p.maxRateDigital_)
+            return modelSettings_.upperRateBound_;
+        return marketSwapRate(expiry, p, digitalPrice, guess, step);
+    }
+
     const Real MarkovFunctional::marketSwapRate(const Date &expiry,
                                                 const CalibrationPoint &p,
                                                 const Real digitalPrice,
-                                                const Real guess) const {
+                                                const Real guess,
+                                                const Real step) const {
 
         ZeroHelper z(this, expiry, p, digitalPrice);
+        Real start =
+            std::max(std::min(guess, modelSettings_.upperRateBound_ - 0.00001),
+                     modelSettings_.lowerRateBound_ + 0.00001);
+        if (step != Null<Real>()) {
+            // bracket the solution starting from the guess, if this fails
+            // (e.g. because the digital prices are too flat) we fall back
+            // to the whole range of rates
+            try {
+                Brent w;
+                w.setMaxEvaluations(20);
+                w.setLowerBound(modelSettings_.lowerRateBound_);
+                w.setUpperBound(modelSettings_.upperRateBound_);
+                return w.solve(z, modelSettings_.marketRateAccuracy_, start,
+                               step);
+            } catch (Error &) {
+            }
+        }
         Brent b;
         Real solution = b.solve(
-            z, modelSettings_.marketRateAccuracy_,
-            std::max(std::min(guess, modelSettings_.upperRateBound_ - 0.00001),
-                     modelSettings_.lowerRateBound_ + 0.00001),
+            z, modelSettings_.marketRateAccuracy_, start,
             modelSettings_.lowerRateBound_, modelSettings_.upperRateBound_);
         return solution;
     }
@@ -900,6 +1013,8 @@ namespace QuantLib {
                                       MarkovFunctional::ModelSettings::SabrSmile
                                   ? "Sabr"
                                   : "") << std::endl;
+        out << "Warm start           : " << (m.settings_.warmStart_ ? "yes" : "no")
+            << std::endl;
         out << "Smile moneyness checkpoints: ";
         for (Size i = 0; i < m.settings_.smileMoneynessCheckpoints_.size(); i++)
             out << m.settings_.smileMoneynessCheckpoints_[i]
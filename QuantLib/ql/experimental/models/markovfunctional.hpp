@@ -94,7 +94,20 @@ namespace QuantLib {
       input smile or accumulating numerical errors in very long term calibrations.
       The former point is adressed by smile pretreatment options. The latter point
       may be tackled by higher values for the numerical parameters possibly
-      together with NTL high precision computing. */
+      together with NTL high precision computing.
+
+      If warm starts are enabled in the model settings, the rates solved
+      for in the last tabulation of the numeraire are used as initial
+      guesses when the market data changes. This speeds up recalibrations
+      after small market moves, e.g. intraday, but makes the result depend
+      on the last tabulation within the market rate accuracy. Otherwise,
+      the rate on each node of the state variable grid is the initial
+      guess for the next one. When every node has its own guess, i.e. with
+      warm starts or in the second pass of the digitals adjustment, the
+      rates are solved for concurrently if OpenMP is enabled. The input
+      smile sections must then allow concurrent calls of their const
+      methods; each of them is evaluated once beforehand, so that lazy
+      calculations are not done concurrently. */
 
     class MarkovFunctional : public Gaussian1dModel, public CalibratedModel {
 
@@ -120,7 +133,8 @@ namespace QuantLib {
                   digitalGap_(1E-5), marketRateAccuracy_(1E-7),
                   lowerRateBound_(0.0), upperRateBound_(2.0),
                   adjustments_(KahaleSmile | SmileExponentialExtrapolation),
-                  smileMoneynessCheckpoints_(std::vector<Real>()) {}
+                  smileMoneynessCheckpoints_(std::vector<Real>()),
+                  warmStart_(false) {}
 
             void validate() {
 
@@ -210,6 +224,10 @@ namespace QuantLib {
                 smileMoneynessCheckpoints_ = m;
                 return *this;
             }
+            ModelSettings &withWarmStart(bool w) {
+                warmStart_ = w;
+                return *this;
+            }
 
             Size yGridPoints_;
             Real yStdDevs_;
@@ -218,6 +236,7 @@ namespace QuantLib {
             Real lowerRateBound_, upperRateBound_;
             int adjustments_;
             std::vector<Real> smileMoneynessCheckpoints_;
+            bool warmStart_;
         };
 
         struct CalibrationPoint {
@@ -316,6 +335,14 @@ namespace QuantLib {
         const Real zerobondImpl(const Time T, const Time t, const Real y,
                                 const Handle<YieldTermStructure> &yts) const;
 
+        const Disposable<Array>
+        numeraireImpl(const Time t, const Array &y,
+                      const Handle<YieldTermStructure> &yts) const;
+
+        const Disposable<Array>
+        zerobondImpl(const Time T, const Time t, const Array &y,
+                     const Handle<YieldTermStructure> &yts) const;
+
         void generateArguments() {
             // if calculate triggers performCalculations, updateNumeraireTabulations
             // is called twice. If we can not check the lazy object status this seem
@@ -356,9 +383,15 @@ namespace QuantLib {
                                           const Period &tenor);
         void makeCapletCalibrationPoint(const Date &expiry);
 
+        // market rate for a node of the state grid, taking the rate
+        // bounds into account
+        const Real gridSwapRate(const Date &expiry, const CalibrationPoint &p,
+                                const Real digitalPrice, const Real guess,
+                                const Real step = Null<Real>()) const;
         const Real marketSwapRate(const Date &expiry, const CalibrationPoint &p,
                                   const Real digitalPrice,
-                                  const Real guess = 0.03) const;
+                                  const Real guess = 0.03,
+                                  const Real step = Null<Real>()) const;
         const Real marketDigitalPrice(const Date &expiry,
                                       const CalibrationPoint &p,
                                       const Option::Type &type,
@@ -443,6 +476,9 @@ namespace QuantLib {
         // vector of interpolated numeraires in y direction for all calibration
         // times
         std::vector<boost::shared_ptr<Interpolation> > numeraire_;
+        // market rates solved for on the grid in the last tabulation of
+        // the numeraire, used as initial guesses if warm starts are enabled
+        mutable Matrix tabulatedRates_;
 
         Parameter reversion_;
         Parameter &sigma_;
@@ -0,0 +1,55 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+This file is part of QuantLib, a free-software/open-source library
+for financial quantitative analysts and developers - http://quantlib.org/
+
+QuantLib is free software: you can redistribute it and/or modify it
+under the terms of the QuantLib license.  You should have received a
+copy of the license along with this program; if not, please email
+<quantlib-dev@lists.sf.net>. The license is also available online at
+<http://quantlib.org/license.shtml>.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosvariancegammaengine.hpp
+    \brief Fourier-cosine engine for vanilla options under a Variance Gamma model
+*/
+
+#ifndef quantlib_cos_variancegamma_engine_hpp
+#define quantlib_cos_variancegamma_engine_hpp
+
+#include <ql/pricingengines/vanilla/cosengine.hpp>
+#include <ql/experimental/variancegamma/variancegammamodel.hpp>
+
+namespace QuantLib {
+
+    //! Fourier-cosine engine for vanilla options under a Variance Gamma model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+        comparison with the analytic approach
+    */
+    class COSVarianceGammaEngine : public COSEngine {
+    public:
+        COSVarianceGammaEngine(
+            const boost::shared_ptr<VarianceGammaModel>& model,
+            Real L = 8.0, Size N = 512);
+
+    protected:
+        std::complex<Real> characteristicFunction(Real u, Time t) const;
+        Real underlying() const;
+        Handle<YieldTermStructure> riskFreeRate() const;
+        Handle<YieldTermStructure> dividendYield() const;
+
+    private:
+        boost::shared_ptr<VarianceGammaModel> model_;
+    };
+
+}
+
+
+#endif
@@ -25,12 +25,37 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 namespace QuantLib {
 
+    namespace {
+
+        // Damping factor of the call price in log strike
+        const Real alpha = 1.25;
+
+        // Simpson weights of the integration grid
+        Real simpsonWeight(Size i, Real eta) {
+            return eta * (3.0 + ((i % 2) == 0 ? -1.0 : 1.0) - ((i == 0) ? 1.0 : 0.0)) / 3.0;
+        }
+
+    }
+
     FFTEngine::FFTEngine(
-        const boost::shared_ptr<StochasticProcess1D>& process, Real logStrikeSpacing)
-        : process_(process), lambda_(logStrikeSpacing) {
+        const boost::shared_ptr<StochasticProcess1D>& process, Real logStrikeSpacing,
+        Size frequencyPoints, Real frequencySpacing)
+        : process_(process), lambda_(logStrikeSpacing),
+          n_(frequencyPoints), eta_(frequencySpacing) {
+            QL_REQUIRE(frequencyPoints == 0 || frequencyPoints > 1,
+                "at least two frequency points required");
+            QL_REQUIRE(frequencySpacing > 0.0, "positive frequency spacing required");
             registerWith(process_);
     }
 
+    FFTEngine::FFTEngine(
+        Real logStrikeSpacing, Size frequencyPoints, Real frequencySpacing)
+        : lambda_(logStrikeSpacing), n_(frequencyPoints), eta_(frequencySpacing) {
+            QL_REQUIRE(frequencyPoints == 0 || frequencyPoints > 1,
+                "at least two frequency points required");
+            QL_REQUIRE(frequencySpacing > 0.0, "positive frequency spacing required");
+    }
+
     void FFTEngine::calculate() const
     {
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
@@ -101,15 +126,16 @@ namespace QuantLib {
             payoffMap[option->exercise()->lastDate()].push_back(payoff);
         }
 
-        std::complex<Real> i1(0, 1);
-        Real alpha = 1.25;
+        // Transforms are shared among all payoffs with the same expiry,
+        // and chirps among all expiries with the same number of strikes
+        ChirpMap chirps;
+        const Real spot = process_ ? process_->x0() : multiDimProcess_->initialValues()[0];
 
         for (PayoffMap::const_iterator payIt = payoffMap.begin(); payIt != payoffMap.end(); ++payIt)
         {
             Date expiryDate = payIt->first;
 
-            // Calculate n large enough for maximum strike, and round up to a power of 2
-            Real maxStrike = 0.0;
+            Real minStrike = QL_MAX_REAL, maxStrike = 0.0;
             for (PayoffList::const_iterator it = payIt->second.begin();
                 it != payIt->second.end(); ++it)
             {
@@ -117,68 +143,39 @@ namespace QuantLib {
 
                 if (payoff->strike() > maxStrike)
                     maxStrike = payoff->strike();
+                if (payoff->strike() < minStrike)
+                    minStrike = payoff->strike();
             }
-            Real nR = 2.0 * (std::log(maxStrike) + lambda_) / lambda_;
-      Size log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
-            Size n = 1 << log2_n;
-
-            // Strike range (equation 19,20)
-            Real b = n * lambda_ / 2.0;
-
-            // Grid spacing (equation 23)
-            Real eta = 2.0 * M_PI / (lambda_ * n);
+            QL_REQUIRE(minStrike > 0.0, "positive strikes required");
 
             // Discount factor
             Real df = discountFactor(expiryDate);
             Real div = dividendYield(expiryDate);
 
-            // Input to fourier transform
-            std::vector<std::complex<Real> > fti;
-            fti.resize(n);
-
             // Precalculate any discount factors etc.
             precalculateExpiry(expiryDate);
 
-            for (Size i=0; i<n; i++)
-            {
-                Real v_j = eta * i;
-                Real sw = eta * (3.0 + ((i % 2) == 0 ? -1.0 : 1.0) - ((i == 0) ? 1.0 : 0.0)) / 3.0; 
-
-                std::complex<Real> psi = df * complexFourierTransform(v_j - (alpha + 1)* i1);
-                psi = psi / (alpha*alpha + alpha - v_j*v_j + i1 * (2 * alpha + 1.0) * v_j);
-
-                fti[i] = std::exp(i1 * b * v_j)  * sw * psi;
-            }
-
-            // Perform fft
-            std::vector<std::complex<Real> > results(n);
-            FastFourierTransform fft(log2_n);
-            fft.transform(fti.begin(), fti.end(), results.begin());
-
             // Call prices
             std::vector<Real> prices, strikes;
-            prices.resize(n);
-            strikes.resize(n);
-            for (Size i=0; i<n; i++)
-            {
-                Real k_u = -b + lambda_ * i;
-                prices[i] = (std::exp(-alpha * k_u) / M_PI) * results[i].real();
-                strikes[i] = std::exp(k_u);
-            }
+            if (n_ == 0)
+                standardTransform(df, maxStrike, strikes, prices);
+            else
+                fractionalTransform(df, minStrike, maxStrike, chirps, strikes, prices);
 
+            LinearInterpolation callPrices(strikes.begin(), strikes.end(), prices.begin());
             for (PayoffList::const_iterator it = payIt->second.begin();
                 it != payIt->second.end(); ++it)
             {
                 boost::shared_ptr<StrikedTypePayoff> payoff = *it;
 
-                Real callPrice = LinearInterpolation(strikes.begin(), strikes.end(), prices.begin())(payoff->strike());
+                Real callPrice = callPrices(payoff->strike());
                 switch (payoff->optionType())
                 {
                 case Option::Call:
                     resultMap_[expiryDate][payoff] = callPrice;
                     break;
                 case Option::Put:
-                    resultMap_[expiryDate][payoff] = callPrice - process_->x0() * div + payoff->strike() * df;
+                    resultMap_[expiryDate][payoff] = callPrice - spot * div + payoff->strike() * df;
                     break;
                 default:
                     QL_FAIL("Invalid option type");
@@ -187,5 +184,114 @@ namespace QuantLib {
         }
     }
 
+    std::complex<Real> FFTEngine::dampedCallTransform(Real v, DiscountFactor df) const
+    {
+        // Fourier transform of the damped call price (equation 6)
+        std::complex<Real> i1(0, 1);
+        std::complex<Real> psi = df * complexFourierTransform(v - (alpha + 1)* i1);
+        return psi / (alpha*alpha + alpha - v*v + i1 * (2 * alpha + 1.0) * v);
+    }
+
+    void FFTEngine::standardTransform(DiscountFactor df, Real maxStrike,
+        std::vector<Real>& strikes, std::vector<Real>& prices) const
+    {
+        std::complex<Real> i1(0, 1);
+
+        // Calculate n large enough for maximum strike, and round up to a power of 2
+        Real nR = 2.0 * (std::log(maxStrike) + lambda_) / lambda_;
+        Size log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
+        Size n = 1 << log2_n;
+
+        // Strike range (equation 19,20)
+        Real b = n * lambda_ / 2.0;
+
+        // Grid spacing (equation 23)
+        Real eta = 2.0 * M_PI / (lambda_ * n);
+
+        // Input to fourier transform
+        std::vector<std::complex<Real> > fti;
+        fti.resize(n);
+
+        for (Size i=0; i<n; i++)
+        {
+            Real v_j = eta * i;
+            fti[i] = std::exp(i1 * b * v_j) * simpsonWeight(i, eta)
+                * dampedCallTransform(v_j, df);
+        }
+
+        // Perform fft
+        std::vector<std::complex<Real> > results(n);
+        FastFourierTransform fft(log2_n);
+        fft.transform(fti.begin(), fti.end(), results.begin());
+
+        prices.resize(n);
+        strikes.resize(n);
+        for (Size i=0; i<n; i++)
+        {
+            Real k_u = -b + lambda_ * i;
+            prices[i] = (std::exp(-alpha * k_u) / M_PI) * results[i].real();
+            strikes[i] = std::exp(k_u);
+        }
+    }
+
+    void FFTEngine::fractionalTransform(DiscountFactor df, Real minStrike, Real maxStrike,
+        ChirpMap& chirps, std::vector<Real>& strikes, std::vector<Real>& prices) const
+    {
+        std::complex<Real> i1(0, 1);
+
+        // Log strike grid covering the requested strikes only
+        Real k0 = std::log(minStrike);
+        Size m = std::max<Size>(2,
+            static_cast<Size>(std::ceil((std::log(maxStrike) - k0) / lambda_)) + 1);
+
+        // The sum over i of x_i exp(-2 pi i beta i j) is a convolution
+        // with the chirp exp(i pi beta k^2) (Bluestein's algorithm),
+        // performed with power-of-2 FFTs
+        Real beta = eta_ * lambda_ / (2.0 * M_PI);
+        FastFourierTransform fft(FastFourierTransform::min_order(n_ + m - 1));
+        Size p = fft.output_size();
+
+        std::vector<std::complex<Real> >& chirp = chirps[m];
+        if (chirp.empty())
+        {
+            std::vector<std::complex<Real> > z(p, 0.0);
+            for (Size k=0; k<std::max(m, n_); k++)
+            {
+                std::complex<Real> w = std::exp(i1 * (M_PI * beta * k * k));
+                if (k < m)
+                    z[k] = w;
+                if (k > 0 && k < n_)
+                    z[p-k] = w;
+            }
+            chirp.resize(p);
+            fft.transform(z.begin(), z.end(), chirp.begin());
+        }
+
+        std::vector<std::complex<Real> > x(p, 0.0);
+        for (Size i=0; i<n_; i++)
+        {
+            Real v_i = eta_ * i;
+            x[i] = std::exp(-i1 * (v_i * k0 + M_PI * beta * i * i))
+                * simpsonWeight(i, eta_) * dampedCallTransform(v_i, df);
+        }
+
+        std::vector<std::complex<Real> > y(p), results(p);
+        fft.transform(x.begin(), x.end(), y.begin());
+        for (Size k=0; k<p; k++)
+            y[k] *= chirp[k];
+        fft.inverse_transform(y.begin(), y.end(), results.begin());
+
+        prices.resize(m);
+        strikes.resize(m);
+        for (Size j=0; j<m; j++)
+        {
+            Real k_j = k0 + lambda_ * j;
+            std::complex<Real> sum =
+                std::exp(-i1 * (M_PI * beta * j * j)) * results[j] / Real(p);
+            prices[j] = (std::exp(-alpha * k_j) / M_PI) * sum.real();
+            strikes[j] = std::exp(k_j);
+        }
+    }
+
 }
 
@@ -27,6 +27,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/stochasticprocess.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -38,17 +39,28 @@ namespace QuantLib {
         you should collect all the options you wish to price in a list and call 
         the engine's precalculate method before calling the NPV method of the option.
 
+        By default the transform is the standard FFT of Carr and Madan, whose log strike
+        spacing fixes the spacing of the integration grid and whose strike grid spans all
+        strikes from zero to the largest one.  When a number of frequency points is given,
+        a fractional FFT is used instead: the integration grid is set by the number of
+        points and their spacing, and the strike grid only covers the requested strikes.
+
         References:
         Carr, P. and D. B. Madan (1998),
         "Option Valuation using the fast Fourier transform,"
         Journal of Computational Finance, 2, 61-73.
+
+        Chourdakis, K. (2005),
+        "Option pricing using the fractional FFT,"
+        Journal of Computational Finance, 8, 1-18.
     */
 
     class FFTEngine :
         public VanillaOption::engine {
     public:
         FFTEngine(
-            const boost::shared_ptr<StochasticProcess1D>&process, Real logStrikeSpacing);
+            const boost::shared_ptr<StochasticProcess1D>&process, Real logStrikeSpacing,
+            Size frequencyPoints = 0, Real frequencySpacing = 0.25);
         void calculate() const;
         void update();
 
@@ -56,6 +68,12 @@ namespace QuantLib {
         virtual std::auto_ptr<FFTEngine> clone() const = 0;
 
     protected:
+        /*! Engines based on a multi-dimensional process must set
+            multiDimProcess_ and register with it; the first component
+            of the process is taken as the underlying.
+        */
+        FFTEngine(Real logStrikeSpacing, Size frequencyPoints, Real frequencySpacing);
+
         virtual void precalculateExpiry(Date d) = 0;
         virtual std::complex<Real> complexFourierTransform(std::complex<Real> u) const = 0;
         virtual Real discountFactor(Date d) const = 0;
@@ -64,9 +82,19 @@ namespace QuantLib {
             boost::shared_ptr<Exercise> exercise) const;
 
         boost::shared_ptr<StochasticProcess1D> process_;
+        boost::shared_ptr<StochasticProcess> multiDimProcess_;
         Real lambda_;   // Log strike spacing
+        Size n_;        // Number of frequency points of the fractional FFT
+        Real eta_;      // Frequency spacing of the fractional FFT
 
     private:
+        typedef std::map<Size, std::vector<std::complex<Real> > > ChirpMap;
+        void standardTransform(DiscountFactor df, Real maxStrike,
+            std::vector<Real>& strikes, std::vector<Real>& prices) const;
+        void fractionalTransform(DiscountFactor df, Real minStrike, Real maxStrike,
+            ChirpMap& chirps, std::vector<Real>& strikes, std::vector<Real>& prices) const;
+        std::complex<Real> dampedCallTransform(Real v, DiscountFactor df) const;
+
         typedef std::map<boost::shared_ptr<StrikedTypePayoff>, Real> PayoffResultMap;
         typedef std::map<Date, PayoffResultMap> ResultMap;
         ResultMap resultMap_;
@@ -0,0 +1,135 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+This file is part of QuantLib, a free-software/open-source library
+for financial quantitative analysts and developers - http://quantlib.org/
+
+QuantLib is free software: you can redistribute it and/or modify it
+under the terms of the QuantLib license.  You should have received a
+copy of the license along with this program; if not, please email
+<quantlib-dev@lists.sf.net>. The license is also available online at
+<http://quantlib.org/license.shtml>.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
+
+namespace QuantLib {
+
+    FFTHestonEngine::FFTHestonEngine(
+        const boost::shared_ptr<HestonModel>& model, Real logStrikeSpacing,
+        Size frequencyPoints, Real frequencySpacing)
+        : FFTEngine(logStrikeSpacing, frequencyPoints, frequencySpacing),
+          model_(model)
+    {
+        multiDimProcess_ = model_->process();
+        registerWith(multiDimProcess_);
+        registerWith(model_);
+    }
+
+    std::auto_ptr<FFTEngine> FFTHestonEngine::clone() const
+    {
+        return std::auto_ptr<FFTEngine>(
+            new FFTHestonEngine(model_, lambda_, n_, eta_));
+    }
+
+    void FFTHestonEngine::precalculateExpiry(Date d)
+    {
+        boost::shared_ptr<HestonProcess> process = model_->process();
+
+        dividendDiscount_ =
+            process->dividendYield()->discount(d);
+        riskFreeDiscount_ =
+            process->riskFreeRate()->discount(d);
+
+        t_ = process->time(d);
+
+        kappa_ = model_->kappa();
+        theta_ = model_->theta();
+        sigma_ = model_->sigma();
+        rho_ = model_->rho();
+        v0_ = model_->v0();
+    }
+
+    std::complex<Real> FFTHestonEngine::complexFourierTransform(std::complex<Real> u) const
+    {
+        Real s = multiDimProcess_->initialValues()[0];
+
+        std::complex<Real> i1(0, 1);
+        std::complex<Real> phi = std::exp(i1 * u * std::log(s))
+            * std::pow(dividendDiscount_/ riskFreeDiscount_, i1 * u);
+
+        if (sigma_ < 1e-8) {
+            // Deterministic variance
+            Real var = (kappa_ > 1e-8)
+                ? theta_*t_ + (v0_-theta_)*(1.0-std::exp(-kappa_*t_))/kappa_
+                : v0_*t_;
+            return phi * std::exp(-0.5*(u*u + i1*u)*var);
+        }
+
+        Real sigma2 = sigma_*sigma_;
+        std::complex<Real> t1 = kappa_ - rho_*sigma_*i1*u;
+        std::complex<Real> d = std::sqrt(t1*t1 + sigma2*(u*u + i1*u));
+        std::complex<Real> g = (t1-d)/(t1+d);
+        std::complex<Real> e = std::exp(-d*t_);
+
+        std::complex<Real> D = (t1-d)/sigma2*(1.0-e)/(1.0-g*e);
+        std::complex<Real> C = kappa_*theta_/sigma2
+            *((t1-d)*t_ - 2.0*std::log((1.0-g*e)/(1.0-g)));
+
+        return phi * std::exp(C + D*v0_);
+    }
+
+    Real FFTHestonEngine::discountFactor(Date d) const
+    {
+        return model_->process()->riskFreeRate()->discount(d);
+    }
+
+    Real FFTHestonEngine::dividendYield(Date d) const
+    {
+        return model_->process()->dividendYield()->discount(d);
+    }
+
+
+    FFTBatesEngine::FFTBatesEngine(
+        const boost::shared_ptr<BatesModel>& model, Real logStrikeSpacing,
+        Size frequencyPoints, Real frequencySpacing)
+        : FFTHestonEngine(model, logStrikeSpacing, frequencyPoints, frequencySpacing)
+    {
+    }
+
+    std::auto_ptr<FFTEngine> FFTBatesEngine::clone() const
+    {
+        boost::shared_ptr<BatesModel> model =
+            boost::dynamic_pointer_cast<BatesModel>(model_);
+        return std::auto_ptr<FFTEngine>(
+            new FFTBatesEngine(model, lambda_, n_, eta_));
+    }
+
+    void FFTBatesEngine::precalculateExpiry(Date d)
+    {
+        FFTHestonEngine::precalculateExpiry(d);
+
+        boost::shared_ptr<BatesModel> model =
+            boost::dynamic_pointer_cast<BatesModel>(model_);
+        jumpIntensity_ = model->lambda();
+        nu_ = model->nu();
+        delta_ = model->delta();
+    }
+
+    std::complex<Real> FFTBatesEngine::complexFourierTransform(std::complex<Real> u) const
+    {
+        // Compensated log-normal jumps
+        std::complex<Real> i1(0, 1);
+        Real delta2 = 0.5*delta_*delta_;
+        std::complex<Real> jumps = t_*jumpIntensity_
+            *(std::exp(nu_*i1*u - delta2*u*u) - 1.0
+              - i1*u*(std::exp(nu_ + delta2) - 1.0));
+
+        return FFTHestonEngine::complexFourierTransform(u) * std::exp(jumps);
+    }
+
+}
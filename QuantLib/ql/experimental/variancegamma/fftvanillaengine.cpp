@@ -25,8 +25,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 namespace QuantLib {
 
     FFTVanillaEngine::FFTVanillaEngine(
-        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process, Real logStrikeSpacing)
-        : FFTEngine(process, logStrikeSpacing)
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process, Real logStrikeSpacing,
+        Size frequencyPoints, Real frequencySpacing)
+        : FFTEngine(process, logStrikeSpacing, frequencyPoints, frequencySpacing)
     {
     }
 
@@ -34,7 +35,7 @@ namespace QuantLib {
     {
         boost::shared_ptr<GeneralizedBlackScholesProcess> process =
             boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(process_);
-        return std::auto_ptr<FFTEngine>(new FFTVanillaEngine(process, lambda_));
+        return std::auto_ptr<FFTEngine>(new FFTVanillaEngine(process, lambda_, n_, eta_));
     }
 
     void FFTVanillaEngine::precalculateExpiry(Date d)
@@ -24,8 +24,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 namespace QuantLib {
 
     FFTVarianceGammaEngine::FFTVarianceGammaEngine(
-        const boost::shared_ptr<VarianceGammaProcess>& process, Real logStrikeSpacing)
-        : FFTEngine(process, logStrikeSpacing)
+        const boost::shared_ptr<VarianceGammaProcess>& process, Real logStrikeSpacing,
+        Size frequencyPoints, Real frequencySpacing)
+        : FFTEngine(process, logStrikeSpacing, frequencyPoints, frequencySpacing)
     {
     }
 
@@ -33,7 +34,7 @@ namespace QuantLib {
     {
         boost::shared_ptr<VarianceGammaProcess> process =
             boost::dynamic_pointer_cast<VarianceGammaProcess>(process_);
-        return std::auto_ptr<FFTEngine>(new FFTVarianceGammaEngine(process, lambda_));
+        return std::auto_ptr<FFTEngine>(new FFTVarianceGammaEngine(process, lambda_, n_, eta_));
     }
 
     void FFTVarianceGammaEngine::precalculateExpiry(Date d)
@@ -38,7 +38,8 @@ namespace QuantLib {
     class FFTVarianceGammaEngine : public FFTEngine {
     public:
         FFTVarianceGammaEngine(
-            const boost::shared_ptr<VarianceGammaProcess>&process, Real logStrikeSpacing = 0.001);
+            const boost::shared_ptr<VarianceGammaProcess>&process, Real logStrikeSpacing = 0.001,
+            Size frequencyPoints = 0, Real frequencySpacing = 0.25);
         virtual std::auto_ptr<FFTEngine> clone() const;
 
     protected:
@@ -30,6 +30,7 @@
 #include <ql/time/calendar.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/indexes/indexmanager.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -93,13 +94,17 @@ namespace QuantLib {
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
+            Date firstChangedDate = Date::maxDate();
             while (dBegin != dEnd) {
                 validFixing = isValidFixingDate(*dBegin);
                 Real currentValue = h[*dBegin];
                 missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
-                    if (missingFixing)
+                    if (missingFixing) {
+                        firstChangedDate = std::min(firstChangedDate,
+                                                    Date(*dBegin));
                         h[*(dBegin++)] = *(vBegin++);
+                    }
                     else if (close(currentValue,*(vBegin))) {
                         ++dBegin;
                         ++vBegin;
@@ -114,7 +119,7 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            IndexManager::instance().setHistory(tag, h, firstChangedDate);
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
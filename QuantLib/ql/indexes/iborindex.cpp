@@ -21,6 +21,7 @@
 
 #include <ql/indexes/iborindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -88,7 +89,8 @@ namespace QuantLib {
                                    const DayCounter& dc,
                                    const Handle<YieldTermStructure>& h)
    : IborIndex(familyName, 1*Days, settlementDays, curr,
-               fixCal, Following, false, dc, h) {}
+               fixCal, Following, false, dc, h),
+     updates_(0), cumulatedFactors_(1, 1.0) {}
 
     boost::shared_ptr<IborIndex> OvernightIndex::clone(
                                const Handle<YieldTermStructure>& h) const {
@@ -101,4 +103,85 @@ namespace QuantLib {
                                                            h));
     }
 
+    Real OvernightIndex::compoundFactor(const Date& start,
+                                        const Date& end) const {
+        IndexManager& manager = IndexManager::instance();
+        // the notifier changes if the history was cleared
+        boost::shared_ptr<Observable> notifier = manager.notifier(name());
+        if (notifier != notifier_) {
+            notifier_ = notifier;
+            updates_ = 0;
+            updateCompoundingTable(Date());
+        }
+        Size updates = manager.numberOfUpdates(name());
+        if (updates != updates_) {
+            updateCompoundingTable(manager.firstChangedDate(name(),
+                                                            updates_));
+            updates_ = updates;
+        }
+
+        std::vector<Date>::iterator i =
+            std::lower_bound(tabulatedDates_.begin(),
+                             tabulatedDates_.end(), start);
+        std::vector<Date>::iterator j =
+            std::lower_bound(i, tabulatedDates_.end(), end);
+        if (i == tabulatedDates_.end() || *i != start ||
+            j == tabulatedDates_.end() || *j != end)
+            return Null<Real>();
+
+        Size a = i - tabulatedDates_.begin(),
+             b = j - tabulatedDates_.begin();
+        if (gaps_[a] != gaps_[b])
+            return Null<Real>();
+
+        return cumulatedFactors_[b]/cumulatedFactors_[a];
+    }
+
+    void OvernightIndex::updateCompoundingTable(
+                                        const Date& firstChangedDate) const {
+        const TimeSeries<Real>& history = timeSeries();
+        Calendar calendar = fixingCalendar();
+
+        // the part of the table before the first change is kept...
+        Size n = std::lower_bound(tabulatedDates_.begin(),
+                                  tabulatedDates_.end(), firstChangedDate)
+                 - tabulatedDates_.begin();
+        tabulatedDates_.resize(n);
+        tabulatedFixings_.resize(n);
+        gaps_.resize(n);
+        cumulatedFactors_.resize(n+1);
+
+        // ...and the rest is (re)calculated.  The fixings after the
+        // kept part are collected going backwards from the end of the
+        // history, so that only the changed part is visited.
+        std::vector<std::pair<Date,Real> > changed;
+        for (TimeSeries<Real>::const_reverse_iterator h = history.rbegin();
+             h != history.rend(); ++h) {
+            if (n > 0 && h->first <= tabulatedDates_.back())
+                break;
+            changed.push_back(*h);
+        }
+        for (Size k=changed.size(); k>0; --k) {
+            Date d = changed[k-1].first;
+            Rate r = changed[k-1].second;
+            if (r == Null<Real>() || !isValidFixingDate(d))
+                continue;
+            Date v = valueDate(d);
+            Time tau = dayCounter().yearFraction(
+                                       v, calendar.advance(v, 1, Days));
+            // gaps in the history are counted so that ranges spanning
+            // a missing fixing can be detected
+            Size gaps = 0;
+            if (!tabulatedDates_.empty()) {
+                gaps = gaps_.back();
+                if (calendar.advance(tabulatedDates_.back(), 1, Days) != d)
+                    ++gaps;
+            }
+            tabulatedDates_.push_back(d);
+            tabulatedFixings_.push_back(r);
+            gaps_.push_back(gaps);
+            cumulatedFactors_.push_back(cumulatedFactors_.back()*(1.0+r*tau));
+        }
+    }
+
 }
@@ -98,6 +98,36 @@ namespace QuantLib {
         //! returns a copy of itself linked to a different forwarding curve
         boost::shared_ptr<IborIndex> clone(
                                    const Handle<YieldTermStructure>& h) const;
+        //! \name Past fixings
+        //@{
+        /*! Returns the compounded factor \f$ \prod_i (1 + r_i \tau_i) \f$
+            of the stored fixings \f$ r_i \f$ at the fixing dates
+            \f$ d_i \f$ such that \f$ start \le d_i < end \f$, where
+            \f$ \tau_i \f$ is the accrual period between the value date
+            of \f$ d_i \f$ and the following business day.
+
+            The result is the ratio of two lookups in a table of
+            cumulative products over the fixing history.  The table
+            is kept in sync with the IndexManager: when fixings are
+            added, only the entries from the earliest changed date
+            onwards are recalculated.  Each copy of the index keeps
+            its own table.
+
+            A null value is returned if either date is not a stored
+            fixing date or if any fixing in the range is missing.
+        */
+        Real compoundFactor(const Date& start,
+                            const Date& end) const;
+        //@}
+      private:
+        void updateCompoundingTable(const Date& firstChangedDate) const;
+        // the state of the history when the table was last updated
+        mutable boost::shared_ptr<Observable> notifier_;
+        mutable Size updates_;
+        mutable std::vector<Date> tabulatedDates_;
+        mutable std::vector<Rate> tabulatedFixings_;
+        mutable std::vector<Real> cumulatedFactors_;
+        mutable std::vector<Size> gaps_;
     };
 
 
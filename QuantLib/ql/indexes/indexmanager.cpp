@@ -18,6 +18,7 @@
 */
 
 #include <ql/indexes/indexmanager.hpp>
+#include <algorithm>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -32,6 +33,13 @@ using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        // number of updates for which the changed dates are kept
+        const Size recordedUpdates = 100;
+
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
         return data_.find(to_upper_copy(name)) != data_.end();
     }
@@ -43,7 +51,43 @@ namespace QuantLib {
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        setHistory(name, history, Date());
+    }
+
+    void IndexManager::setHistory(const string& name,
+                                  const TimeSeries<Real>& history,
+                                  const Date& firstChangedDate) {
+        string tag = to_upper_copy(name);
+        // the change is recorded first, so that observers notified
+        // by the assignment find it
+        Changes& changes = changes_[tag];
+        std::deque<Date>& dates = changes.firstChangedDates;
+        for (Size i=0; i<dates.size(); ++i)
+            dates[i] = std::min(dates[i], firstChangedDate);
+        dates.push_back(firstChangedDate);
+        if (dates.size() > recordedUpdates)
+            dates.pop_front();
+        ++changes.updates;
+        data_[tag] = history;
+    }
+
+    Size IndexManager::numberOfUpdates(const string& name) const {
+        std::map<string, Changes>::const_iterator i =
+            changes_.find(to_upper_copy(name));
+        return i == changes_.end() ? 0 : i->second.updates;
+    }
+
+    Date IndexManager::firstChangedDate(const string& name,
+                                        Size sinceUpdates) const {
+        std::map<string, Changes>::const_iterator i =
+            changes_.find(to_upper_copy(name));
+        if (i == changes_.end() || sinceUpdates >= i->second.updates)
+            return Date::maxDate();
+        const std::deque<Date>& dates = i->second.firstChangedDates;
+        Size firstRecorded = i->second.updates - dates.size();
+        if (sinceUpdates < firstRecorded)
+            return Date();
+        return dates[sinceUpdates-firstRecorded];
     }
 
     boost::shared_ptr<Observable>
@@ -62,10 +106,12 @@ namespace QuantLib {
 
     void IndexManager::clearHistory(const string& name) {
         data_.erase(to_upper_copy(name));
+        changes_.erase(to_upper_copy(name));
     }
 
     void IndexManager::clearHistories() {
         data_.clear();
+        changes_.clear();
     }
 
 }
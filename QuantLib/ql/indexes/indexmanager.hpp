@@ -27,6 +27,7 @@
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <deque>
 
 
 namespace QuantLib {
@@ -44,6 +45,22 @@ namespace QuantLib {
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
+        /*! stores the historical fixings of the index, which are the
+            same as the ones already stored before the given date
+        */
+        void setHistory(const std::string& name, const TimeSeries<Real>&,
+                        const Date& firstChangedDate);
+        //! number of times the history was stored since it was cleared
+        Size numberOfUpdates(const std::string& name) const;
+        /*! returns the earliest fixing date that might have changed
+            after the given number of updates; a null date is returned
+            if the whole history might have changed.
+
+            \note only the most recent updates are recorded; for
+                  older ones, a null date is returned.
+        */
+        Date firstChangedDate(const std::string& name,
+                              Size sinceUpdates) const;
         //! observer notifying of changes in the index fixings
         boost::shared_ptr<Observable> notifier(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
@@ -56,6 +73,15 @@ namespace QuantLib {
         typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
                                                                   history_map;
         mutable history_map data_;
+        // for each history, the number of updates and, for each of
+        // the most recent ones, the earliest date changed by it or by
+        // the following updates
+        struct Changes {
+            Changes() : updates(0) {}
+            Size updates;
+            std::deque<Date> firstChangedDates;
+        };
+        std::map<std::string, Changes> changes_;
     };
 
 }
@@ -32,6 +32,19 @@ namespace QuantLib {
 
     typedef std::vector<boost::shared_ptr<Dividend> > DividendSchedule;
 
+    //! checks whether two schedules pay the same amounts on the same dates
+    inline bool sameDividends(const DividendSchedule& d1,
+                              const DividendSchedule& d2) {
+        if (d1.size() != d2.size())
+            return false;
+        for (Size i=0; i < d1.size(); ++i) {
+            if (   d1[i]->date() != d2[i]->date()
+                || d1[i]->amount() != d2[i]->amount())
+                return false;
+        }
+        return true;
+    }
+
 }
 
 #endif
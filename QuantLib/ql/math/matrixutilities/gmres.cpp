@@ -0,0 +1,146 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.cpp
+    \brief generalized minimal residual method
+*/
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    GMRES::GMRES(const GMRES::MatrixMult& A,
+                 Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        const GMRESResult result = solveImpl(b, x0, norm2(b));
+
+        QL_REQUIRE(result.error < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveWithRestart(Size restart,
+                                        const Array& b,
+                                        const Array& x0) const {
+        const Real bnorm2 = norm2(b);
+        GMRESResult result = solveImpl(b, x0, bnorm2);
+
+        Size iterations = result.iterations;
+        for (Size i=0; i < restart && result.error >= relTol_; ++i) {
+            result = solveImpl(b, result.x, bnorm2);
+            iterations += result.iterations;
+        }
+        result.iterations = iterations;
+
+        QL_REQUIRE(result.error < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveImpl(const Array& b, const Array& x0,
+                                 Real bnorm2) const {
+        if (bnorm2 == 0.0) {
+            GMRESResult result = { 0, 0.0, b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        Array r = b - A_(x);
+
+        const Real beta = norm2(r);
+        Real error = beta/bnorm2;
+        if (error < relTol_) {
+            GMRESResult result = { 0, error, x };
+            return result;
+        }
+
+        std::vector<Array> v(1, r/beta);
+        std::vector<Array> h;
+        Array g(maxIter_+1, 0.0), c(maxIter_), s(maxIter_);
+        g[0] = beta;
+
+        Size k;
+        for (k=0; k < maxIter_ && error >= relTol_; ++k) {
+            Array w = A_((M_) ? M_(v[k]) : v[k]);
+
+            // modified Gram-Schmidt orthogonalization
+            Array hk(k+2);
+            for (Size i=0; i <= k; ++i) {
+                hk[i] = DotProduct(w, v[i]);
+                w -= hk[i]*v[i];
+            }
+            hk[k+1] = norm2(w);
+
+            // apply previous Givens rotations to the new column
+            for (Size i=0; i < k; ++i) {
+                const Real tmp = c[i]*hk[i] + s[i]*hk[i+1];
+                hk[i+1] = -s[i]*hk[i] + c[i]*hk[i+1];
+                hk[i] = tmp;
+            }
+
+            // and compute the one eliminating the subdiagonal entry
+            const Real nu = std::sqrt(hk[k]*hk[k] + hk[k+1]*hk[k+1]);
+            c[k] = hk[k]/nu;
+            s[k] = hk[k+1]/nu;
+
+            const Real wNorm = hk[k+1];
+            hk[k] = nu;
+            hk[k+1] = 0.0;
+            g[k+1] = -s[k]*g[k];
+            g[k] = c[k]*g[k];
+
+            h.push_back(hk);
+            error = std::fabs(g[k+1])/bnorm2;
+
+            // happy breakdown, the solution lies in the Krylov space
+            if (wNorm == 0.0) {
+                ++k;
+                break;
+            }
+            v.push_back(w/wNorm);
+        }
+
+        // back substitution of the upper triangular system
+        Array y(k);
+        for (Integer i=Integer(k)-1; i >= 0; --i) {
+            Real sum = g[i];
+            for (Size j=i+1; j < k; ++j)
+                sum -= h[j][i]*y[j];
+            y[i] = sum/h[i][i];
+        }
+
+        Array z(b.size(), 0.0);
+        for (Size i=0; i < k; ++i)
+            z += y[i]*v[i];
+
+        x += ((M_) ? M_(z) : z);
+
+        GMRESResult result = { k, error, x };
+        return result;
+    }
+
+    Real GMRES::norm2(const Array& a) const {
+        return std::sqrt(DotProduct(a, a));
+    }
+}
@@ -38,19 +38,20 @@ namespace QuantLib {
         QL_REQUIRE(A.size1() == A.size2(),
                    "sparse ILU preconditioner works only with square matrices");
 
-        for (SparseMatrix::size_type i=0; i < L_.size1(); ++i)
-            L_(i,i) = 1.0;
-
         const Integer n = A.size1();
-        std::set<Integer> lBandSet, uBandSet;
+        std::set<Integer> uBandSet;
 
         compressed_matrix<Integer> levs(n,n);
         Integer lfilp = lfil + 1;
 
         for (Integer ii=0; ii<n; ++ii) {
-            Array w(n);
-            for(Integer k=0; k<n; ++k) {
-                w[k] = A(ii,k);
+            Array w(n, 0.0);
+            const SparseMatrix::const_iterator1 row = A.find1(0, ii, 0);
+            if (row != A.end1() && Integer(row.index1()) == ii) {
+                for (SparseMatrix::const_iterator2 iter = row.begin();
+                     iter != row.end(); ++iter) {
+                    w[iter.index2()] = *iter;
+                }
             }
 
             std::vector<Integer> levii(n, 0);
@@ -129,13 +130,19 @@ namespace QuantLib {
                     leviiNonZeroEntries.push_back(entry);
                 }
             }
+            // the entries are inserted in ascending order, which
+            // keeps the insertion into the compressed matrices cheap
+            bool diagonal = false;
             for (Size k=0; k<wNonZeros.size(); ++k) {
                 Integer j = wNonZeros[k];
                 if (j < ii) {
                     L_(ii,j) = wNonZeroEntries[k];
-                    lBandSet.insert(ii-j);
                 }
                 else {
+                    if (!diagonal) {
+                        L_(ii,ii) = 1.0;
+                        diagonal = true;
+                    }
                     U_(ii,j) = wNonZeroEntries[k];
                     levs(ii,j) = leviiNonZeroEntries[k];
                     if(j-ii > 0) {
@@ -143,11 +150,11 @@ namespace QuantLib {
                     }
                 }
             }
+            if (!diagonal)
+                L_(ii,ii) = 1.0;
         }
-        lBands_.resize(lBandSet.size());
-        uBands_.resize(uBandSet.size());
-        std::copy(lBandSet.begin(), lBandSet.end(), lBands_.begin());
-        std::copy(uBandSet.begin(), uBandSet.end(), uBands_.begin());
+        L_.complete_index1_data();
+        U_.complete_index1_data();
     }
 
     const SparseMatrix& SparseILUPreconditioner::L() const {
@@ -164,31 +171,41 @@ namespace QuantLib {
 
     Disposable<Array> SparseILUPreconditioner::forwardSolve(
                                                        const Array& b) const {
-        Integer n = b.size();
-        Array y(n, 0.0);
-        y[0]=b[0]/L_(0,0);
-        for (Integer i=1; i<=n-1; ++i) {
-            y[i] = b[i]/L_(i,i);
-            for (Integer j=lBands_.size()-1;
-                 j>=0 && i-Integer(lBands_[j]) <= i-1; --j) {
-            	const Integer k = i-Integer(lBands_[j]);
-            	if (k >= 0)
-                	y[i]-=L_(i,k)*y[k]/L_(i,i);
+        // L is unit lower triangular and stored row by row
+        const Size n = b.size();
+        Array y(n);
+        for (Size i=0; i < n; ++i) {
+            Real t = b[i];
+            Real d = 1.0;
+            const Size end = L_.index1_data()[i+1];
+            for (Size k=L_.index1_data()[i]; k < end; ++k) {
+                const Size j = L_.index2_data()[k];
+                if (j < i)
+                    t -= L_.value_data()[k]*y[j];
+                else if (j == i)
+                    d = L_.value_data()[k];
             }
+            y[i] = t/d;
         }
         return y;
     }
 
     Disposable<Array> SparseILUPreconditioner::backwardSolve(
                                                        const Array& y) const {
-        Size n = y.size();
-        Array x(n, 0.0);
-        x[n-1] = y[n-1]/U_(n-1,n-1);
-        for (Integer i=n-2; i>=0; --i) {
-            x[i] = y[i]/U_(i,i);
-            for (Size j=0; j<uBands_.size() && i+uBands_[j] <= n-1; ++j) {
-                x[i] -= U_(i,i+uBands_[j])*x[i+uBands_[j]]/U_(i,i);
+        const Size n = y.size();
+        Array x(n);
+        for (Integer i=Integer(n)-1; i >= 0; --i) {
+            Real t = y[i];
+            Real d = 0.0;
+            const Size end = U_.index1_data()[i+1];
+            for (Size k=U_.index1_data()[i]; k < end; ++k) {
+                const Size j = U_.index2_data()[k];
+                if (j > Size(i))
+                    t -= U_.value_data()[k]*x[j];
+                else if (j == Size(i))
+                    d = U_.value_data()[k];
             }
+            x[i] = t/d;
         }
         return x;
     }
@@ -48,7 +48,6 @@ namespace QuantLib {
 
       private:
         SparseMatrix L_, U_;
-        std::vector<Size> lBands_, uBands_;
 
         Disposable<Array> forwardSolve(const Array& b) const;
         Disposable<Array> backwardSolve(const Array& y) const;
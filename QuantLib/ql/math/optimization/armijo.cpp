@@ -39,7 +39,10 @@ namespace QuantLib {
         Real qp0 = P.gradientNormValue();
 
         qt_ = q0;
-        qpt_ = (gradient_.empty()) ? qp0 : -DotProduct(gradient_,searchDirection_);
+        // the last gradient is stale if the line search was used
+        // for a problem of different dimension
+        qpt_ = (gradient_.size() != searchDirection_.size())
+            ? qp0 : -DotProduct(gradient_,searchDirection_);
 
         // Initialize gradient
         gradient_ = Array(P.currentValue().size());
@@ -53,6 +53,10 @@ namespace QuantLib {
                          Real beta = 0.65)
         : LineSearch(eps), alpha_(alpha), beta_(beta) {}
 
+        std::auto_ptr<LineSearch> clone() const {
+            return std::auto_ptr<LineSearch>(new ArmijoLineSearch(*this));
+        }
+
         //! Perform line search
         Real operator()(Problem& P,             // Optimization problem
                         EndCriteria::Type& ecType,
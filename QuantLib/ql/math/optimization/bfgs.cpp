@@ -26,9 +26,10 @@ namespace QuantLib {
     Disposable<Array> BFGS::getUpdatedDirection(const Problem& P,
                                                 Real,
                                                 const Array& oldGradient) {
-        if (inverseHessian_.rows() == 0)
+        if (inverseHessian_.rows() != P.currentValue().size())
         {
-            // first time in this update, we create needed structures
+            // first time in this update, or the method is reused for a
+            // problem of different dimension: we create needed structures
             inverseHessian_ = Matrix(P.currentValue().size(),
                                      P.currentValue().size(), 0.);
             for (Size i = 0; i < P.currentValue().size(); ++i)
@@ -41,6 +41,9 @@ namespace QuantLib {
         BFGS(const boost::shared_ptr<LineSearch>& lineSearch =
                                               boost::shared_ptr<LineSearch>())
         : LineSearchBasedMethod(lineSearch) {}
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(new BFGS(*this));
+        }
       private:
         //! \name LineSearchBasedMethod interface
         //@{
@@ -44,6 +44,9 @@ namespace QuantLib {
         ConjugateGradient(const boost::shared_ptr<LineSearch>& lineSearch =
                                             boost::shared_ptr<LineSearch>())
         : LineSearchBasedMethod(lineSearch) {}
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(new ConjugateGradient(*this));
+        }
       private:
         //! \name LineSearchBasedMethod interface
         //@{
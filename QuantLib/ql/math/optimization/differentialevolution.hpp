@@ -152,6 +152,11 @@ namespace QuantLib {
         virtual EndCriteria::Type minimize(Problem& p,
                                            const EndCriteria& endCriteria);
 
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(
+                                           new DifferentialEvolution(*this));
+        }
+
         const Configuration& configuration() const {
             return configuration_;
         }
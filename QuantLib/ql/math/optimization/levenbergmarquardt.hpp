@@ -43,6 +43,10 @@ namespace QuantLib {
                                            );
                                            //      = EndCriteria(400, 1.0e-8, 1.0e-8)
         virtual Integer getInfo() const;
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(
+                                              new LevenbergMarquardt(*this));
+        }
         void fcn(int m,
                  int n,
                  double* x,
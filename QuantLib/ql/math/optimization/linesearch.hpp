@@ -27,6 +27,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <memory>
 
 namespace QuantLib {
 
@@ -42,6 +43,13 @@ namespace QuantLib {
         : qt_(0.0), qpt_(0.0), succeed_(true) {}
         //! Destructor
         virtual ~LineSearch() {}
+        //! copy of the line search
+        /*! The default implementation returns a null pointer,
+            meaning that the line search can't be copied.
+        */
+        virtual std::auto_ptr<LineSearch> clone() const {
+            return std::auto_ptr<LineSearch>();
+        }
 
         //! return last x value
         const Array& lastX() { return xtd_; }
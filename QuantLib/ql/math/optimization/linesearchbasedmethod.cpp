@@ -32,6 +32,14 @@ namespace QuantLib {
            lineSearch_ = boost::shared_ptr<LineSearch>(new ArmijoLineSearch);
     }
 
+    LineSearchBasedMethod::LineSearchBasedMethod(
+                                         const LineSearchBasedMethod& other)
+    : OptimizationMethod(other), lineSearch_(other.lineSearch_) {
+        std::auto_ptr<LineSearch> copy = other.lineSearch_->clone();
+        if (copy.get())
+            lineSearch_ = boost::shared_ptr<LineSearch>(copy);
+    }
+
     EndCriteria::Type
     LineSearchBasedMethod::minimize(Problem& P,
                                     const EndCriteria& endCriteria) {
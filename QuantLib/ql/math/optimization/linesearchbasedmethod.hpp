@@ -37,6 +37,8 @@ namespace QuantLib {
       public:
         LineSearchBasedMethod(const boost::shared_ptr<LineSearch>& lSearch =
                                             boost::shared_ptr<LineSearch>());
+        //! the line search is copied as well, if it can be cloned
+        LineSearchBasedMethod(const LineSearchBasedMethod&);
         virtual ~LineSearchBasedMethod() {}
 
         virtual EndCriteria::Type minimize(Problem& P,
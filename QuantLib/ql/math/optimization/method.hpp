@@ -27,6 +27,7 @@
 #define quantlib_optimization_method_h
 
 #include <ql/math/optimization/endcriteria.hpp>
+#include <memory>
 
 namespace QuantLib {
 
@@ -40,6 +41,17 @@ namespace QuantLib {
         //! minimize the optimization problem P
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria) = 0;
+
+        //! copy of the method
+        /*! The copy must not share any state with the original, so
+            that the two can be used independently (e.g., by
+            different threads).  The default implementation returns
+            a null pointer, meaning that the method can't be copied;
+            in that case, clients must share the original instance.
+        */
+        virtual std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>();
+        }
     };
 
 }
@@ -42,6 +42,9 @@ namespace QuantLib {
         Simplex(Real lambda) : lambda_(lambda) {}
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria);
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(new Simplex(*this));
+        }
       private:
         Real extrapolate(Problem& P,
                          Size iHighest,
@@ -39,6 +39,9 @@ namespace QuantLib {
         SteepestDescent(const boost::shared_ptr<LineSearch>& lineSearch =
                                             boost::shared_ptr<LineSearch>())
         : LineSearchBasedMethod(lineSearch) {}
+        std::auto_ptr<OptimizationMethod> clone() const {
+            return std::auto_ptr<OptimizationMethod>(new SteepestDescent(*this));
+        }
       private:
         //! \name LineSearchBasedMethod interface
         //@{
@@ -139,6 +139,13 @@ namespace QuantLib {
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the samples collected by another statistics object
+        /*! The result is the same as if the samples had been added
+            to this object directly, up to rounding errors.  This is
+            used for collecting separately the results of concurrent
+            simulations.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
@@ -244,6 +251,21 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                 const GenericSequenceStatistics& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
@@ -85,12 +85,28 @@ namespace QuantLib {
                       const condition_type& condition) {
             rollbackImpl(a,from,to,steps,&condition);
         }
+        /*! solves the problem between the given times for several
+            arrays at once, applying a condition at every step.  The
+            evolver must be able to step a vector of arrays, and the
+            condition must be applicable to it.
+            \warning being this a rollback, <tt>from</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        template <class MultiCondition>
+        void rollback(std::vector<array_type>& a,
+                      Time from,
+                      Time to,
+                      Size steps,
+                      const MultiCondition& condition) {
+            rollbackImpl(a,from,to,steps,&condition);
+        }
       private:
-        void rollbackImpl(array_type& a,
+        template <class Values, class Condition>
+        void rollbackImpl(Values& a,
                           Time from,
                           Time to,
                           Size steps,
-                          const condition_type* condition) {
+                          const Condition* condition) {
 
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
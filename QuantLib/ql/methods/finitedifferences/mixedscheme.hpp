@@ -26,6 +26,7 @@
 #define quantlib_mixed_scheme_hpp
 
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
+#include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 
 namespace QuantLib {
 
@@ -59,6 +60,15 @@ namespace QuantLib {
         Operator operator+(const Operator&, const Operator&);
         \endcode
 
+        For time-constant operators the implicit part is only
+        rebuilt when the step changes, so that operators caching
+        their factorization (such as TridiagonalOperator) solve each
+        step by substitution only.  When the operator is a
+        TridiagonalOperator, the step also uses its in-place
+        applyTo() and solveFor() overloads to avoid allocating a new
+        array at each step; other operators only need the interface
+        above.
+
         \warning The differential operator must be linear for
                  this evolver to work.
 
@@ -94,12 +104,45 @@ namespace QuantLib {
         }
       protected:
         operator_type L_, I_, explicitPart_, implicitPart_;
+        array_type temp_;
         Time dt_;
         Real theta_;
         bc_set bcs_;
     };
 
 
+    namespace detail {
+
+        // value-returning interface, as required by the concept
+
+        template <class Operator, class array_type>
+        inline void mixedSchemeApply(Operator& L, array_type& a,
+                                     array_type&) {
+            a = L.applyTo(a);
+        }
+
+        template <class Operator, class array_type>
+        inline void mixedSchemeSolve(Operator& L, array_type& a) {
+            a = L.solveFor(a);
+        }
+
+        // in-place interface available to tridiagonal operators
+
+        inline void mixedSchemeApply(TridiagonalOperator& L,
+                                     Array& a, Array& temp) {
+            if (temp.size() != a.size())
+                temp = Array(a.size());
+            L.applyTo(a, temp);
+            a.swap(temp);
+        }
+
+        inline void mixedSchemeSolve(TridiagonalOperator& L, Array& a) {
+            L.solveFor(a, a);
+        }
+
+    }
+
+
     // inline definitions
 
     template <class Operator>
@@ -114,7 +157,7 @@ namespace QuantLib {
             }
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyBeforeApplying(explicitPart_);
-            a = explicitPart_.applyTo(a);
+            detail::mixedSchemeApply(explicitPart_, a, temp_);
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyAfterApplying(a);
         }
@@ -125,7 +168,7 @@ namespace QuantLib {
             }
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyBeforeSolving(implicitPart_,a);
-            implicitPart_.solveFor(a, a);
+            detail::mixedSchemeSolve(implicitPart_, a);
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyAfterSolving(a);
         }
@@ -122,6 +122,44 @@ namespace QuantLib {
         }
     }
 
+    void FdmBlackScholesOp::apply(const Array& r, Array& result) const {
+        mapT_.apply(r, result);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction, const Array& r,
+                                            Array& result) const {
+        if (direction == direction_)
+            mapT_.apply(r, result);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array&, Array& result) const {
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction, const Array& r,
+                                            Real dt, Array& result,
+                                            Array& workspace) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, result, workspace);
+        else
+            std::copy(r.begin(), r.end(), result.begin());
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction,
+                                            const std::vector<Array>& r,
+                                            Real dt,
+                                            std::vector<Array>& result,
+                                            Array& workspace,
+                                            Array& factors) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, result, workspace, factors);
+        else
+            for (Size i=0; i < r.size(); ++i)
+                std::copy(r[i].begin(), r[i].end(), result[i].begin());
+    }
+
     Disposable<Array> FdmBlackScholesOp::preconditioner(const Array& r,
                                                         Real dt) const {
         return solve_splitting(direction_, r, dt);
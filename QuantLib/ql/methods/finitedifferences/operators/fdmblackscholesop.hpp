@@ -55,6 +55,17 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result, Array& workspace) const;
+        void solve_splitting(Size direction,
+                             const std::vector<Array>& r, Real s,
+                             std::vector<Array>& result,
+                             Array& workspace, Array& factors) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
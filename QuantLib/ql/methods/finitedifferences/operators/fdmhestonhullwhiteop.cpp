@@ -55,6 +55,7 @@ namespace QuantLib {
             }
         }
         volatilityValues_ = Sqrt(2*varianceValues_);
+        drift_ = Array(x_.size());
     }
 
     void FdmHestonHullWhiteEquityPart::setTime(Time t1, Time t2) {
@@ -66,7 +67,9 @@ namespace QuantLib {
 
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
-        mapT_.axpyb(x_+phi-varianceValues_-q, dxMap_, dxxMap_, Array());
+        for (Size i=0; i < x_.size(); ++i)
+            drift_[i] = x_[i] + phi - varianceValues_[i] - q;
+        mapT_.axpyb(drift_, dxMap_, dxxMap_, Array());
     }
 
     const TripleBandLinearOp& FdmHestonHullWhiteEquityPart::getMap() const {
@@ -151,6 +154,47 @@ namespace QuantLib {
             QL_FAIL("direction too large");
     }
     
+    void FdmHestonHullWhiteOp::apply(const Array& u, Array& result) const {
+        hullWhiteOp_.apply(u, result);
+        dyMap_.applyAndAdd(u, result);
+        dxMap_.getMap().applyAndAdd(u, result);
+        hestonCorrMap_.applyAndAdd(u, result);
+        equityIrCorrMap_.applyAndAdd(u, result);
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed(const Array& r,
+                                           Array& result) const {
+        hestonCorrMap_.apply(r, result);
+        equityIrCorrMap_.applyAndAdd(r, result);
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction(Size direction,
+                                               const Array& r,
+                                               Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, result);
+        else if (direction == 1)
+            dyMap_.apply(r, result);
+        else if (direction == 2)
+            hullWhiteOp_.apply(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting(Size direction,
+                                               const Array& r, Real a,
+                                               Array& result,
+                                               Array& workspace) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, result, workspace);
+        else if (direction == 1)
+            dyMap_.solve_splitting(r, a, 1.0, result, workspace);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting(2, r, a, result, workspace);
+        else
+            QL_FAIL("direction too large");
+    }
+
     Disposable<Array> FdmHestonHullWhiteOp::preconditioner(const Array& r, 
                                                            Real dt) const {
         return solve_splitting(0, r, dt);
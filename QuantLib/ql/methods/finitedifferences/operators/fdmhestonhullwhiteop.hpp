@@ -50,7 +50,7 @@ namespace QuantLib {
 
       protected:
         const Array x_;
-        Array varianceValues_, volatilityValues_;
+        Array varianceValues_, volatilityValues_, drift_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
@@ -80,6 +80,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result, Array& workspace) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -54,6 +54,7 @@ namespace QuantLib {
             }
         }
         volatilityValues_ = Sqrt(2*varianceValues_);
+        drift_ = Array(varianceValues_.size());
     }
 
     void FdmHestonEquityPart::setTime(Time t1, Time t2) {
@@ -67,7 +68,9 @@ namespace QuantLib {
                 dxMap_, dxxMap_, Array(1, -0.5*r));
         }
         else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
+            for (Size i=0; i < drift_.size(); ++i)
+                drift_[i] = r - q - varianceValues_[i];
+            mapT_.axpyb(drift_, dxMap_, dxxMap_, Array(1, -0.5*r));
         }
     }
 
@@ -156,6 +159,37 @@ namespace QuantLib {
             QL_FAIL("direction too large");
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& result) const {
+        dyMap_.getMap().apply(u, result);
+        dxMap_.getMap().applyAndAdd(u, result);
+        correlationMap_.applyAndAdd(u, result);
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& result) const {
+        correlationMap_.apply(r, result);
+    }
+
+    void FdmHestonOp::apply_direction(Size direction, const Array& r,
+                                      Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, result);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction, const Array& r,
+                                      Real a, Array& result,
+                                      Array& workspace) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, result, workspace);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, result, workspace);
+        else
+            QL_FAIL("direction too large");
+    }
+
     Disposable<Array>
         FdmHestonOp::preconditioner(const Array& r, Real dt) const {
 
@@ -40,7 +40,8 @@ namespace QuantLib {
                     .mult(0.5*model->sigma()*model->sigma()
                           *Array(mesher->layout()->size(), 1.0)))),
       mapT_(direction, mesher),
-      model_(model) {
+      model_(model),
+      shortRates_(x_.size()) {
     }
 
     Size FdmHullWhiteOp::size() const {
@@ -55,7 +56,9 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0)
                               + dynamics->shortRate(t2, 0.0));
 
-        mapT_.axpyb(Array(), dzMap_, dzMap_, -(x_+phi));
+        for (Size i=0; i < x_.size(); ++i)
+            shortRates_[i] = -(x_[i]+phi);
+        mapT_.axpyb(Array(), dzMap_, dzMap_, shortRates_);
     }
 
     Disposable<Array> FdmHullWhiteOp::apply(const Array& r) const {
@@ -89,6 +92,31 @@ namespace QuantLib {
         }
     }
 
+    void FdmHullWhiteOp::apply(const Array& r, Array& result) const {
+        mapT_.apply(r, result);
+    }
+
+    void FdmHullWhiteOp::apply_mixed(const Array&, Array& result) const {
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction(Size direction, const Array& r,
+                                         Array& result) const {
+        if (direction == direction_)
+            mapT_.apply(r, result);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::solve_splitting(Size direction, const Array& r,
+                                         Real a, Array& result,
+                                         Array& workspace) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, a, 1.0, result, workspace);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
     Disposable<Array>
     FdmHullWhiteOp::preconditioner(const Array& r, Real dt) const {
         return solve_splitting(direction_, r, dt);
@@ -52,6 +52,13 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result, Array& workspace) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -61,6 +68,7 @@ namespace QuantLib {
         const TripleBandLinearOp dzMap_;
         TripleBandLinearOp mapT_;
         const boost::shared_ptr<HullWhite> model_;
+        Array shortRates_;
     };
 }
 
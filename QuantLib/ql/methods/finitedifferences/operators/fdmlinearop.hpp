@@ -36,6 +36,15 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        //! applies the operator and stores the result into a given array
+        /*! The result array must have the same size as r and must not
+            alias it.  The default implementation calls apply(r);
+            derived classes should override it in order not to allocate
+            a new array on each call.
+        */
+        virtual void apply(const array_type& r, array_type& result) const {
+            result = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
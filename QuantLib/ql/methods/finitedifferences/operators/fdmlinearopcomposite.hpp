@@ -51,6 +51,44 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place versions
+            These store the result into a given array, which must have
+            the same size as r and must not alias it.  The default
+            implementations call the methods above; derived classes
+            should override them in order not to allocate new arrays.
+            The workspace passed to solve_splitting is used as scratch
+            space; it must have the same size as r and must not alias
+            either r or the result.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& result) const {
+            result = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction,
+                                     const Array& r, Array& result) const {
+            result = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r, Real s,
+                                     Array& result, Array&) const {
+            result = solve_splitting(direction, r, s);
+        }
+        //@}
+
+        //! solves the splitting for several right-hand sides
+        /*! The default implementation solves them one by one;
+            operators that can factorize their splittings should
+            override it and factorize them only once for all the
+            right-hand sides.  The workspace and the factors are
+            scratch arrays with the same size as each right-hand side.
+        */
+        virtual void solve_splitting(Size direction,
+                                     const std::vector<Array>& r, Real s,
+                                     std::vector<Array>& result,
+                                     Array& workspace, Array&) const {
+            for (Size i=0; i < r.size(); ++i)
+                solve_splitting(direction, r[i], s, result[i], workspace);
+        }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
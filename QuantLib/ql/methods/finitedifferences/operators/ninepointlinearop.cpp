@@ -25,6 +25,12 @@
 
 namespace QuantLib {
 
+    namespace {
+        // as in TripleBandLinearOp::apply, small grids don't repay
+        // the cost of starting the threads
+        const long minimumParallelSize = 10000;
+    }
+
     NinePointLinearOp::NinePointLinearOp(
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -130,12 +136,19 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(),
+                   "inconsistent length of result");
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -144,8 +157,9 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        const long size = long(retVal.size());
+        #pragma omp parallel for if(size > minimumParallelSize)
+        for (long i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -156,7 +170,38 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
+    }
+
+    void NinePointLinearOp::applyAndAdd(const Array& u,
+                                        Array& retVal) const {
+
+        const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
+        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
+                    << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(),
+                   "inconsistent length of result");
+
+        // direct access to make the following code faster.
+        const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
+        const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
+        const Real *a20(a20_.get()), *a21(a21_.get()), *a22(a22_.get());
+        const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
+        const Size *i10(i10_.get()),                   *i12(i12_.get());
+        const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
+
+        const long size = long(retVal.size());
+        #pragma omp parallel for if(size > minimumParallelSize)
+        for (long i=0; i < size; ++i) {
+            retVal[i] +=  a00[i]*u[i00[i]]
+                        + a01[i]*u[i01[i]]
+                        + a02[i]*u[i02[i]]
+                        + a10[i]*u[i10[i]]
+                        + a11[i]*u[i]
+                        + a12[i]*u[i12[i]]
+                        + a20[i]*u[i20[i]]
+                        + a21[i]*u[i21[i]]
+                        + a22[i]*u[i22[i]];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
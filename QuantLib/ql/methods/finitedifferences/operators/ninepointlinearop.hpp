@@ -44,6 +44,10 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        //! in-place version; the result must not alias r
+        void apply(const Array& r, Array& result) const;
+        //! adds the operator applied to r to the result
+        void applyAndAdd(const Array& r, Array& result) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
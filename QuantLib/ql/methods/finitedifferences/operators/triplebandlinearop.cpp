@@ -26,6 +26,12 @@
 
 namespace QuantLib {
 
+    namespace {
+        // smaller grids are applied by a single thread, since the
+        // work per point is too small to repay the thread startup
+        const long minimumParallelSize = 10000;
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -210,6 +216,21 @@ namespace QuantLib {
         return retVal;
     }
 
+    Disposable<TripleBandLinearOp>
+    TripleBandLinearOp::multR(const Array& u) const {
+
+        TripleBandLinearOp retVal(direction_, mesher_);
+
+        const Size size = mesher_->layout()->size();
+        for (Size i=0; i < size; ++i) {
+            retVal.lower_[i]= lower_[i]*u[i0_[i]];
+            retVal.diag_[i] = diag_[i]*u[i];
+            retVal.upper_[i]= upper_[i]*u[i2_[i]];
+        }
+
+        return retVal;
+    }
+
     Disposable<TripleBandLinearOp> TripleBandLinearOp::add(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
@@ -226,9 +247,17 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array& r, Array& retVal) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent length of result");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -236,13 +265,32 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
+        const long size = long(index->size());
+        #pragma omp parallel for if(size > minimumParallelSize)
+        for (long i=0; i < size; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
+    }
 
-        return retVal;
+    void TripleBandLinearOp::applyAndAdd(const Array& r,
+                                         Array& retVal) const {
+        const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+
+        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent length of result");
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* i0ptr = i0_.get();
+        const Size* i2ptr = i2_.get();
+
+        const long size = long(index->size());
+        #pragma omp parallel for if(size > minimumParallelSize)
+        for (long i=0; i < size; ++i) {
+            retVal[i] += r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -264,8 +312,21 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size()), workspace(r.size());
+        solve_splitting(r, a, b, retVal, workspace);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal,
+                                             Array& workspace,
+                                             SolverType type) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent size of result");
+        QL_REQUIRE(workspace.size() == r.size(),
+                   "inconsistent size of workspace");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -278,36 +339,207 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        if (type == Automatic)
+            type = (direction_ != 0 && layout->dim()[0] > 1) ?
+                Interleaved : LineByLine;
+
+        if (type == Interleaved)
+            solveInterleaved(r, a, b, retVal, workspace);
+        else
+            solveLineByLine(r, a, b, retVal, workspace);
+    }
+
+    void TripleBandLinearOp::solve_splitting(const std::vector<Array>& r,
+                                             Real a, Real b,
+                                             std::vector<Array>& retVal,
+                                             Array& workspace,
+                                             Array& factors) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent number of results");
+        for (Size c=0; c < r.size(); ++c) {
+            QL_REQUIRE(r[c].size() == n, "inconsistent size of rhs");
+            QL_REQUIRE(retVal[c].size() == n, "inconsistent size of result");
+        }
+        QL_REQUIRE(workspace.size() == n && factors.size() == n,
+                   "inconsistent size of workspace");
+
+        Real* tmp = workspace.begin();
+        Real* piv = factors.begin();
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        const Size m = layout->dim()[direction_];
+        const long nLines = long(n/m);
+        bool singular = false;
+
+        // LU factorization of the tridiagonal systems: tmp holds the
+        // modified upper diagonal and piv the inverse pivots, both in
+        // the order given by the reverse index.
+        #pragma omp parallel for reduction(||:singular) if(nLines > 1)
+        for (long l=0; l < nLines; ++l) {
+            const Size first = l*m, last = first + m - 1;
+
+            Size rim1 = rptr[first];
+            Real bet = a*dptr[rim1]+b;
+            singular = singular || (bet == 0.0);
+            piv[first] = 1.0/bet;
+
+            for (Size j=first+1; j<=last; ++j) {
+                const Size ri = rptr[j];
+                tmp[j] = a*uptr[rim1]*piv[j-1];
+                bet = b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                singular = singular || (bet == 0.0);
+                piv[j] = 1.0/bet;
+                rim1 = ri;
+            }
+        }
+        QL_ENSURE(!singular, "division by zero");
+
+        for (Size c=0; c < r.size(); ++c) {
+            const Real* rhs = r[c].begin();
+            Real* x = retVal[c].begin();
+
+            #pragma omp parallel for if(nLines > 1)
+            for (long l=0; l < nLines; ++l) {
+                const Size first = l*m, last = first + m - 1;
+
+                Size rim1 = rptr[first];
+                x[rim1] = rhs[rim1]*piv[first];
+                for (Size j=first+1; j<=last; ++j) {
+                    const Size ri = rptr[j];
+                    x[ri] = (rhs[ri]-a*lptr[ri]*x[rim1])*piv[j];
+                    rim1 = ri;
+                }
+                for (Size j=last; j>first; --j)
+                    x[rptr[j-1]] -= tmp[j]*x[rptr[j]];
+            }
+        }
+    }
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+    void TripleBandLinearOp::solveLineByLine(const Array& r, Real a, Real b,
+                                             Array& retVal,
+                                             Array& workspace) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+        Real* tmp = workspace.begin();
+        Real* x = retVal.begin();
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // The reverse index enumerates the grid line by line along
+        // the given direction; since the operator has no entries
+        // connecting different lines, each of them is an independent
+        // tridiagonal system and the lines can be solved in parallel.
+        const Size m = layout->dim()[direction_];
+        const Size nLines = layout->size()/m;
+        bool singular = false;
+
+        #pragma omp parallel for reduction(||:singular) if(nLines > 1)
+        for (long l=0; l < long(nLines); ++l) {
+            const Size first = l*m, last = first + m - 1;
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = rptr[first];
+            Real bet = a*dptr[rim1]+b;
+            if (bet == 0.0)
+                singular = true;
+            bet = 1.0/bet;
+            x[rim1] = r[rim1]*bet;
+
+            for (Size j=first+1; j<=last; ++j) {
+                const Size ri = rptr[j];
+                tmp[j] = a*uptr[rim1]*bet;
+
+                bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                if (bet == 0.0)
+                    singular = true;
+                bet=1.0/bet;
+
+                x[ri] = (r[ri]-a*lptr[ri]*x[rim1])*bet;
+                rim1 = ri;
+            }
+            for (Size j=last; j>first; --j)
+                x[rptr[j-1]] -= tmp[j]*x[rptr[j]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(!singular, "division by zero");
+    }
 
-        return retVal;
+    void TripleBandLinearOp::solveInterleaved(const Array& r, Real a, Real b,
+                                              Array& retVal,
+                                              Array& workspace) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const std::vector<Size>& dim = layout->dim();
+        const std::vector<Size>& spacing = layout->spacing();
+
+        QL_REQUIRE(direction_ != 0,
+                   "interleaved solver needs a non-leading direction");
+
+        Real* tmp = workspace.begin();
+        Real* x = retVal.begin();
+        const Real* rptr = r.begin();
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+
+        // Each plane spanned by the leading dimension (the lanes,
+        // which are contiguous in memory) and by the given direction
+        // holds w independent tridiagonal systems of size m, whose
+        // elements are s positions apart.
+        const Size w = dim[0], m = dim[direction_], s = spacing[direction_];
+        const Size nPlanes = layout->size()/(w*m);
+        bool singular = false;
+
+        #pragma omp parallel for reduction(||:singular) if(nPlanes > 1)
+        for (long p=0; p < long(nPlanes); ++p) {
+            // index of the first point of the plane
+            Size base = 0, q = p;
+            for (Size k=1; k < dim.size(); ++k) {
+                if (k != direction_) {
+                    base += (q % dim[k])*spacing[k];
+                    q /= dim[k];
+                }
+            }
+
+            // forward sweep; tmp holds the modified upper diagonal
+            for (Size i=base; i < base+w; ++i) {
+                Real bet = a*dptr[i]+b;
+                singular = singular || (bet == 0.0);
+                bet = 1.0/bet;
+                x[i] = rptr[i]*bet;
+                if (m > 1)
+                    tmp[i+s] = a*uptr[i]*bet;
+            }
+            for (Size j=1; j < m; ++j) {
+                const Size row = base + j*s;
+                const bool last = (j == m-1);
+                for (Size i=row; i < row+w; ++i) {
+                    Real bet = b+a*(dptr[i]-tmp[i]*lptr[i]);
+                    singular = singular || (bet == 0.0);
+                    bet = 1.0/bet;
+                    x[i] = (rptr[i]-a*lptr[i]*x[i-s])*bet;
+                    if (!last)
+                        tmp[i+s] = a*uptr[i]*bet;
+                }
+            }
+
+            // back substitution
+            for (Size j=m-1; j > 0; --j) {
+                const Size row = base + (j-1)*s;
+                for (Size i=row; i < row+w; ++i)
+                    x[i] -= tmp[i+s]*x[i+s];
+            }
+        }
+        QL_ENSURE(!singular, "division by zero");
     }
 }
@@ -35,6 +35,17 @@ namespace QuantLib {
     
     class TripleBandLinearOp : public FdmLinearOp {
       public:
+        //! algorithms for solving the tridiagonal systems of a splitting
+        /*! LineByLine runs the Thomas algorithm on one grid line at
+            a time.  Interleaved processes all the lines of a plane of
+            the grid at once, with the leading (contiguous) dimension
+            of the layout in the innermost loop; this avoids strided
+            memory access and allows the compiler to vectorize the
+            algorithm for directions other than the leading one.
+            Automatic selects the latter whenever the layout allows.
+        */
+        enum SolverType { Automatic, LineByLine, Interleaved };
+
         TripleBandLinearOp(Size direction,
                            const boost::shared_ptr<FdmMesher>& mesher);
 
@@ -47,7 +58,30 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        //! in-place versions; the result must not alias r
+        void apply(const Array& r, Array& result) const;
+        //! adds the operator applied to r to the result
+        void applyAndAdd(const Array& r, Array& result) const;
+        /*! The workspace must have the same size as r and must not
+            alias either r or the result; its contents are
+            overwritten.
+        */
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& result, Array& workspace,
+                             SolverType type = Automatic) const;
+        //! solves the splitting for several right-hand sides
+        /*! The tridiagonal systems are factorized only once and the
+            factorization is used for all the right-hand sides.  The
+            workspace and the factors must have the same size as each
+            right-hand side; their contents are overwritten.
+        */
+        void solve_splitting(const std::vector<Array>& r, Real a, Real b,
+                             std::vector<Array>& result,
+                             Array& workspace, Array& factors) const;
+
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
+        //! multiplication from the right, i.e., the operator applied to u*r
+        Disposable<TripleBandLinearOp> multR(const Array& u) const;
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
 
@@ -64,6 +98,11 @@ namespace QuantLib {
       protected:
         TripleBandLinearOp() {}
 
+        void solveLineByLine(const Array& r, Real a, Real b,
+                             Array& result, Array& workspace) const;
+        void solveInterleaved(const Array& r, Real a, Real b,
+                              Array& result, Array& workspace) const;
+
         Size direction_;
         boost::shared_array<Size> i0_, i2_;
         boost::shared_array<Size> reverseIndex_;
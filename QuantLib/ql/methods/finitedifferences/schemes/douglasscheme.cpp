@@ -33,21 +33,57 @@ namespace QuantLib {
     }
 
     void DouglasScheme::step(array_type& a, Time t) {
+        single_.resize(1);
+        single_.front().swap(a);
+        step(single_, t);
+        a.swap(single_.front());
+    }
+
+    void DouglasScheme::step(std::vector<array_type>& a, Time t) {
+        prepare(t);
+        evolve(a);
+    }
+
+    void DouglasScheme::prepare(Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
+    }
+
+    void DouglasScheme::evolve(std::vector<array_type>& a) {
+        if (a.empty())
+            return;
+
+        const Size m = a.size(), n = a.front().size();
+        if (y_.size() != m || tmp_.size() != n) {
+            y_.assign(m, Array(n));
+            rhs_.assign(m, Array(n));
+            tmp_ = Array(n);
+            factors_ = Array(n);
+        }
+        const Real s = theta_*dt_;
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        for (Size c=0; c < m; ++c) {
+            map_->apply(a[c], tmp_);
+            for (Size k=0; k < n; ++k)
+                y_[c][k] = a[c][k] + dt_*tmp_[k];
+            bcSet_.applyAfterApplying(y_[c]);
+        }
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            for (Size c=0; c < m; ++c) {
+                map_->apply_direction(i, a[c], tmp_);
+                for (Size k=0; k < n; ++k)
+                    rhs_[c][k] = y_[c][k] - s*tmp_[k];
+            }
+            map_->solve_splitting(i, rhs_, -s, y_, tmp_, factors_);
         }
-        bcSet_.applyAfterSolving(y);
 
-        a = y;
+        for (Size c=0; c < m; ++c) {
+            bcSet_.applyAfterSolving(y_[c]);
+            a[c].swap(y_[c]);
+        }
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -29,12 +29,29 @@ namespace QuantLib {
     }
 
     void ExplicitEulerScheme::step(array_type& a, Time t) {
+        prepare(t);
+        evolve(a);
+    }
+
+    void ExplicitEulerScheme::step(std::vector<array_type>& a, Time t) {
+        prepare(t);
+        for (Size i=0; i < a.size(); ++i)
+            evolve(a[i]);
+    }
+
+    void ExplicitEulerScheme::prepare(Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t - dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
+    }
 
+    void ExplicitEulerScheme::evolve(array_type& a) {
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        if (tmp_.size() != a.size())
+            tmp_ = Array(a.size());
+        map_->apply(a, tmp_);
+        for (Size k=0; k < a.size(); ++k)
+            a[k] += dt_*tmp_[k];
         bcSet_.applyAfterApplying(a);
     }
 
@@ -47,12 +47,20 @@ namespace QuantLib {
             const bc_set& bcSet = bc_set());
 
         void step(array_type& a, Time t);
+        //! steps several arrays using the same operator
+        void step(std::vector<array_type>& a, Time t);
         void setStep(Time dt);
 
       protected:
+        void prepare(Time t);
+        void evolve(array_type& a);
+
         Time dt_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace, allocated on the first step
+        Array tmp_;
     };
 }
 
@@ -50,15 +50,28 @@ namespace QuantLib {
             const bc_set& bcSet = bc_set());
 
         void step(array_type& a, Time t);
+        //! steps several arrays using the same operator
+        /*! Operators that support it factorize their splittings
+            only once per step for all the arrays.
+        */
+        void step(std::vector<array_type>& a, Time t);
         void setStep(Time dt);
 
       protected:
+        void prepare(Time t);
+        void evolve(std::vector<array_type>& a);
+
         Time dt_;
         const Real theta_;
         const Real mu_;
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace, allocated on the first step; y_, y0_ and rhs_
+        // hold one array for each of the arrays being stepped
+        std::vector<Array> y_, y0_, rhs_, single_;
+        Array tmp_, factors_;
     };
 }
 
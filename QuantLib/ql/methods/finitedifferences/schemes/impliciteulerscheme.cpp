@@ -20,6 +20,8 @@
 */
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -36,37 +38,120 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType,
+        Integer iluFill)
     : dt_    (Null<Real>()),
       relTol_(relTol),
       map_   (map),
-      bcSet_ (bcSet) {
+      bcSet_ (bcSet),
+      solverType_(solverType),
+      iluFill_(iluFill),
+      iterations_(0),
+      factorizations_(0),
+      iluDt_(Null<Real>()),
+      iluIterations_(Null<Size>()),
+      refactor_(false) {
+#if defined(QL_NO_UBLAS_SUPPORT)
+        QL_REQUIRE(iluFill_ == Null<Integer>(),
+                   "ILU preconditioner requires ublas support");
+#else
+        QL_REQUIRE(iluFill_ == Null<Integer>() || iluFill_ >= 0,
+                   "non-negative ILU fill level required");
+#endif
     }
 
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
         return r - dt_*map_->apply(r);
     }
 
+    Disposable<Array> ImplicitEulerScheme::preconditioner(
+                                                    const Array& r) const {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        if (ilu_)
+            return ilu_->apply(r);
+#endif
+        return map_->preconditioner(r, -dt_);
+    }
+
     void ImplicitEulerScheme::step(array_type& a, Time t) {
+        prepare(t);
+        evolve(a);
+    }
+
+    void ImplicitEulerScheme::step(std::vector<array_type>& a, Time t) {
+        prepare(t);
+        for (Size i=0; i < a.size(); ++i)
+            evolve(a[i]);
+    }
+
+    void ImplicitEulerScheme::prepare(Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        if (iluFill_ != Null<Integer>()
+            && (!ilu_ || dt_ != iluDt_ || refactor_)) {
+            const SparseMatrix a = map_->toMatrix();
+            SparseMatrix m
+                = boost::numeric::ublas::identity_matrix<Real>(a.size1());
+            m -= dt_*a;
+
+            ilu_ = boost::shared_ptr<SparseILUPreconditioner>(
+                new SparseILUPreconditioner(m, iluFill_));
+            iluDt_ = dt_;
+            iluIterations_ = Null<Size>();
+            refactor_ = false;
+            ++factorizations_;
+        }
+#endif
+    }
+
+    void ImplicitEulerScheme::evolve(array_type& a) {
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        const boost::function<Disposable<Array>(const Array&)> applyF(
+            boost::bind(&ImplicitEulerScheme::apply, this, _1));
+        const boost::function<Disposable<Array>(const Array&)> precond(
+            boost::bind(&ImplicitEulerScheme::preconditioner, this, _1));
+
+        Size iterations;
+        if (solverType_ == BiCGstab) {
+            const BiCGStabResult result =
+                QuantLib::BiCGstab(applyF, 10*a.size(), relTol_, precond)
+                    .solve(a);
+            iterations = result.iterations;
+            a = result.x;
+        }
+        else {
+            const GMRESResult result =
+                QuantLib::GMRES(applyF, std::max(Size(10), a.size()/10),
+                                relTol_, precond).solveWithRestart(10, a, a);
+            iterations = result.iterations;
+            a = result.x;
+        }
+        iterations_ += iterations;
+
+        if (ilu_) {
+            if (iluIterations_ == Null<Size>())
+                iluIterations_ = iterations;
+            else if (iterations > 2*iluIterations_+1)
+                refactor_ = true;
+        }
+
         bcSet_.applyAfterSolving(a);
     }
 
     void ImplicitEulerScheme::setStep(Time dt) {
         dt_=dt;
     }
+
+    Size ImplicitEulerScheme::numberOfIterations() const {
+        return iterations_;
+    }
+
+    Size ImplicitEulerScheme::numberOfFactorizations() const {
+        return factorizations_;
+    }
 }
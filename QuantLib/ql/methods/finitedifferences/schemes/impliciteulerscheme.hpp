@@ -32,8 +32,28 @@
 
 namespace QuantLib {
 
+    class SparseILUPreconditioner;
+
+    //! implicit Euler scheme
+    /*! The linear system of each step is solved with a Krylov method,
+        either BiCGstab or GMRES.  By default the solver is
+        preconditioned with the preconditioner of the operator.
+
+        If an ILU fill level is given, the preconditioner is instead an
+        incomplete LU factorization of the matrix of the system, built
+        from the sparse representation of the operator.  A fill level
+        at least equal to the bandwidth of the matrix gives an exact
+        LU factorization.  The factorization is reused as long as the
+        time step doesn't change; for time-dependent operators it is
+        rebuilt when the stale factorization needs more than twice the
+        iterations it needed when it was built.  Since the factorization
+        is only used as a preconditioner, reusing it doesn't change
+        the accuracy of the solution.
+    */
     class ImplicitEulerScheme {
       public:
+        enum SolverType { BiCGstab, GMRES };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,18 +65,39 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab,
+            Integer iluFill = Null<Integer>());
 
         void step(array_type& a, Time t);
+        //! steps several arrays using the same operator
+        void step(std::vector<array_type>& a, Time t);
         void setStep(Time dt);
 
+        //! total number of iterations of the Krylov solver
+        Size numberOfIterations() const;
+        //! number of ILU factorizations built so far
+        Size numberOfFactorizations() const;
+
       protected:
-        Disposable<Array> apply(const Array& r) const;   
-          
+        void prepare(Time t);
+        void evolve(array_type& a);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> preconditioner(const Array& r) const;
+
         Time dt_;
         const Real relTol_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const SolverType solverType_;
+        const Integer iluFill_;
+
+        Size iterations_, factorizations_;
+        boost::shared_ptr<SparseILUPreconditioner> ilu_;
+        Time iluDt_;
+        Size iluIterations_;
+        bool refactor_;
     };
 }
 
@@ -33,33 +33,83 @@ namespace QuantLib {
     }
 
     void ModifiedCraigSneydScheme::step(array_type& a, Time t) {
+        single_.resize(1);
+        single_.front().swap(a);
+        step(single_, t);
+        a.swap(single_.front());
+    }
+
+    void ModifiedCraigSneydScheme::step(std::vector<array_type>& a, Time t) {
+        prepare(t);
+        evolve(a);
+    }
+
+    void ModifiedCraigSneydScheme::prepare(Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
+    }
+
+    void ModifiedCraigSneydScheme::evolve(std::vector<array_type>& a) {
+        if (a.empty())
+            return;
+
+        const Size m = a.size(), n = a.front().size();
+        if (y_.size() != m || tmp_.size() != n) {
+            y_.assign(m, Array(n));
+            y0_.assign(m, Array(n));
+            rhs_.assign(m, Array(n));
+            tmp_ = Array(n);
+            factors_ = Array(n);
+        }
+        const Real s = theta_*dt_;
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        for (Size c=0; c < m; ++c) {
+            map_->apply(a[c], tmp_);
+            for (Size k=0; k < n; ++k)
+                y_[c][k] = a[c][k] + dt_*tmp_[k];
+            bcSet_.applyAfterApplying(y_[c]);
+        }
 
-        Array y0 = y;
+        for (Size c=0; c < m; ++c)
+            std::copy(y_[c].begin(), y_[c].end(), y0_[c].begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            for (Size c=0; c < m; ++c) {
+                map_->apply_direction(i, a[c], tmp_);
+                for (Size k=0; k < n; ++k)
+                    rhs_[c][k] = y_[c][k] - s*tmp_[k];
+            }
+            map_->solve_splitting(i, rhs_, -s, y_, tmp_, factors_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt =  y0 + mu_*dt_*map_->apply_mixed(y-a)
-                  +(0.5-mu_)*dt_*map_->apply(y-a);;
-        bcSet_.applyAfterApplying(yt);
+        for (Size c=0; c < m; ++c) {
+            for (Size k=0; k < n; ++k)
+                rhs_[c][k] = y_[c][k] - a[c][k];
+            map_->apply_mixed(rhs_[c], tmp_);
+            for (Size k=0; k < n; ++k)
+                y0_[c][k] += mu_*dt_*tmp_[k];
+            map_->apply(rhs_[c], tmp_);
+            for (Size k=0; k < n; ++k)
+                y0_[c][k] += (0.5-mu_)*dt_*tmp_[k];
+            bcSet_.applyAfterApplying(y0_[c]);
+        }
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            for (Size c=0; c < m; ++c) {
+                map_->apply_direction(i, a[c], tmp_);
+                for (Size k=0; k < n; ++k)
+                    rhs_[c][k] = y0_[c][k] - s*tmp_[k];
+            }
+            map_->solve_splitting(i, rhs_, -s, y0_, tmp_, factors_);
         }
-        bcSet_.applyAfterSolving(yt);
 
-        a = yt;
+        for (Size c=0; c < m; ++c) {
+            bcSet_.applyAfterSolving(y0_[c]);
+            a[c].swap(y0_[c]);
+        }
     }
 
     void ModifiedCraigSneydScheme::setStep(Time dt) {
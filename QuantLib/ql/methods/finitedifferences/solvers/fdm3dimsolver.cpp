@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalcubicinterpolation.hpp>
 
 
 namespace QuantLib {
@@ -33,10 +34,12 @@ namespace QuantLib {
     Fdm3DimSolver::Fdm3DimSolver(
                         const FdmSolverDesc& solverDesc,
                         const FdmSchemeDesc& schemeDesc,
-                        const boost::shared_ptr<FdmLinearOpComposite>& op)
+                        const boost::shared_ptr<FdmLinearOpComposite>& op,
+                        bool localInterpolation)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      localInterpolation_(localInterpolation),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
                 solverDesc.condition->stoppingTimes().empty()
@@ -45,10 +48,12 @@ namespace QuantLib {
       conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_,
                                                          solverDesc.condition)),
       initialValues_(solverDesc.mesher->layout()->size()),
-      resultValues_ (solverDesc.mesher->layout()->dim()[2],
+      resultValues_ (localInterpolation
+                     ? 0 : solverDesc.mesher->layout()->dim()[2],
                      Matrix(solverDesc.mesher->layout()->dim()[1],
                             solverDesc.mesher->layout()->dim()[0])),
-      interpolation_(solverDesc.mesher->layout()->dim()[2]) {
+      interpolation_(localInterpolation
+                     ? 0 : solverDesc.mesher->layout()->dim()[2]) {
 
         const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -85,6 +90,15 @@ namespace QuantLib {
              .rollback(rhs, solverDesc_.maturity, 0.0,
                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
 
+        if (localInterpolation_) {
+            localInterp_ = boost::shared_ptr<FdmLocalCubicInterpolation>(
+                new FdmLocalCubicInterpolation(solverDesc_.mesher, rhs));
+            thetaInterp_ = boost::shared_ptr<FdmLocalCubicInterpolation>(
+                new FdmLocalCubicInterpolation(solverDesc_.mesher,
+                                               thetaCondition_->getValues()));
+            return;
+        }
+
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
                       rhs.begin()+(i+1)*y_.size()*x_.size(),
@@ -100,6 +114,12 @@ namespace QuantLib {
     Real Fdm3DimSolver::interpolateAt(Real x, Real y, Rate z) const {
         calculate();
 
+        if (localInterpolation_) {
+            std::vector<Real> p(3);
+            p[0] = x; p[1] = y; p[2] = z;
+            return (*localInterp_)(p);
+        }
+
         Array zArray(z_.size());
         for (Size i=0; i < z_.size(); ++i) {
             zArray[i] = interpolation_[i]->operator()(x, y);
@@ -113,7 +133,15 @@ namespace QuantLib {
                    "stopping time at zero-> can't calculate theta");
         calculate();
 
+        if (localInterpolation_) {
+            std::vector<Real> p(3);
+            p[0] = x; p[1] = y; p[2] = z;
+            return ((*thetaInterp_)(p) - (*localInterp_)(p))
+                / thetaCondition_->getTime();
+        }
+
         const Array& rhs = thetaCondition_->getValues();
+
         std::vector<Matrix> thetaValues(z_.size(), Matrix(y_.size(),x_.size()));
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
@@ -131,4 +159,15 @@ namespace QuantLib {
                                             zArray.begin())(z)
                 - interpolateAt(x, y, z)) / thetaCondition_->getTime();
     }
+
+    Real Fdm3DimSolver::derivativeAt(Real x, Real y, Rate z,
+                                     Size direction, Size order) const {
+        QL_REQUIRE(localInterpolation_,
+                   "derivatives require local interpolation");
+        calculate();
+
+        std::vector<Real> p(3);
+        p[0] = x; p[1] = y; p[2] = z;
+        return localInterp_->derivative(p, direction, order);
+    }
 }
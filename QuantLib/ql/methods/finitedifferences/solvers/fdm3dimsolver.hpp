@@ -33,22 +33,36 @@ namespace QuantLib {
 
     class BicubicSpline;
     class FdmSnapshotCondition;
-
+    class FdmLocalCubicInterpolation;
+
+    /*! By default the result is interpolated with a bicubic spline
+        on each z slice followed by a cubic spline along z.  With local
+        interpolation only the 4x4x4 grid points around each query point
+        are used, which avoids building the splines; see
+        FdmLocalCubicInterpolation.  Derivatives come from the local
+        stencil and are only available with local interpolation.
+    */
     class Fdm3DimSolver : public LazyObject {
       public:
         Fdm3DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      bool localInterpolation = false);
 
         void performCalculations() const;
 
         Real interpolateAt(Real x, Real y, Rate z) const;
         Real thetaAt(Real x, Real y, Rate z) const;
+        //! first or second derivative along the given direction
+        /*! \pre the solver uses local interpolation */
+        Real derivativeAt(Real x, Real y, Rate z,
+                          Size direction, Size order = 1) const;
 
       private:
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const bool localInterpolation_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -56,6 +70,8 @@ namespace QuantLib {
         std::vector<Real> x_, y_, z_, initialValues_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
+        mutable boost::shared_ptr<FdmLocalCubicInterpolation> localInterp_;
+        mutable boost::shared_ptr<FdmLocalCubicInterpolation> thetaInterp_;
     };
 }
 
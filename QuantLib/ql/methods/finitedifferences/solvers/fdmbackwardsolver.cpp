@@ -32,10 +32,119 @@
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace QuantLib {
-    
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+
+    namespace {
+
+        // sets the number of OpenMP threads during its lifetime
+        class ThreadCountGuard {
+          public:
+            explicit ThreadCountGuard(Size threads) : previous_(0) {
+                #ifdef _OPENMP
+                previous_ = omp_get_max_threads();
+                if (threads > 0)
+                    omp_set_num_threads(int(threads));
+                #endif
+            }
+            ~ThreadCountGuard() {
+                #ifdef _OPENMP
+                omp_set_num_threads(previous_);
+                #endif
+            }
+          private:
+            int previous_;
+        };
+
+        void copyValues(const Array& from, Array& to) {
+            std::copy(from.begin(), from.end(), to.begin());
+        }
+
+        void copyValues(const std::vector<Array>& from,
+                        std::vector<Array>& to) {
+            for (Size i=0; i < from.size(); ++i)
+                std::copy(from[i].begin(), from[i].end(), to[i].begin());
+        }
+
+        // largest difference between full and half steps, relative
+        // to the values
+        Real stepDifference(const Array& full, const Array& half) {
+            Real error = 0.0;
+            for (Size k=0; k < half.size(); ++k)
+                error = std::max(error, std::fabs(half[k] - full[k])
+                                                / (1.0 + std::fabs(half[k])));
+            return error;
+        }
+
+        Real stepDifference(const std::vector<Array>& full,
+                            const std::vector<Array>& half) {
+            Real error = 0.0;
+            for (Size i=0; i < half.size(); ++i)
+                error = std::max(error, stepDifference(full[i], half[i]));
+            return error;
+        }
+
+        // Richardson extrapolation of the two half steps, given the
+        // ratio of the error of a full step to the difference
+        void extrapolate(const Array& full, Array& half, Real errorScale) {
+            for (Size k=0; k < half.size(); ++k)
+                half[k] += errorScale*(half[k] - full[k]);
+        }
+
+        void extrapolate(const std::vector<Array>& full,
+                         std::vector<Array>& half, Real errorScale) {
+            for (Size i=0; i < half.size(); ++i)
+                extrapolate(full[i], half[i], errorScale);
+        }
+
+        // one full step and two half steps starting from the given values
+        template <class Evolver, class Values>
+        void doubleStep(Evolver& evolver,
+                        const FdmStepConditionComposite& condition,
+                        const Values& a, Values& full, Values& half,
+                        Time t, Time dt) {
+            copyValues(a, full);
+            evolver.setStep(dt);
+            evolver.step(full, t);
+
+            copyValues(a, half);
+            evolver.setStep(0.5*dt);
+            evolver.step(half, t);
+            condition.applyTo(half, t - 0.5*dt);
+            evolver.step(half, t - 0.5*dt);
+        }
+
+    }
+
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Size aThreads, Real aAdaptiveTolerance,
+                                 ImplicitEulerScheme::SolverType aSolverType,
+                                 Integer aIluFill)
+    : type(aType), theta(aTheta), mu(aMu), threads(aThreads),
+      adaptiveTolerance(aAdaptiveTolerance),
+      solverType(aSolverType), iluFill(aIluFill) { }
+
+    FdmSchemeDesc FdmSchemeDesc::withThreads(Size n) const {
+        return FdmSchemeDesc(type, theta, mu, n, adaptiveTolerance,
+                             solverType, iluFill);
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withAdaptiveSteps(Real tolerance) const {
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required (" << tolerance << " given)");
+        return FdmSchemeDesc(type, theta, mu, threads, tolerance,
+                             solverType, iluFill);
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withImplicitSolver(
+                                   ImplicitEulerScheme::SolverType aSolverType,
+                                   Integer aIluFill) const {
+        return FdmSchemeDesc(type, theta, mu, threads, adaptiveTolerance,
+                             aSolverType, aIluFill);
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -68,6 +177,13 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::ImplicitEuler(
+                                   ImplicitEulerScheme::SolverType solverType,
+                                   Integer iluFill) {
+        return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0,
+                             0, Null<Real>(), solverType, iluFill);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -79,12 +195,26 @@ namespace QuantLib {
                                  new FdmStepConditionComposite(
                                      std::list<std::vector<Time> >(),
                                      FdmStepConditionComposite::Conditions()))),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc), stepsTaken_(0), stepsRejected_(0) {
      }
+
+    ImplicitEulerScheme FdmBackwardSolver::implicitScheme() const {
+        return ImplicitEulerScheme(map_, bcSet_, 1e-8,
+                                   schemeDesc_.solverType,
+                                   schemeDesc_.iluFill);
+    }
         
-    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
-                                     Time from, Time to,
-                                     Size steps, Size dampingSteps) {
+    template <class Values>
+    void FdmBackwardSolver::rollbackImpl(Values& rhs,
+                                         Time from, Time to,
+                                         Size steps, Size dampingSteps) {
+
+        if (schemeDesc_.adaptiveTolerance != Null<Real>()) {
+            adaptiveRollbackImpl(rhs, from, to, steps, dampingSteps);
+            return;
+        }
+
+        ThreadCountGuard guard(schemeDesc_.threads);
 
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
@@ -92,12 +222,15 @@ namespace QuantLib {
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            ImplicitEulerScheme implicitEvolver = implicitScheme();
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
             dampingModel.rollback(rhs, from, dampingTo, 
                                   dampingSteps, *condition_);
         }
+
+        stepsTaken_ = allSteps;
+        stepsRejected_ = 0;
         
         switch (schemeDesc_.type) {
           case FdmSchemeDesc::HundsdorferType:
@@ -138,7 +271,7 @@ namespace QuantLib {
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                ImplicitEulerScheme implicitEvolver = implicitScheme();
                 FiniteDifferenceModel<ImplicitEulerScheme> 
                    implicitModel(implicitEvolver, condition_->stoppingTimes());
                 implicitModel.rollback(rhs, from, to, allSteps, *condition_);
@@ -156,4 +289,157 @@ namespace QuantLib {
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    template <class Evolver, class Values>
+    void FdmBackwardSolver::adaptiveRollback(Evolver& evolver, Size order,
+                                             Values& a,
+                                             Time from, Time to,
+                                             Size steps, Size dampingSteps) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(steps > 0, "at least one time step required");
+
+        const Real tolerance = schemeDesc_.adaptiveTolerance;
+        const std::vector<Time>& stoppingTimes = condition_->stoppingTimes();
+
+        const Time minStep = 1e-6*(from - to);
+
+        // the first accepted steps are implicit Euler damping steps
+        ImplicitEulerScheme dampingEvolver = implicitScheme();
+
+        if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+            condition_->applyTo(a, from);
+
+        Values full(a), half(a);
+        Time t = from, h = (from - to)/steps;
+        Size accepted = 0, rejected = 0;
+        while (t > to) {
+            // never step across a stopping time
+            Time target = to;
+            for (Integer j = Integer(stoppingTimes.size())-1; j >= 0; --j) {
+                if (stoppingTimes[j] < t) {
+                    target = std::max(to, stoppingTimes[j]);
+                    break;
+                }
+            }
+            const bool clipped = (t - target <= 1.1*h);
+            const Time dt = clipped ? t - target : h;
+            const Time next = clipped ? target : t - dt;
+
+            const bool damping = (accepted < dampingSteps);
+            if (damping)
+                doubleStep(dampingEvolver, *condition_, a, full, half, t, dt);
+            else
+                doubleStep(evolver, *condition_, a, full, half, t, dt);
+
+            // the error of a full step is about 2^order-1 times the
+            // difference between the full step and two half steps
+            const Size o = damping ? 1 : order;
+            const Real errorScale = 1.0/((1 << o) - 1.0);
+            const Real exponent = 1.0/(o + 1.0);
+
+            const Real error = errorScale*stepDifference(full, half);
+
+            const Real factor = (error > 0.0)
+                ? std::min(2.0, std::max(0.2,
+                                  0.9*std::pow(tolerance/error, exponent)))
+                : 2.0;
+
+            if (error <= tolerance || dt <= minStep) {
+                extrapolate(full, half, errorScale);
+                a.swap(half);
+                condition_->applyTo(a, next);
+                t = next;
+                ++accepted;
+                // a step shortened to hit a stopping time
+                // does not limit the following ones
+                h = clipped ? std::max(h, factor*dt) : factor*dt;
+            } else {
+                h = factor*dt;
+                ++rejected;
+            }
+            h = std::max(h, minStep);
+        }
+
+        stepsTaken_ = accepted;
+        stepsRejected_ = rejected;
+    }
+
+    template <class Values>
+    void FdmBackwardSolver::adaptiveRollbackImpl(Values& rhs,
+                                                 Time from, Time to,
+                                                 Size steps,
+                                                 Size dampingSteps) {
+        ThreadCountGuard guard(schemeDesc_.threads);
+
+        const Size allSteps = steps + dampingSteps;
+
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                            map_, bcSet_);
+                adaptiveRollback(hsEvolver, 2, rhs, from, to,
+                                 allSteps, dampingSteps);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                const Size order = (schemeDesc_.theta == 0.5) ? 2 : 1;
+                adaptiveRollback(dsEvolver, order, rhs, from, to,
+                                 allSteps, dampingSteps);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                           map_, bcSet_);
+                adaptiveRollback(csEvolver, 2, rhs, from, to,
+                                 allSteps, dampingSteps);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta,
+                                                   schemeDesc_.mu,
+                                                   map_, bcSet_);
+                adaptiveRollback(csEvolver, 2, rhs, from, to,
+                                 allSteps, dampingSteps);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme implicitEvolver = implicitScheme();
+                adaptiveRollback(implicitEvolver, 1,
+                                 rhs, from, to, allSteps, 0);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                adaptiveRollback(explicitEvolver, 1,
+                                 rhs, from, to, allSteps, dampingSteps);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+    }
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
+                                     Time from, Time to,
+                                     Size steps, Size dampingSteps) {
+        rollbackImpl(rhs, from, to, steps, dampingSteps);
+    }
+
+    void FdmBackwardSolver::rollback(
+                                 std::vector<FdmBackwardSolver::array_type>& rhs,
+                                 Time from, Time to,
+                                 Size steps, Size dampingSteps) {
+        for (Size i=1; i < rhs.size(); ++i)
+            QL_REQUIRE(rhs[i].size() == rhs[0].size(),
+                       "arrays of different sizes given");
+        rollbackImpl(rhs, from, to, steps, dampingSteps);
+    }
 }
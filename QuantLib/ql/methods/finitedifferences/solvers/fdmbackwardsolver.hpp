@@ -26,6 +26,7 @@
 #define quantlib_fdm_backward_solver_hpp
 
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 
 namespace QuantLib {
 
@@ -37,14 +38,54 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Size threads = 0,
+                      Real adaptiveTolerance = Null<Real>(),
+                      ImplicitEulerScheme::SolverType solverType
+                                             = ImplicitEulerScheme::BiCGstab,
+                      Integer iluFill = Null<Integer>());
 
         const FdmSchemeType type;
         const Real theta, mu;
+        //! number of threads used by the operators; 0 means the default
+        /*! This is only used if QuantLib was compiled with OpenMP
+            support; otherwise, the solvers are single-threaded.
+        */
+        const Size threads;
+        //! local error tolerance for adaptive time stepping
+        /*! If null, the given number of uniform time steps is used.
+            Otherwise, the step size is controlled by step doubling
+            and the given number of time steps only determines the
+            size of the first step.  Accepted steps are improved by
+            Richardson extrapolation of the full and half steps.
+        */
+        const Real adaptiveTolerance;
+        //! Krylov solver used by implicit Euler steps
+        /*! This applies to the implicit Euler scheme as well as to
+            the implicit Euler damping steps of the other schemes.
+        */
+        const ImplicitEulerScheme::SolverType solverType;
+        //! fill level of the ILU preconditioner of implicit Euler steps
+        /*! If null, the preconditioner of the operator is used; see
+            ImplicitEulerScheme for details.
+        */
+        const Integer iluFill;
+
+        //! copy of this description with the given number of threads
+        FdmSchemeDesc withThreads(Size threads) const;
+        //! copy of this description using adaptive time stepping
+        FdmSchemeDesc withAdaptiveSteps(Real tolerance) const;
+        //! copy of this description with the given implicit solver
+        FdmSchemeDesc withImplicitSolver(
+                                   ImplicitEulerScheme::SolverType solverType,
+                                   Integer iluFill = Null<Integer>()) const;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
         static FdmSchemeDesc ImplicitEuler();
+        static FdmSchemeDesc ImplicitEuler(
+                                   ImplicitEulerScheme::SolverType solverType,
+                                   Integer iluFill = Null<Integer>());
         static FdmSchemeDesc ExplicitEuler();
         static FdmSchemeDesc CraigSneyd();
         static FdmSchemeDesc ModifiedCraigSneyd(); 
@@ -66,11 +107,53 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        //! rolls back several arrays at once
+        /*! The arrays, e.g., the values of a strip of options, are
+            stepped with the same operator; this saves the operator
+            update at each time step.  If the step condition was
+            built by FdmStepConditionComposite::columnComposite(),
+            each array is subject to its own conditions.  In adaptive
+            mode, all arrays take the same steps, whose size is
+            controlled by the largest error among them.
+        */
+        void rollback(std::vector<array_type>& a,
+                      Time from, Time to,
+                      Size steps, Size dampingSteps);
+
+        //! number of time steps taken by the last rollback
+        /*! This includes the damping steps; in adaptive mode, only
+            accepted steps are counted.  The damping steps are then
+            the first accepted ones, and their size is controlled
+            like that of the other steps.
+        */
+        Size stepsTaken() const { return stepsTaken_; }
+        //! number of rejected steps in the last rollback
+        /*! This is always zero unless adaptive time stepping is used.
+            Each accepted or rejected adaptive step costs one full
+            and two half steps of the scheme.
+        */
+        Size stepsRejected() const { return stepsRejected_; }
+
       protected:
+        template <class Values>
+        void rollbackImpl(Values& a,
+                          Time from, Time to,
+                          Size steps, Size dampingSteps);
+        template <class Values>
+        void adaptiveRollbackImpl(Values& a,
+                                  Time from, Time to,
+                                  Size steps, Size dampingSteps);
+        ImplicitEulerScheme implicitScheme() const;
+        template <class Evolver, class Values>
+        void adaptiveRollback(Evolver& evolver, Size order, Values& a,
+                              Time from, Time to,
+                              Size steps, Size dampingSteps);
+
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const boost::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+        Size stepsTaken_, stepsRejected_;
     };
 }
 
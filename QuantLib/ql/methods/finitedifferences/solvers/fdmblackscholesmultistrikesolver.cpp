@@ -0,0 +1,174 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/comparison.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholesmultistrikesolver.hpp>
+
+namespace QuantLib {
+
+    FdmBlackScholesMultiStrikeSolver::FdmBlackScholesMultiStrikeSolver(
+        const Handle<GeneralizedBlackScholesProcess>& process,
+        Real strike,
+        const std::vector<FdmSolverDesc>& solverDescs,
+        const FdmSchemeDesc& schemeDesc,
+        bool localVol,
+        Real illegalLocalVolOverwrite)
+    : process_(process),
+      strike_(strike),
+      solverDescs_(solverDescs),
+      schemeDesc_(schemeDesc),
+      localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+
+        QL_REQUIRE(!solverDescs_.empty(), "no solver descriptions given");
+        const FdmSolverDesc& desc = solverDescs_.front();
+        for (Size i=1; i < solverDescs_.size(); ++i) {
+            QL_REQUIRE(   solverDescs_[i].mesher == desc.mesher
+                       && solverDescs_[i].bcSet == desc.bcSet
+                       && solverDescs_[i].maturity == desc.maturity
+                       && solverDescs_[i].timeSteps == desc.timeSteps
+                       && solverDescs_[i].dampingSteps == desc.dampingSteps,
+                       "solver description " << i << " does not share "
+                       "mesher, boundary conditions or time grid with "
+                       "the first one");
+        }
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout
+                                                    = desc.mesher->layout();
+        QL_REQUIRE(layout->dim().size() == 1,
+                   "one-dimensional mesher expected");
+
+        x_.resize(layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            x_[iter.index()] = desc.mesher->location(iter, 0);
+        }
+
+        std::vector<boost::shared_ptr<FdmStepConditionComposite> > columns;
+        for (Size i=0; i < solverDescs_.size(); ++i) {
+            const boost::shared_ptr<FdmStepConditionComposite>& condition
+                = solverDescs_[i].condition;
+            thetaConditions_.push_back(
+                boost::shared_ptr<FdmSnapshotCondition>(
+                    new FdmSnapshotCondition(
+                        0.99*std::min(1.0/365.0,
+                                      condition->stoppingTimes().empty()
+                                      ? desc.maturity
+                                      : condition->stoppingTimes().front()))));
+            columns.push_back(FdmStepConditionComposite::joinConditions(
+                                          thetaConditions_.back(), condition));
+        }
+        conditions_ = FdmStepConditionComposite::columnComposite(columns);
+
+        registerWith(process_);
+    }
+
+    bool FdmBlackScholesMultiStrikeSolver::isStrikeIndependent(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Time maturity, const std::vector<Real>& strikes,
+            bool localVol) {
+        if (localVol || strikes.empty())
+            return true;
+
+        const Real variance =
+            process->blackVolatility()->blackVariance(maturity,
+                                                      strikes.front(), true);
+        for (Size i=1; i < strikes.size(); ++i) {
+            if (!close_enough(variance,
+                              process->blackVolatility()->blackVariance(
+                                              maturity, strikes[i], true)))
+                return false;
+        }
+        return true;
+    }
+
+    void FdmBlackScholesMultiStrikeSolver::performCalculations() const {
+        const FdmSolverDesc& desc = solverDescs_.front();
+        const boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+        resultValues_.resize(solverDescs_.size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (Size i=0; i < solverDescs_.size(); ++i) {
+            resultValues_[i] = Array(layout->size());
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter != endIter; ++iter) {
+                resultValues_[i][iter.index()] =
+                    solverDescs_[i].calculator->avgInnerValue(iter,
+                                                              desc.maturity);
+            }
+        }
+
+        const boost::shared_ptr<FdmBlackScholesOp> op(new FdmBlackScholesOp(
+                mesher, process_.currentLink(), strike_,
+                localVol_, illegalLocalVolOverwrite_));
+
+        FdmBackwardSolver(op, desc.bcSet, conditions_, schemeDesc_)
+            .rollback(resultValues_, desc.maturity, 0.0,
+                      desc.timeSteps, desc.dampingSteps);
+
+        interpolations_.resize(solverDescs_.size());
+        for (Size i=0; i < solverDescs_.size(); ++i) {
+            interpolations_[i] = boost::shared_ptr<CubicInterpolation>(new
+                MonotonicCubicNaturalSpline(x_.begin(), x_.end(),
+                                            resultValues_[i].begin()));
+        }
+    }
+
+    Real FdmBlackScholesMultiStrikeSolver::valueAt(Size i, Real s) const {
+        QL_REQUIRE(i < size(), "index (" << i << ") out of range");
+        calculate();
+        return interpolations_[i]->operator()(std::log(s));
+    }
+
+    Real FdmBlackScholesMultiStrikeSolver::deltaAt(Size i, Real s) const {
+        QL_REQUIRE(i < size(), "index (" << i << ") out of range");
+        calculate();
+        return interpolations_[i]->derivative(std::log(s))/s;
+    }
+
+    Real FdmBlackScholesMultiStrikeSolver::gammaAt(Size i, Real s) const {
+        QL_REQUIRE(i < size(), "index (" << i << ") out of range");
+        calculate();
+        const Real x = std::log(s);
+        return (interpolations_[i]->secondDerivative(x)
+                - interpolations_[i]->derivative(x))/(s*s);
+    }
+
+    Real FdmBlackScholesMultiStrikeSolver::thetaAt(Size i, Real s) const {
+        QL_REQUIRE(i < size(), "index (" << i << ") out of range");
+        QL_REQUIRE(thetaConditions_[i]->getTime() > 0.0,
+                   "stopping time at zero-> can't calculate theta");
+        calculate();
+
+        const Array& thetaValues = thetaConditions_[i]->getValues();
+        const Real x = std::log(s);
+        const Real temp = MonotonicCubicNaturalSpline(
+            x_.begin(), x_.end(), thetaValues.begin())(x);
+        return (temp - interpolations_[i]->operator()(x))
+                / thetaConditions_[i]->getTime();
+    }
+}
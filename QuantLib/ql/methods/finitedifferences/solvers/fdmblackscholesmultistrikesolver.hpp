@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholesmultistrikesolver.hpp
+    \brief Black-Scholes solver for several payoffs on the same mesh
+*/
+
+#ifndef quantlib_fdm_black_scholes_multi_strike_solver_hpp
+#define quantlib_fdm_black_scholes_multi_strike_solver_hpp
+
+#include <ql/handle.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class CubicInterpolation;
+    class FdmSnapshotCondition;
+    class GeneralizedBlackScholesProcess;
+
+    //! Black-Scholes solver for a strip of payoffs
+    /*! All payoffs are rolled back together, one array per payoff,
+        with a single Black-Scholes operator.  The solver descriptions
+        must share the mesher, the boundary conditions, the maturity
+        and the number of time steps; the inner-value calculators and
+        the step conditions can differ.
+
+        \pre unless local volatility is used, the Black volatility
+             must not depend on the strike, since the operator uses
+             the volatility at the given strike for all payoffs; this
+             can be checked with isStrikeIndependent().
+    */
+    class FdmBlackScholesMultiStrikeSolver : public LazyObject {
+      public:
+        FdmBlackScholesMultiStrikeSolver(
+            const Handle<GeneralizedBlackScholesProcess>& process,
+            Real strike,
+            const std::vector<FdmSolverDesc>& solverDescs,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>());
+
+        Size size() const { return solverDescs_.size(); }
+
+        //! whether a strip of the given strikes can share one operator
+        /*! This is the case with local volatility, or when the Black
+            variance at maturity is the same for all the strikes.
+        */
+        static bool isStrikeIndependent(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Time maturity, const std::vector<Real>& strikes,
+            bool localVol);
+
+        Real valueAt(Size i, Real s) const;
+        Real deltaAt(Size i, Real s) const;
+        Real gammaAt(Size i, Real s) const;
+        Real thetaAt(Size i, Real s) const;
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        Handle<GeneralizedBlackScholesProcess> process_;
+        const Real strike_;
+        const std::vector<FdmSolverDesc> solverDescs_;
+        const FdmSchemeDesc schemeDesc_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+
+        std::vector<Real> x_;
+        std::vector<boost::shared_ptr<FdmSnapshotCondition> >
+                                                           thetaConditions_;
+        boost::shared_ptr<FdmStepConditionComposite> conditions_;
+        mutable std::vector<Array> resultValues_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                            interpolations_;
+    };
+}
+
+#endif
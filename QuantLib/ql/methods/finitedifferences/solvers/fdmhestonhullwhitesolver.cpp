@@ -29,12 +29,14 @@ namespace QuantLib {
         const Handle<HullWhiteProcess>& hwProcess,
         Rate corrEquityShortRate,
         const FdmSolverDesc& solverDesc,
-        const FdmSchemeDesc& schemeDesc)
+        const FdmSchemeDesc& schemeDesc,
+        bool localInterpolation)
     : hestonProcess_(hestonProcess),
       hwProcess_(hwProcess),
       corrEquityShortRate_(corrEquityShortRate),
       solverDesc_(solverDesc),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      localInterpolation_(localInterpolation) {
 
         registerWith(hestonProcess);
         registerWith(hwProcess);
@@ -48,7 +50,8 @@ namespace QuantLib {
                                      corrEquityShortRate_));
 
         solver_ = boost::shared_ptr<Fdm3DimSolver>(
-                                new Fdm3DimSolver(solverDesc_, schemeDesc_, op));
+            new Fdm3DimSolver(solverDesc_, schemeDesc_, op,
+                              localInterpolation_));
     }
 
     Real FdmHestonHullWhiteSolver::valueAt(Real s, Real v, Rate r) const {
@@ -60,11 +63,21 @@ namespace QuantLib {
 
     Real FdmHestonHullWhiteSolver::deltaAt(Real s, Real v, Rate r, Real eps) 
     const {
+        if (localInterpolation_) {
+            calculate();
+            return solver_->derivativeAt(std::log(s), v, r, 0)/s;
+        }
         return (valueAt(s+eps, v, r) - valueAt(s-eps, v, r))/(2*eps);
     }
 
     Real FdmHestonHullWhiteSolver::gammaAt(Real s, Real v, Rate r, Real eps) 
     const {
+        if (localInterpolation_) {
+            calculate();
+            const Real x = std::log(s);
+            return (solver_->derivativeAt(x, v, r, 0, 2)
+                    - solver_->derivativeAt(x, v, r, 0))/(s*s);
+        }
         return (valueAt(s+eps, v, r)+valueAt(s-eps, v,r )
                 -2*valueAt(s, v, r))/(eps*eps);
     }
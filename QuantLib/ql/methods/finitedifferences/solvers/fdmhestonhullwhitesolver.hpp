@@ -43,7 +43,8 @@ namespace QuantLib {
             const Handle<HullWhiteProcess>& hwProcess,
             Rate corrEquityShortRate,
             const FdmSolverDesc& solverDesc,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            bool localInterpolation = false);
 
         Real valueAt(Real s, Real v, Rate r) const;
         Real thetaAt(Real s, Real v, Rate r) const;
@@ -53,6 +54,8 @@ namespace QuantLib {
         // E.g. see Fabio Mercurio, Massimo Morini 
         // "A Note on Hedging with Local and Stochastic Volatility Models",
         // http://papers.ssrn.com/sol3/papers.cfm?abstract_id=1294284  
+        // With local interpolation the derivatives are taken from the
+        // local stencil around s and eps is not used.
         Real deltaAt(Real s, Real v, Rate r, Real eps) const;
         Real gammaAt(Real s, Real v, Rate r, Real eps) const;
         
@@ -66,6 +69,7 @@ namespace QuantLib {
         
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
+        const bool localInterpolation_;
 
         mutable boost::shared_ptr<Fdm3DimSolver> solver_;
     };
@@ -32,23 +32,36 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalcubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
 #include <numeric>
 
 namespace QuantLib {
 
+    /*! By default the result is interpolated with a multi-cubic
+        spline over the whole grid.  With local interpolation only the
+        4^N grid points around each query point are used, which avoids
+        building the spline; see FdmLocalCubicInterpolation.
+        Derivatives come from the local stencil and are only
+        available with local interpolation.
+    */
     template <Size N>
     class FdmNdimSolver : public LazyObject {
       public:
         FdmNdimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      bool localInterpolation = false);
 
         void performCalculations() const;
 
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
+        //! first or second derivative along the given direction
+        /*! \pre the solver uses local interpolation */
+        Real derivativeAt(const std::vector<Real>& x,
+                          Size direction, Size order = 1) const;
 
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
@@ -59,6 +72,7 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const bool localInterpolation_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -69,6 +83,8 @@ namespace QuantLib {
 
         mutable boost::shared_ptr<data_table> f_;
         mutable boost::shared_ptr<MultiCubicSpline<N> > interp_;
+        mutable boost::shared_ptr<FdmLocalCubicInterpolation> localInterp_;
+        mutable boost::shared_ptr<FdmLocalCubicInterpolation> thetaInterp_;
     };
 
 
@@ -76,10 +92,12 @@ namespace QuantLib {
     FdmNdimSolver<N>::FdmNdimSolver(
                         const FdmSolverDesc& solverDesc,
                         const FdmSchemeDesc& schemeDesc,
-                        const boost::shared_ptr<FdmLinearOpComposite>& op)
+                        const boost::shared_ptr<FdmLinearOpComposite>& op,
+                        bool localInterpolation)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      localInterpolation_(localInterpolation),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
                 solverDesc.condition->stoppingTimes().empty()
@@ -116,7 +134,8 @@ namespace QuantLib {
             }
         }
 
-        f_ = boost::shared_ptr<data_table>(new data_table(x_));
+        if (!localInterpolation_)
+            f_ = boost::shared_ptr<data_table>(new data_table(x_));
     }
 
 
@@ -129,6 +148,15 @@ namespace QuantLib {
                  .rollback(rhs, solverDesc_.maturity, 0.0,
                            solverDesc_.timeSteps, solverDesc_.dampingSteps);
 
+        if (localInterpolation_) {
+            localInterp_ = boost::shared_ptr<FdmLocalCubicInterpolation>(
+                new FdmLocalCubicInterpolation(solverDesc_.mesher, rhs));
+            thetaInterp_ = boost::shared_ptr<FdmLocalCubicInterpolation>(
+                new FdmLocalCubicInterpolation(solverDesc_.mesher,
+                                               thetaCondition_->getValues()));
+            return;
+        }
+
         const boost::shared_ptr<FdmLinearOpLayout> layout
                                                = solverDesc_.mesher->layout();
 
@@ -148,7 +176,13 @@ namespace QuantLib {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
         calculate();
+
+        if (localInterpolation_)
+            return ((*thetaInterp_)(x) - (*localInterp_)(x))
+                / thetaCondition_->getTime();
+
         const Array& rhs = thetaCondition_->getValues();
+
         const boost::shared_ptr<FdmLinearOpLayout> layout
                                             = solverDesc_.mesher->layout();
 
@@ -168,7 +202,17 @@ namespace QuantLib {
     Real FdmNdimSolver<N>::interpolateAt(const std::vector<Real>& x) const {
         calculate();
 
-        return (*interp_)(x);
+        return localInterpolation_ ? (*localInterp_)(x) : (*interp_)(x);
+    }
+
+    template <Size N> inline
+    Real FdmNdimSolver<N>::derivativeAt(const std::vector<Real>& x,
+                                        Size direction, Size order) const {
+        QL_REQUIRE(localInterpolation_,
+                   "derivatives require local interpolation");
+        calculate();
+
+        return localInterp_->derivative(x, direction, order);
     }
 
     template <Size N> inline
@@ -58,11 +58,48 @@ namespace QuantLib {
     }
 
     void FdmStepConditionComposite::applyTo(Array& a, Time t) const {
+        QL_REQUIRE(columns_.empty(),
+                   "column composite can only be applied to "
+                   "a vector of arrays");
         for (Conditions::const_iterator iter = conditions_.begin();
              iter != conditions_.end(); ++iter) {
             (*iter)->applyTo(a, t);
         }
     }
+
+    void FdmStepConditionComposite::applyTo(std::vector<Array>& a,
+                                            Time t) const {
+        if (columns_.empty()) {
+            for (Size i=0; i < a.size(); ++i)
+                applyTo(a[i], t);
+        }
+        else {
+            QL_REQUIRE(a.size() == columns_.size(),
+                       "number of arrays (" << a.size() << ") does not "
+                       "match number of column conditions ("
+                       << columns_.size() << ")");
+            for (Size i=0; i < a.size(); ++i)
+                columns_[i]->applyTo(a[i], t);
+        }
+    }
+
+    boost::shared_ptr<FdmStepConditionComposite>
+    FdmStepConditionComposite::columnComposite(
+        const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                    columns) {
+
+        std::list<std::vector<Time> > stoppingTimes;
+        for (Size i=0; i < columns.size(); ++i) {
+            QL_REQUIRE(columns[i], "null condition given for column " << i);
+            stoppingTimes.push_back(columns[i]->stoppingTimes());
+        }
+
+        boost::shared_ptr<FdmStepConditionComposite> composite(
+            new FdmStepConditionComposite(stoppingTimes, Conditions()));
+        composite->columns_ = columns;
+
+        return composite;
+    }
     
     boost::shared_ptr<FdmStepConditionComposite> 
     FdmStepConditionComposite::joinConditions(
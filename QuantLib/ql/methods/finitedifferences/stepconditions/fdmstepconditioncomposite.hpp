@@ -49,6 +49,11 @@ namespace QuantLib {
             const Conditions & conditions);
 
         void applyTo(Array& a, Time t) const;
+        //! applies the conditions to each of the given arrays
+        /*! If the composite was built by columnComposite(), the
+            i-th array is passed to the i-th column composite.
+        */
+        void applyTo(std::vector<Array>& a, Time t) const;
         const std::vector<Time>& stoppingTimes() const;
         const Conditions& conditions() const;
 
@@ -63,10 +68,20 @@ namespace QuantLib {
              const boost::shared_ptr<FdmInnerValueCalculator>& calculator,
              const Date& refDate,
              const DayCounter& dayCounter);
+
+        //! composite applying different conditions to each array
+        /*! This is used for rolling back several payoffs at once;
+            the stopping times are the union of those of the given
+            composites.
+        */
+        static boost::shared_ptr<FdmStepConditionComposite> columnComposite(
+            const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                     columns);
         
     private:
         std::vector<Time> stoppingTimes_;
         const Conditions conditions_;
+        std::vector<boost::shared_ptr<FdmStepConditionComposite> > columns_;
     };
 }
 #endif
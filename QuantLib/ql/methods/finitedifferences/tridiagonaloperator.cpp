@@ -22,19 +22,22 @@
 
 namespace QuantLib {
 
-    TridiagonalOperator::TridiagonalOperator(Size size) {
+    TridiagonalOperator::TridiagonalOperator(Size size)
+    : factorized_(false) {
         if (size>=2) {
             n_ = size;
             diagonal_      = Array(size);
             lowerDiagonal_ = Array(size-1);
             upperDiagonal_ = Array(size-1);
             temp_          = Array(size);
+            pivots_        = Array(size);
         } else if (size==0) {
             n_ = 0;
             diagonal_      = Array(0);
             lowerDiagonal_ = Array(0);
             upperDiagonal_ = Array(0);
             temp_          = Array(0);
+            pivots_        = Array(0);
         } else {
             QL_FAIL("invalid size (" << size << ") for tridiagonal operator "
                     "(must be null or >= 2)");
@@ -45,7 +48,8 @@ namespace QuantLib {
                                              const Array& mid,
                                              const Array& high)
     : n_(mid.size()),
-      diagonal_(mid), lowerDiagonal_(low), upperDiagonal_(high), temp_(n_) {
+      diagonal_(mid), lowerDiagonal_(low), upperDiagonal_(high),
+      temp_(n_), pivots_(n_), factorized_(false) {
         QL_REQUIRE(low.size() == n_-1,
                    "low diagonal vector of size " << low.size() <<
                    " instead of " << n_-1);
@@ -55,17 +59,29 @@ namespace QuantLib {
     }
 
     TridiagonalOperator::TridiagonalOperator(
-                                const Disposable<TridiagonalOperator>& from) {
+                                const Disposable<TridiagonalOperator>& from)
+    : n_(0), factorized_(false) {
         swap(const_cast<Disposable<TridiagonalOperator>&>(from));
     }
 
     Disposable<Array> TridiagonalOperator::applyTo(const Array& v) const {
+        Array result(n_);
+        applyTo(v, result);
+        return result;
+    }
+
+    void TridiagonalOperator::applyTo(const Array& v,
+                                      Array& result) const {
         QL_REQUIRE(n_!=0,
                    "uninitialized TridiagonalOperator");
         QL_REQUIRE(v.size()==n_,
                    "vector of the wrong size " << v.size() <<
                    " instead of " << n_);
-        Array result(n_);
+        QL_REQUIRE(result.size()==n_,
+                   "result vector of size " << result.size() <<
+                   " instead of " << n_);
+        QL_REQUIRE(&v != &result,
+                   "result cannot be the input vector");
         std::transform(diagonal_.begin(), diagonal_.end(),
                        v.begin(),
                        result.begin(),
@@ -77,8 +93,6 @@ namespace QuantLib {
             result[j] += lowerDiagonal_[j-1]*v[j-1]+
                 upperDiagonal_[j]*v[j+1];
         result[n_-1] += lowerDiagonal_[n_-2]*v[n_-2];
-
-        return result;
     }
 
     Disposable<Array> TridiagonalOperator::solveFor(const Array& rhs) const  {
@@ -97,21 +111,31 @@ namespace QuantLib {
                    "rhs vector of size " << rhs.size() <<
                    " instead of " << n_);
 
+        if (!factorized_)
+            factorize();
+
+        result[0] = rhs[0]/pivots_[0];
+        for (Size j=1; j<=n_-1; ++j)
+            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])/pivots_[j];
+        // cannot be j>=0 with Size j
+        for (Size j=n_-2; j>0; --j)
+            result[j] -= temp_[j+1]*result[j+1];
+        result[0] -= temp_[1]*result[1];
+    }
+
+    void TridiagonalOperator::factorize() const {
         Real bet = diagonal_[0];
         QL_REQUIRE(!close(bet, 0.0),
                    "diagonal's first element (" << bet <<
                    ") cannot be close to zero");
-        result[0] = rhs[0]/bet;
+        pivots_[0] = bet;
         for (Size j=1; j<=n_-1; ++j) {
             temp_[j] = upperDiagonal_[j-1]/bet;
             bet = diagonal_[j]-lowerDiagonal_[j-1]*temp_[j];
             QL_ENSURE(!close(bet, 0.0), "division by zero");
-            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])/bet;
+            pivots_[j] = bet;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=n_-2; j>0; --j)
-            result[j] -= temp_[j+1]*result[j+1];
-        result[0] -= temp_[1]*result[1];
+        factorized_ = true;
     }
 
     Disposable<Array> TridiagonalOperator::SOR(const Array& rhs,
@@ -33,7 +33,12 @@
 namespace QuantLib {
 
     //! Base implementation for tridiagonal operator
-    /*! \warning to use real time-dependant algebra, you must overload
+    /*! The LU decomposition used by solveFor() is cached and reused
+        until the operator is modified, so that repeated solves with
+        a time-constant operator only perform the forward and back
+        substitutions.
+
+        \warning to use real time-dependant algebra, you must overload
                  the corresponding operators in the inheriting
                  time-dependent class.
 
@@ -74,6 +79,12 @@ namespace QuantLib {
         //@{
         //! apply operator to a given array
         Disposable<Array> applyTo(const Array& v) const;
+        /*! apply operator to a given array without result Array
+            allocation. The v and result parameters cannot be the
+            same Array.
+        */
+        void applyTo(const Array& v,
+                     Array& result) const;
         //! solve linear system for a given right-hand side
         Disposable<Array> solveFor(const Array& rhs) const;
         /*! solve linear system for a given right-hand side
@@ -116,9 +127,11 @@ namespace QuantLib {
                                  TridiagonalOperator& L) const = 0;
         };
       protected:
+        void factorize() const;
         Size n_;
         Array diagonal_, lowerDiagonal_, upperDiagonal_;
-        mutable Array temp_;
+        mutable Array temp_, pivots_;
+        mutable bool factorized_;
         boost::shared_ptr<TimeSetter> timeSetter_;
     };
 
@@ -136,8 +149,12 @@ namespace QuantLib {
 
     inline void TridiagonalOperator::setFirstRow(Real valB,
                                                  Real valC) {
-        diagonal_[0]      = valB;
-        upperDiagonal_[0] = valC;
+        // boundary conditions reset the same values at each step
+        if (diagonal_[0] != valB || upperDiagonal_[0] != valC) {
+            diagonal_[0]      = valB;
+            upperDiagonal_[0] = valC;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setMidRow(Size i,
@@ -149,6 +166,7 @@ namespace QuantLib {
         lowerDiagonal_[i-1] = valA;
         diagonal_[i]        = valB;
         upperDiagonal_[i]   = valC;
+        factorized_ = false;
     }
 
     inline void TridiagonalOperator::setMidRows(Real valA,
@@ -159,17 +177,23 @@ namespace QuantLib {
             diagonal_[i]        = valB;
             upperDiagonal_[i]   = valC;
         }
+        factorized_ = false;
     }
 
     inline void TridiagonalOperator::setLastRow(Real valA,
                                                 Real valB) {
-        lowerDiagonal_[n_-2] = valA;
-        diagonal_[n_-1]      = valB;
+        if (lowerDiagonal_[n_-2] != valA || diagonal_[n_-1] != valB) {
+            lowerDiagonal_[n_-2] = valA;
+            diagonal_[n_-1]      = valB;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setTime(Time t) {
-        if (timeSetter_)
+        if (timeSetter_) {
             timeSetter_->setTime(t, *this);
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::swap(TridiagonalOperator& from) {
@@ -179,6 +203,8 @@ namespace QuantLib {
         lowerDiagonal_.swap(from.lowerDiagonal_);
         upperDiagonal_.swap(from.upperDiagonal_);
         temp_.swap(from.temp_);
+        pivots_.swap(from.pivots_);
+        swap(factorized_, from.factorized_);
         swap(timeSetter_, from.timeSetter_);
     }
 
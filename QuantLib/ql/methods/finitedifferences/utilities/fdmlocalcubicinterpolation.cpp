@@ -0,0 +1,194 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmlocalcubicinterpolation.cpp
+    \brief local tensor-product cubic interpolation on a mesher
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalcubicinterpolation.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* derivative of the given order (up to two) at x of the k-th
+           Lagrange basis polynomial on the m nodes xs */
+        Real lagrangeBasis(const Real* xs, Size m, Size k,
+                           Real x, Size order) {
+            Real denominator = 1.0;
+            for (Size j=0; j < m; ++j)
+                if (j != k)
+                    denominator *= xs[k] - xs[j];
+
+            Real numerator = 0.0;
+            if (order == 0) {
+                numerator = 1.0;
+                for (Size j=0; j < m; ++j)
+                    if (j != k)
+                        numerator *= x - xs[j];
+            }
+            else if (order == 1) {
+                for (Size l=0; l < m; ++l) {
+                    if (l == k) continue;
+                    Real p = 1.0;
+                    for (Size j=0; j < m; ++j)
+                        if (j != k && j != l)
+                            p *= x - xs[j];
+                    numerator += p;
+                }
+            }
+            else {
+                for (Size l=0; l < m; ++l) {
+                    if (l == k) continue;
+                    for (Size q=0; q < m; ++q) {
+                        if (q == k || q == l) continue;
+                        Real p = 1.0;
+                        for (Size j=0; j < m; ++j)
+                            if (j != k && j != l && j != q)
+                                p *= x - xs[j];
+                        numerator += p;
+                    }
+                }
+            }
+            return numerator/denominator;
+        }
+
+    }
+
+    FdmLocalCubicInterpolation::FdmLocalCubicInterpolation(
+                                 const boost::shared_ptr<FdmMesher>& mesher,
+                                 const Array& values)
+    : values_(values) {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        QL_REQUIRE(values.size() == layout->size(),
+                   "size of the values (" << values.size()
+                   << ") does not fit to the layout (" << layout->size()
+                   << ")");
+
+        const Size n = layout->dim().size();
+        axes_.resize(n);
+        spacing_ = layout->spacing();
+
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            const std::vector<Size>& c = iter.coordinates();
+            for (Size i=0; i < n; ++i) {
+                bool onAxis = true;
+                for (Size j=0; j < n && onAxis; ++j)
+                    onAxis = (j == i || c[j] == 0);
+                if (onAxis)
+                    axes_[i].push_back(mesher->location(iter, i));
+            }
+        }
+
+        width_.resize(n);
+        for (Size i=0; i < n; ++i)
+            width_[i] = std::min(Size(4), axes_[i].size());
+    }
+
+    Real FdmLocalCubicInterpolation::operator()(
+                                        const std::vector<Real>& x) const {
+        return evaluate(x, 0, 0);
+    }
+
+    Real FdmLocalCubicInterpolation::derivative(const std::vector<Real>& x,
+                                                Size direction,
+                                                Size order) const {
+        QL_REQUIRE(direction < axes_.size(),
+                   "direction (" << direction << ") out of range");
+        QL_REQUIRE(order == 1 || order == 2,
+                   "only first and second derivatives are supported");
+        return evaluate(x, direction, order);
+    }
+
+    Real FdmLocalCubicInterpolation::evaluate(const std::vector<Real>& x,
+                                              Size direction,
+                                              Size order) const {
+        const Size n = axes_.size();
+        QL_REQUIRE(x.size() == n,
+                   "point dimension (" << x.size()
+                   << ") does not fit to the mesher (" << n << ")");
+
+        // the stencil starts two points below the cell of x,
+        // shifted inwards at the boundaries
+        std::vector<std::vector<Real> > weights(n);
+        Size corner = 0;
+        for (Size i=0; i < n; ++i) {
+            const std::vector<Real>& axis = axes_[i];
+            const Size m = width_[i];
+            const Size pos = std::upper_bound(axis.begin(), axis.end(), x[i])
+                           - axis.begin();
+            const Size base = std::min(axis.size()-m,
+                                       (pos > 2) ? pos-2 : Size(0));
+            corner += base*spacing_[i];
+
+            weights[i].resize(m);
+            for (Size k=0; k < m; ++k)
+                weights[i][k] = lagrangeBasis(&axis[base], m, k, x[i],
+                                              (i == direction) ? order : 0);
+        }
+
+        const std::vector<Real>& f = stencil(corner);
+
+        Real result = 0.0;
+        std::vector<Size> c(n, 0);
+        for (Size k=0; k < f.size(); ++k) {
+            Real w = 1.0;
+            for (Size i=0; i < n; ++i)
+                w *= weights[i][c[i]];
+            result += w*f[k];
+
+            for (Size i=0; i < n && ++c[i] == width_[i]; ++i)
+                c[i] = 0;
+        }
+
+        return result;
+    }
+
+    const std::vector<Real>& FdmLocalCubicInterpolation::stencil(
+                                                        Size corner) const {
+        std::map<Size, std::vector<Real> >::const_iterator iter
+            = stencils_.find(corner);
+        if (iter != stencils_.end())
+            return iter->second;
+
+        const Size n = width_.size();
+        Size size = 1;
+        for (Size i=0; i < n; ++i)
+            size *= width_[i];
+
+        std::vector<Real>& f = stencils_[corner];
+        f.reserve(size);
+
+        std::vector<Size> c(n, 0);
+        for (Size k=0; k < size; ++k) {
+            Size index = corner;
+            for (Size i=0; i < n; ++i)
+                index += c[i]*spacing_[i];
+            f.push_back(values_[index]);
+
+            for (Size i=0; i < n && ++c[i] == width_[i]; ++i)
+                c[i] = 0;
+        }
+
+        return f;
+    }
+}
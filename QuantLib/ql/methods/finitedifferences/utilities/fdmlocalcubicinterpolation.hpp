@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmlocalcubicinterpolation.hpp
+    \brief local tensor-product cubic interpolation on a mesher
+*/
+
+#ifndef quantlib_fdm_local_cubic_interpolation_hpp
+#define quantlib_fdm_local_cubic_interpolation_hpp
+
+#include <ql/math/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <map>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    //! local tensor-product cubic interpolation of values on a mesher
+    /*! The value at a point is interpolated from the 4^N grid points
+        around it with the tensor product of one-dimensional cubic
+        Lagrange polynomials; directions with less than four points
+        use all of them.  Unlike a global multi-cubic spline, nothing
+        is built up front: the values of a stencil are gathered when
+        the first point of its cell is queried and are cached for the
+        following queries.
+
+        Derivatives are the derivatives of the same local polynomial,
+        hence they are consistent with the interpolated values.
+    */
+    class FdmLocalCubicInterpolation {
+      public:
+        FdmLocalCubicInterpolation(const boost::shared_ptr<FdmMesher>& mesher,
+                                   const Array& values);
+
+        Real operator()(const std::vector<Real>& x) const;
+        //! first or second derivative along the given direction
+        Real derivative(const std::vector<Real>& x,
+                        Size direction, Size order = 1) const;
+
+      private:
+        Real evaluate(const std::vector<Real>& x,
+                      Size direction, Size order) const;
+        const std::vector<Real>& stencil(Size corner) const;
+
+        const Array values_;
+        std::vector<std::vector<Real> > axes_;
+        std::vector<Size> spacing_, width_;
+
+        mutable std::map<Size, std::vector<Real> > stencils_;
+    };
+}
+
+#endif
@@ -81,6 +81,10 @@ namespace QuantLib {
         void setPricingEngine(const boost::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        //! returns the engine used for the model value
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -113,12 +114,55 @@ namespace QuantLib {
     }
 
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
-                                              Size numberOfPaths)
+                                              Size numberOfPaths,
+                                              Size numberOfThreads)
     {
-        std::vector<Real> values(product_->numberOfProducts());
-        for (Size i=0; i<numberOfPaths; ++i) {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+        if (numberOfThreads <= 1) {
+            std::vector<Real> values(product_->numberOfProducts());
+            for (Size i=0; i<numberOfPaths; ++i) {
+                Real weight = singlePathValues(values);
+                stats.add(values,weight);
+            }
+            return;
+        }
+
+        // each thread gets a copy of the engine running on its own
+        // substream; the copies are made here, since cloning is not
+        // required to be thread-safe.  The k-th thread simulates the
+        // paths from firstPath[k] to firstPath[k+1]; its evolver is
+        // moved to the first of them by taking substreams of one path.
+        std::vector<Size> firstPath(numberOfThreads+1);
+        for (Size k=0; k<=numberOfThreads; ++k)
+            firstPath[k] = (k*numberOfPaths)/numberOfThreads;
+        std::vector<boost::shared_ptr<AccountingEngine> >
+                                                   engines(numberOfThreads);
+        for (Size k=0; k<numberOfThreads; ++k) {
+            boost::shared_ptr<MarketModelEvolver> evolver(
+                                                 evolver_->clone().release());
+            evolver->substream(firstPath[k], 1);
+            engines[k] = boost::shared_ptr<AccountingEngine>(
+                new AccountingEngine(evolver, product_,
+                                     initialNumeraireValue_));
+        }
+        // the next call will start after the paths used here
+        evolver_->substream(numberOfPaths, 1);
+
+        std::vector<SequenceStatisticsInc> partialStats(numberOfThreads);
+        std::vector<std::string> messages(numberOfThreads);
+        #pragma omp parallel for
+        for (long k=0; k<long(numberOfThreads); ++k) {
+            try {
+                engines[k]->multiplePathValues(partialStats[k],
+                                               firstPath[k+1]-firstPath[k]);
+            } catch (std::exception& e) {
+                messages[k] = e.what();
+            } catch (...) {
+                messages[k] = "unknown error";
+            }
+        }
+        for (Size k=0; k<numberOfThreads; ++k) {
+            QL_REQUIRE(messages[k].empty(), messages[k]);
+            stats.merge(partialStats[k]);
         }
     }
 
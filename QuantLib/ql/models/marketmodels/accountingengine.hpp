@@ -46,8 +46,17 @@ namespace QuantLib {
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        /*! When more than one thread is requested, the paths are
+            split into consecutive substreams of the Brownian
+            generator, each of which is simulated by a copy of the
+            evolver and product; when OpenMP is enabled, the copies
+            run concurrently.  The partial statistics are merged in
+            substream order, so that the results only depend on the
+            number of threads and not on their scheduling.
+        */
         void multiplePathValues(SequenceStatisticsInc& stats,
-                                Size numberOfPaths);
+                                Size numberOfPaths,
+                                Size numberOfThreads = 1);
       private:
         Real singlePathValues(std::vector<Real>& values);
 
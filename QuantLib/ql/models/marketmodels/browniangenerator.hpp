@@ -22,7 +22,9 @@
 #define quantlib_brownian_generator_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <vector>
 
 namespace QuantLib {
@@ -37,6 +39,28 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        //! \name Concurrent simulations
+        //@{
+        //! returns an independent copy of the generator in its current state
+        virtual std::auto_ptr<BrownianGenerator> clone() const {
+            QL_FAIL("cloning not supported by this generator");
+        }
+        //! moves the generator to the i-th of a set of substreams
+        /*! The paths following the current one are split into
+            consecutive substreams of the given length; after the
+            call, the generator returns the paths of the i-th
+            substream.  Copies of a generator moved to different
+            substreams can be used for concurrent simulations.
+
+            Generators that cannot skip ahead are allowed to use a
+            different, reproducible sequence for each substream
+            instead.
+        */
+        virtual void substream(Size /*i*/, Size /*length*/) {
+            QL_FAIL("substreams not supported by this generator");
+        }
+        //@}
     };
 
     class BrownianGeneratorFactory {
@@ -56,6 +56,30 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    std::auto_ptr<BrownianGenerator> MTBrownianGenerator::clone() const {
+        return std::auto_ptr<BrownianGenerator>(new MTBrownianGenerator(*this));
+    }
+
+    void MTBrownianGenerator::substream(Size i, Size) {
+        // the seed of the i-th substream (counting from 0) is the
+        // (i+1)-th integer drawn from a scalar generator seeded from
+        // the current sequence, so that large indices are cheap; null
+        // seeds are skipped, since they would be replaced by random ones.
+        BigNatural seed = 0;
+        do {
+            seed = generator_.nextInt32Sequence()[0];
+        } while (seed == 0);
+        MersenneTwisterUniformRng seeds(seed);
+        for (Size k=0; k<=i; ++k) {
+            do {
+                seed = seeds.nextInt32();
+            } while (seed == 0);
+        }
+        generator_ = RandomSequenceGenerator<MersenneTwisterUniformRng>(
+                           factors_*steps_, MersenneTwisterUniformRng(seed));
+        lastStep_ = 0;
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
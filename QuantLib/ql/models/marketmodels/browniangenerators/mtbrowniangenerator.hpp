@@ -39,6 +39,12 @@ namespace QuantLib {
               instead of a RandomSequenceGenerator; however, it is not
               clear how much of a difference this would make when
               compared to the inverse-cumulative Gaussian calculation.
+
+        \note The Mersenne twister cannot skip ahead efficiently.
+              Substreams are obtained by reseeding the generator
+              with seeds drawn from its current sequence, so that
+              they are reproducible but not part of the original
+              sequence.
     */
     class MTBrownianGenerator : public BrownianGenerator {
       public:
@@ -51,6 +57,9 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        std::auto_ptr<BrownianGenerator> clone() const;
+        void substream(Size i, Size length);
       private:
         Size factors_, steps_;
         Size lastStep_;
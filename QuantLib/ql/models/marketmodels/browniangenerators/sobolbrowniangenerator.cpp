@@ -114,9 +114,9 @@ namespace QuantLib {
                                         unsigned long seed,
                                         SobolRsg::DirectionIntegers integers)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
-                 InverseCumulativeNormal()),
-      bridge_(steps), lastStep_(0),
+      initialSequence_(factors*steps, seed, integers),
+      generator_(initialSequence_, InverseCumulativeNormal()),
+      bridge_(steps), drawnPaths_(0), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
       bridgedVariates_(factors, std::vector<Real>(steps)) {
 
@@ -152,6 +152,7 @@ namespace QuantLib {
                                                   orderedIndices_[i].end()),
                               bridgedVariates_[i].begin());
         }
+        ++drawnPaths_;
         lastStep_ = 0;
         return sample.weight;
     }
@@ -208,6 +209,22 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    std::auto_ptr<BrownianGenerator> SobolBrownianGenerator::clone() const {
+        return std::auto_ptr<BrownianGenerator>(
+                                         new SobolBrownianGenerator(*this));
+    }
+
+    void SobolBrownianGenerator::substream(Size i, Size length) {
+        // skipTo positions a freshly built sequence on the given
+        // draw, hence we restart from the initial one
+        drawnPaths_ += i*length;
+        SobolRsg sequence = initialSequence_;
+        sequence.skipTo(drawnPaths_);
+        generator_ = InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal>(
+                                          sequence, InverseCumulativeNormal());
+        lastStep_ = 0;
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
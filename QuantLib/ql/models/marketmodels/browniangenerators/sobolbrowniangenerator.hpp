@@ -33,6 +33,11 @@ namespace QuantLib {
     //! Sobol Brownian generator for market-model simulations
     /*! Incremental Brownian generator using a Sobol generator,
         inverse-cumulative Gaussian method, and Brownian bridging.
+
+        Substreams are obtained by skipping ahead in the Sobol
+        sequence; therefore, the paths drawn by copies of the
+        generator moved to consecutive substreams are the same as
+        those drawn by the original generator.
     */
     class SobolBrownianGenerator : public BrownianGenerator {
       public:
@@ -59,7 +64,10 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
-        
+
+        std::auto_ptr<BrownianGenerator> clone() const;
+        void substream(Size i, Size length);
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
@@ -68,9 +76,11 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
+        SobolRsg initialSequence_;
         InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
         BrownianBridge bridge_;
         // work variables
+        unsigned long drawnPaths_;
         Size lastStep_;
         std::vector<std::vector<Size> > orderedIndices_;
         std::vector<std::vector<Real> > bridgedVariates_;
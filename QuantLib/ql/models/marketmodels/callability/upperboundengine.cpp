@@ -29,6 +29,8 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <algorithm>
+#include <numeric>
+#include <string>
 
 namespace QuantLib {
 
@@ -116,10 +118,19 @@ namespace QuantLib {
                    const MarketModelMultiProduct& hedge,
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
-                   Real initialNumeraireValue)
+                   Real initialNumeraireValue,
+                   Real innerTolerance,
+                   Size innerBatchSize)
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
-      initialNumeraireValue_(initialNumeraireValue) {
+      initialNumeraireValue_(initialNumeraireValue),
+      innerTolerance_(innerTolerance), innerBatchSize_(innerBatchSize),
+      innerPathsUsed_(0) {
+
+        QL_REQUIRE(innerTolerance_ == Null<Real>() || innerTolerance_ > 0.0,
+                   "inner tolerance must be positive");
+        QL_REQUIRE(innerBatchSize_ > 1,
+                   "inner batch size must be greater than 1");
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -169,10 +180,94 @@ namespace QuantLib {
 
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
-                                              Size innerPaths) {
-        for (Size i=0; i<outerPaths; ++i) {
-            std::pair<Real,Real> result = singlePathValue(innerPaths);
-            stats.add(result.first, result.second);
+                                              Size innerPaths,
+                                              Size numberOfThreads) {
+        if (numberOfThreads <= 1) {
+            for (Size i=0; i<outerPaths; ++i) {
+                std::pair<Real,Real> result = singlePathValue(innerPaths);
+                stats.add(result.first, result.second);
+            }
+            return;
+        }
+
+        // each thread gets a copy of the engine running on its own
+        // substreams; the copies are made here, since cloning is not
+        // required to be thread-safe.  The k-th thread simulates the
+        // outer paths from firstPath[k] to firstPath[k+1].
+        std::vector<Size> firstPath(numberOfThreads+1);
+        for (Size k=0; k<=numberOfThreads; ++k)
+            firstPath[k] = (k*outerPaths)/numberOfThreads;
+
+        // Each inner evolver is used at most once per outer path (or
+        // more, if the same evolver is passed for several exercise
+        // times) for at most innerPaths paths; this gives the length
+        // of the substream it uses for each outer path.  Only the
+        // evolvers for the exercise times before the last step run
+        // inner simulations (see singlePathValue below.)
+        Size innerSimulations = 0;
+        for (Size k=0; k<numberOfSteps_-1; ++k)
+            if (isExerciseTime_[k])
+                ++innerSimulations;
+        Size n = innerEvolvers_.size();
+        std::vector<Size> innerLengths(n), sharedWith(n);
+        for (Size j=0; j<n; ++j) {
+            sharedWith[j] = j;
+            for (Size l=0; l<j; ++l) {
+                if (innerEvolvers_[l] == innerEvolvers_[j]) {
+                    sharedWith[j] = l;
+                    break;
+                }
+            }
+            if (j < innerSimulations)
+                innerLengths[sharedWith[j]] += innerPaths;
+        }
+
+        std::vector<boost::shared_ptr<UpperBoundEngine> >
+                                                   engines(numberOfThreads);
+        for (Size k=0; k<numberOfThreads; ++k) {
+            engines[k] = boost::shared_ptr<UpperBoundEngine>(
+                                                new UpperBoundEngine(*this));
+            engines[k]->innerPathsUsed_ = 0;
+            engines[k]->evolver_ = boost::shared_ptr<MarketModelEvolver>(
+                                                 evolver_->clone().release());
+            engines[k]->evolver_->substream(firstPath[k], 1);
+            for (Size j=0; j<n; ++j) {
+                if (sharedWith[j] == j) {
+                    engines[k]->innerEvolvers_[j] =
+                        boost::shared_ptr<MarketModelEvolver>(
+                                         innerEvolvers_[j]->clone().release());
+                    engines[k]->innerEvolvers_[j]->substream(
+                                             firstPath[k], innerLengths[j]);
+                } else {
+                    engines[k]->innerEvolvers_[j] =
+                        engines[k]->innerEvolvers_[sharedWith[j]];
+                }
+            }
+        }
+        // the next call will start after the paths used here
+        evolver_->substream(outerPaths, 1);
+        for (Size j=0; j<n; ++j)
+            if (sharedWith[j] == j)
+                innerEvolvers_[j]->substream(outerPaths, innerLengths[j]);
+
+        std::vector<Statistics> partialStats(numberOfThreads);
+        std::vector<std::string> messages(numberOfThreads);
+        #pragma omp parallel for
+        for (long k=0; k<long(numberOfThreads); ++k) {
+            try {
+                engines[k]->multiplePathValues(partialStats[k],
+                                               firstPath[k+1]-firstPath[k],
+                                               innerPaths);
+            } catch (std::exception& e) {
+                messages[k] = e.what();
+            } catch (...) {
+                messages[k] = "unknown error";
+            }
+        }
+        for (Size k=0; k<numberOfThreads; ++k) {
+            QL_REQUIRE(messages[k].empty(), messages[k]);
+            stats.merge(partialStats[k]);
+            innerPathsUsed_ += engines[k]->innerPathsUsed_;
         }
     }
 
@@ -253,17 +348,10 @@ namespace QuantLib {
                     callable.enableCallability();
                     callable.save();
 
-                    // This allows us to write:
-                    AccountingEngine engine(currentEvolver, callable,
-                                            1.0); // this causes the result
-                                                  // to be in numeraire units
-                    SequenceStatisticsInc innerStats(callable.numberOfProducts());
-                    engine.multiplePathValues(innerStats, innerPaths);
-
-                    const std::vector<Real>& values = innerStats.mean();
                     unexercisedHedgeValue =
-                        std::accumulate(values.begin(), values.end(), 0.0)
-                        / principalInNumerairePortfolio;
+                        continuationValue(currentEvolver, callable,
+                                          principalInNumerairePortfolio,
+                                          innerPaths);
 
                     callable.disableCallability();
                     callable.startRecording();
@@ -322,6 +410,51 @@ namespace QuantLib {
     }
 
 
+    Real UpperBoundEngine::continuationValue(
+                        const boost::shared_ptr<MarketModelEvolver>& evolver,
+                        const MarketModelMultiProduct& callable,
+                        Real principalInNumerairePortfolio,
+                        Size innerPaths) {
+
+        // This allows us to write:
+        AccountingEngine engine(evolver, callable,
+                                1.0); // this causes the result
+                                      // to be in numeraire units
+        SequenceStatisticsInc innerStats(callable.numberOfProducts());
+
+        if (innerTolerance_ == Null<Real>()) {
+            engine.multiplePathValues(innerStats, innerPaths);
+            innerPathsUsed_ += innerPaths;
+        } else {
+            // The inner paths are added in batches until the error
+            // on the sum of the hedge values, converted to the units
+            // of the results, is small enough.
+            Real tolerance = innerTolerance_ * principalInNumerairePortfolio
+                                             / initialNumeraireValue_;
+            Size paths = 0;
+            do {
+                Size batch = std::min(innerBatchSize_, innerPaths-paths);
+                engine.multiplePathValues(innerStats, batch);
+                paths += batch;
+                innerPathsUsed_ += batch;
+                if (paths < 2)
+                    continue;
+                Matrix covariance = innerStats.covariance();
+                Real variance = 0.0;
+                for (Size i=0; i<covariance.rows(); ++i)
+                    for (Size j=0; j<covariance.columns(); ++j)
+                        variance += covariance[i][j];
+                if (variance <= tolerance*tolerance*innerStats.samples())
+                    break;
+            } while (paths < innerPaths);
+        }
+
+        const std::vector<Real>& values = innerStats.mean();
+        return std::accumulate(values.begin(), values.end(), 0.0)
+            / principalInNumerairePortfolio;
+    }
+
+
     Real UpperBoundEngine::collectCashFlows(Size currentStep,
                                             Real principalInNumerairePortfolio,
                                             Size beginProduct,
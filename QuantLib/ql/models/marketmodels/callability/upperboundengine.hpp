@@ -26,6 +26,7 @@
 #include <ql/methods/montecarlo/exercisestrategy.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/utilities/clone.hpp>
+#include <ql/utilities/null.hpp>
 #include <utility>
 #include <valarray>
 
@@ -37,7 +38,17 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! At each exercise time of each outer path, the value of the
+        unexercised hedge is estimated by an inner simulation.  By
+        default, the given number of inner paths is used.  When an
+        inner tolerance is given, the inner paths are instead
+        simulated in batches of the given size until the error
+        estimate of the hedge value (in the same units as the
+        results) falls below the tolerance; in this case, the
+        number of inner paths passed to the calculation methods is
+        used as an upper limit.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
@@ -51,22 +62,45 @@ namespace QuantLib {
                    const MarketModelMultiProduct& hedge,
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
-                   Real initialNumeraireValue);
+                   Real initialNumeraireValue,
+                   Real innerTolerance = Null<Real>(),
+                   Size innerBatchSize = 64);
+        /*! When more than one thread is requested, the outer paths
+            are split into consecutive substreams of the outer
+            evolver; each of them is simulated by a copy of the
+            engine, whose inner evolvers are moved to distinct
+            substreams of their own.  When OpenMP is enabled, the
+            copies run concurrently.  As in the AccountingEngine
+            class, the partial statistics are merged in substream
+            order, so that the results only depend on the number
+            of threads and not on their scheduling.
+        */
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
-                                Size innerPaths);
+                                Size innerPaths,
+                                Size numberOfThreads = 1);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
+        //! total number of inner paths simulated so far
+        Size innerPathsUsed() const { return innerPathsUsed_; }
       private:
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
                               Size endProduct) const;
+        Real continuationValue(
+                        const boost::shared_ptr<MarketModelEvolver>& evolver,
+                        const MarketModelMultiProduct& callable,
+                        Real principalInNumerairePortfolio,
+                        Size innerPaths);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers_;
         MultiProductComposite composite_;
 
         Real initialNumeraireValue_;
+        Real innerTolerance_;
+        Size innerBatchSize_;
+        Size innerPathsUsed_;
         Size underlyingSize_, rebateSize_, hedgeSize_, hedgeRebateSize_;
         Size underlyingOffset_, rebateOffset_, hedgeOffset_, hedgeRebateOffset_;
         Size numberOfProducts_;
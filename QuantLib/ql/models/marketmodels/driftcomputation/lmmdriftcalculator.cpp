@@ -181,4 +181,115 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(forwards.rows()==numberOfRates_,
+                       "numberOfRates <> dim");
+            QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                       drifts.columns()==forwards.columns(),
+                       "drifts size <> forwards size");
+        #endif
+
+        if (isFullFactor_)
+            computePlain(forwards, drifts);
+        else
+            computeReduced(forwards, drifts);
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+
+        // Same calculation as above, carried out on all paths at once.
+        Size paths = forwards.columns();
+        if (tmpPaths_.columns() != paths)
+            tmpPaths_ = Matrix(numberOfRates_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size i, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpPaths_.row_begin(i);
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+displacements_[i]) / (oneOverTaus_[i]+f[p]);
+        }
+
+        // Compute drifts
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            for (Size k=downs_[i]; k<ups_[i]; ++k) {
+                Matrix::const_row_iterator t = tmpPaths_.row_begin(k);
+                Real c = C_[i][k];
+                for (p=0; p<paths; ++p)
+                    d[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (p=0; p<paths; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        // Same calculation as above, carried out on all paths at once;
+        // since e_[r][i] only depends on e_[r][i+1] (or e_[r][i-1]),
+        // a single row per factor is stored.
+        Size paths = forwards.columns();
+        if (tmpPaths_.columns() != paths)
+            tmpPaths_ = Matrix(numberOfRates_, paths, 0.0);
+        if (ePaths_.columns() != paths)
+            ePaths_ = Matrix(numberOfFactors_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size r, p;
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpPaths_.row_begin(i);
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+displacements_[i]) / (oneOverTaus_[i]+f[p]);
+        }
+
+        // 1st step: the drift corresponding to the numeraire P_N is zero.
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: move backward from N-2 (included) back to
+        // alive (included).
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            Matrix::const_row_iterator t = tmpPaths_.row_begin(i+1);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p] * a;
+                    d[p] -= e[p] * b;
+                }
+            }
+        }
+
+        // 3rd step: move forward from N (included) up to n (excluded).
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            Matrix::const_row_iterator t = tmpPaths_.row_begin(i);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                Real a = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p] * a;
+                    d[p] += e[p] * a;
+                }
+            }
+        }
+    }
+
 }
@@ -64,6 +64,21 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        //! Computes the drifts on a set of paths at once
+        /*! Forwards and drifts are stored by rate, i.e., the i-th
+            row contains the values of the i-th rate on each path.
+            The innermost loops run along the rows, so that they
+            work on contiguous memory and can be vectorized by the
+            compiler; the results are the same as those of the
+            path-by-path calculation.
+        */
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +89,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpPaths_, ePaths_;
         std::vector<Size> downs_, ups_;
     };
 
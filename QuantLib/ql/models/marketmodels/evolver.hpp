@@ -22,6 +22,8 @@
 #define quantlib_market_model_evolver_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <memory>
 #include <vector>
 
 namespace QuantLib {
@@ -42,6 +44,22 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+
+        //! \name Concurrent simulations
+        //@{
+        //! returns an independent copy of the evolver in its current state
+        /*! The copy owns a copy of the Brownian generator and can be
+            used in a different thread than the original.
+        */
+        virtual std::auto_ptr<MarketModelEvolver> clone() const {
+            QL_FAIL("cloning not supported by this evolver");
+        }
+        //! moves the Brownian generator to the i-th of a set of substreams
+        /*! \sa BrownianGenerator::substream */
+        virtual void substream(Size /*i*/, Size /*length*/) {
+            QL_FAIL("substreams not supported by this evolver");
+        }
+        //@}
     };
 
 }
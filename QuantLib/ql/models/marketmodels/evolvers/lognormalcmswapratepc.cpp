@@ -160,4 +160,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalCmSwapRatePc::clone() const {
+        std::auto_ptr<LogNormalCmSwapRatePc> evolver(
+            new LogNormalCmSwapRatePc(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalCmSwapRatePc::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
@@ -157,4 +157,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalCotSwapRatePc::clone() const {
+        std::auto_ptr<LogNormalCotSwapRatePc> evolver(
+            new LogNormalCotSwapRatePc(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalCotSwapRatePc::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
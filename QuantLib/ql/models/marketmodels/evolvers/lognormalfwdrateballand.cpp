@@ -154,4 +154,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateBalland::clone() const {
+        std::auto_ptr<LogNormalFwdRateBalland> evolver(
+            new LogNormalFwdRateBalland(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRateBalland::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
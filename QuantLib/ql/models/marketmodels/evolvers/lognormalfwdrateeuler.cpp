@@ -143,4 +143,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateEuler::clone() const {
+        std::auto_ptr<LogNormalFwdRateEuler> evolver(
+            new LogNormalFwdRateEuler(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRateEuler::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
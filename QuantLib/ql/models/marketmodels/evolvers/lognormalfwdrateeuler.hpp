@@ -46,6 +46,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        std::auto_ptr<MarketModelEvolver> clone() const;
+        void substream(Size i, Size length);
         //@}
 
         //! accessor methods useful for doing pathwise vegas
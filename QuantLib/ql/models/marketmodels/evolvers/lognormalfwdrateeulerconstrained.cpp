@@ -234,4 +234,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateEulerConstrained::clone() const {
+        std::auto_ptr<LogNormalFwdRateEulerConstrained> evolver(
+            new LogNormalFwdRateEulerConstrained(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRateEulerConstrained::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
@@ -58,6 +58,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        std::auto_ptr<MarketModelEvolver> clone() const;
+        void substream(Size i, Size length);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -156,4 +156,19 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateiBalland::clone() const {
+        // the covariances are calculated lazily by the market model
+        // and must be available before the copies run concurrently
+        marketModel_->covariance(0);
+        std::auto_ptr<LogNormalFwdRateiBalland> evolver(
+            new LogNormalFwdRateiBalland(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRateiBalland::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
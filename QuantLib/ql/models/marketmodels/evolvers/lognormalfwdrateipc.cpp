@@ -151,4 +151,19 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateIpc::clone() const {
+        // the covariances are calculated lazily by the market model
+        // and must be available before the copies run concurrently
+        marketModel_->covariance(0);
+        std::auto_ptr<LogNormalFwdRateIpc> evolver(
+            new LogNormalFwdRateIpc(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRateIpc::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
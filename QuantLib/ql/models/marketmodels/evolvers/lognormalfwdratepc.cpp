@@ -30,7 +30,8 @@ namespace QuantLib {
                            const boost::shared_ptr<MarketModel>& marketModel,
                            const BrownianGeneratorFactory& factory,
                            const std::vector<Size>& numeraires,
-                           Size initialStep)
+                           Size initialStep,
+                           Size blockSize)
     : marketModel_(marketModel),
       numeraires_(numeraires),
       initialStep_(initialStep),
@@ -43,9 +44,11 @@ namespace QuantLib {
       drifts1_(numberOfRates_), drifts2_(numberOfRates_),
       initialDrifts_(numberOfRates_), brownians_(numberOfFactors_),
       correlatedBrownians_(numberOfRates_),
-      alive_(marketModel->evolution().firstAliveRate())
+      alive_(marketModel->evolution().firstAliveRate()),
+      blockSize_(blockSize), currentPath_(blockSize)
     {
         checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(blockSize_ > 0, "null block size");
 
         Size steps = marketModel->evolution().numberOfSteps();
 
@@ -73,6 +76,20 @@ namespace QuantLib {
             fixedDrifts_.push_back(fixed);
         }
 
+        if (blockSize_ > 1) {
+            blockForwards_ = std::vector<Matrix>(
+                                  steps, Matrix(numberOfRates_, blockSize_));
+            blockBrownians_ = std::vector<Matrix>(
+                                steps, Matrix(numberOfFactors_, blockSize_));
+            blockPathWeights_ = std::vector<Real>(blockSize_);
+            blockStepWeights_ = Matrix(steps, blockSize_);
+            blockLogForwards_ = Matrix(numberOfRates_, blockSize_);
+            blockCurrentForwards_ = Matrix(numberOfRates_, blockSize_);
+            blockDrifts1_ = Matrix(numberOfRates_, blockSize_);
+            blockDrifts2_ = Matrix(numberOfRates_, blockSize_);
+            blockDiffusion_ = std::vector<Real>(blockSize_);
+        }
+
         setForwards(marketModel_->initialRates());
     }
 
@@ -88,6 +105,8 @@ namespace QuantLib {
              initialLogForwards_[i] = std::log(forwards[i] +
                                                displacements_[i]);
         calculators_[initialStep_].compute(forwards, initialDrifts_);
+        // paths simulated from the previous state are discarded
+        currentPath_ = blockSize_;
     }
 
     void LogNormalFwdRatePc::setInitialState(const CurveState& cs) {
@@ -96,6 +115,11 @@ namespace QuantLib {
 
     Real LogNormalFwdRatePc::startNewPath() {
         currentStep_ = initialStep_;
+        if (blockSize_ > 1) {
+            if (++currentPath_ >= blockSize_)
+                simulateBlock();
+            return blockPathWeights_[currentPath_];
+        }
         std::copy(initialLogForwards_.begin(), initialLogForwards_.end(),
                   logForwards_.begin());
         return generator_->nextPath();
@@ -103,6 +127,15 @@ namespace QuantLib {
 
     Real LogNormalFwdRatePc::advanceStep()
     {
+        if (blockSize_ > 1) {
+            // the path was already simulated; just load its forwards
+            const Matrix& blockForwards = blockForwards_[currentStep_];
+            for (Size i=0; i<numberOfRates_; ++i)
+                forwards_[i] = blockForwards[i][currentPath_];
+            curveState_.setOnForwardRates(forwards_);
+            return blockStepWeights_[currentStep_++][currentPath_];
+        }
+
         // we're going from T1 to T2
 
         // a) compute drifts D1 at T1;
@@ -144,6 +177,87 @@ namespace QuantLib {
         return weight;
     }
 
+    void LogNormalFwdRatePc::simulateBlock() {
+        // Same steps as in advanceStep, carried out on all the paths
+        // in the block at once.  The generator is used in the same
+        // order as in the path-by-path simulation.
+        Size steps = blockForwards_.size();
+        Size i, k, p;
+        for (p=0; p<blockSize_; ++p) {
+            blockPathWeights_[p] = generator_->nextPath();
+            for (Size j=initialStep_; j<steps; ++j) {
+                blockStepWeights_[j][p] = generator_->nextStep(brownians_);
+                for (k=0; k<numberOfFactors_; ++k)
+                    blockBrownians_[j][k][p] = brownians_[k];
+            }
+        }
+
+        for (i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i), initialLogForwards_[i]);
+            std::fill(blockCurrentForwards_.row_begin(i),
+                      blockCurrentForwards_.row_end(i), forwards_[i]);
+        }
+
+        for (Size j=initialStep_; j<steps; ++j) {
+
+            // a) compute drifts D1 at T1;
+            if (j > initialStep_) {
+                calculators_[j].compute(blockCurrentForwards_, blockDrifts1_);
+            } else {
+                for (i=0; i<numberOfRates_; ++i)
+                    std::fill(blockDrifts1_.row_begin(i),
+                              blockDrifts1_.row_end(i), initialDrifts_[i]);
+            }
+
+            // b) evolve forwards up to T2 using D1;
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            const Matrix& Z = blockBrownians_[j];
+            const std::vector<Real>& fixedDrift = fixedDrifts_[j];
+
+            Size alive = alive_[j];
+            for (i=alive; i<numberOfRates_; ++i) {
+                std::fill(blockDiffusion_.begin(), blockDiffusion_.end(), 0.0);
+                for (k=0; k<numberOfFactors_; ++k) {
+                    Matrix::const_row_iterator z = Z.row_begin(k);
+                    Real a = A[i][k];
+                    for (p=0; p<blockSize_; ++p)
+                        blockDiffusion_[p] += a*z[p];
+                }
+                Matrix::row_iterator x = blockLogForwards_.row_begin(i);
+                Matrix::row_iterator f = blockCurrentForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                for (p=0; p<blockSize_; ++p) {
+                    x[p] += d1[p] + fixedDrift[i];
+                    x[p] += blockDiffusion_[p];
+                    f[p] = std::exp(x[p]) - displacements_[i];
+                }
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[j].compute(blockCurrentForwards_, blockDrifts2_);
+
+            // d) correct forwards using both drifts
+            for (i=alive; i<numberOfRates_; ++i) {
+                Matrix::row_iterator x = blockLogForwards_.row_begin(i);
+                Matrix::row_iterator f = blockCurrentForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                Matrix::const_row_iterator d2 = blockDrifts2_.row_begin(i);
+                for (p=0; p<blockSize_; ++p) {
+                    x[p] += (d2[p]-d1[p])/2.0;
+                    f[p] = std::exp(x[p]) - displacements_[i];
+                }
+            }
+
+            // e) store the forwards for the curve states
+            std::copy(blockCurrentForwards_.begin(),
+                      blockCurrentForwards_.end(),
+                      blockForwards_[j].begin());
+        }
+
+        currentPath_ = 0;
+    }
+
     Size LogNormalFwdRatePc::currentStep() const {
         return currentStep_;
     }
@@ -152,4 +266,20 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRatePc::clone() const {
+        std::auto_ptr<LogNormalFwdRatePc> evolver(
+            new LogNormalFwdRatePc(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void LogNormalFwdRatePc::substream(Size i, Size length) {
+        QL_REQUIRE(blockSize_ == 1,
+                   "substreams not available with a block size of "
+                   << blockSize_);
+        generator_->substream(i, length);
+        currentPath_ = blockSize_;
+    }
+
 }
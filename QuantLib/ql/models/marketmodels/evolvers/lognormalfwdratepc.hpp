@@ -32,12 +32,32 @@ namespace QuantLib {
     class BrownianGeneratorFactory;
 
     //! Predictor-Corrector
+    /*! When a block size larger than one is passed, the evolver
+        simulates that many paths at once, storing the forwards of
+        each path by rate so that drifts and pseudo-root products are
+        computed for the whole block in loops over contiguous memory.
+        The paths are then returned one at a time through the usual
+        interface, and the curve state is set to the one of the
+        current path at each step; therefore, the results are the
+        same as those of the path-by-path simulation.
+
+        \warning In block mode, the Brownian generator is drawn up to
+                 a block ahead of the returned paths; the paths
+                 remaining in the current block are discarded when the
+                 initial state is changed.  For the same reason, the
+                 position of the generator doesn't match the number of
+                 returned paths and substreams can't be positioned
+                 correctly; therefore, substream() is only available
+                 with a block size of one, and block evolvers can't be
+                 used by engines running on several threads.
+    */
     class LogNormalFwdRatePc : public MarketModelEvolver {
       public:
         LogNormalFwdRatePc(const boost::shared_ptr<MarketModel>&,
                            const BrownianGeneratorFactory&,
                            const std::vector<Size>& numeraires,
-                           Size initialStep = 0);
+                           Size initialStep = 0,
+                           Size blockSize = 1);
         //! \name MarketModel interface
         //@{
         const std::vector<Size>& numeraires() const;
@@ -46,9 +66,12 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        std::auto_ptr<MarketModelEvolver> clone() const;
+        void substream(Size i, Size length);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
+        void simulateBlock();
         // inputs
         boost::shared_ptr<MarketModel> marketModel_;
         std::vector<Size> numeraires_;
@@ -66,6 +89,15 @@ namespace QuantLib {
         std::vector<Size> alive_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
+        // block simulation; forwards and variates are stored by rate
+        // (or factor) and path, weights by step and path
+        Size blockSize_, currentPath_;
+        std::vector<Matrix> blockForwards_, blockBrownians_;
+        std::vector<Real> blockPathWeights_;
+        Matrix blockStepWeights_;
+        Matrix blockLogForwards_, blockCurrentForwards_;
+        Matrix blockDrifts1_, blockDrifts2_;
+        std::vector<Real> blockDiffusion_;
     };
 
 }
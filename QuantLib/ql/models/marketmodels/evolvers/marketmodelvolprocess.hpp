@@ -20,6 +20,8 @@
 #ifndef quantlib_market_model_vol_process_hpp
 #define quantlib_market_model_vol_process_hpp
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <memory>
 #include <vector>
 
 namespace QuantLib 
@@ -46,6 +48,11 @@ namespace QuantLib
 
           virtual const std::vector<Real>& stateVariables() const=0;
           virtual Size numberStateVariables() const=0;
+
+          //! returns an independent copy of the process in its current state
+          virtual std::auto_ptr<MarketModelVolProcess> clone() const {
+              QL_FAIL("cloning not supported by this process");
+          }
      
       private:
  
@@ -201,4 +201,17 @@ namespace QuantLib {
         return curveState_;
     }
 
+    std::auto_ptr<MarketModelEvolver> SVDDFwdRatePc::clone() const {
+        std::auto_ptr<SVDDFwdRatePc> evolver(new SVDDFwdRatePc(*this));
+        evolver->generator_ = boost::shared_ptr<BrownianGenerator>(
+                                                  generator_->clone().release());
+        evolver->volProcess_ = boost::shared_ptr<MarketModelVolProcess>(
+                                                volProcess_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
+    void SVDDFwdRatePc::substream(Size i, Size length) {
+        generator_->substream(i, length);
+    }
+
 }
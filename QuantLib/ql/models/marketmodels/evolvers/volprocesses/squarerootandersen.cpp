@@ -161,4 +161,10 @@ QuantLib
         return 1;
     }
 
+    std::auto_ptr<MarketModelVolProcess> SquareRootAndersen::clone() const
+    {
+        return std::auto_ptr<MarketModelVolProcess>(
+                                                new SquareRootAndersen(*this));
+    }
+
 }
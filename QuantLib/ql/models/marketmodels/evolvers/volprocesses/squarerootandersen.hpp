@@ -53,6 +53,8 @@ namespace QuantLib
 
           virtual const std::vector<Real>& stateVariables() const;
           virtual Size numberStateVariables() const;
+
+          virtual std::auto_ptr<MarketModelVolProcess> clone() const;
      
       private:
 
@@ -24,6 +24,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -310,13 +311,57 @@ namespace QuantLib {
     }
 
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
-        Size numberOfPaths)
+        Size numberOfPaths, Size numberOfThreads)
     {
-        std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
-        for (Size i=0; i<numberOfPaths; ++i)
+        if (numberOfThreads <= 1)
         {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+            std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
+            for (Size i=0; i<numberOfPaths; ++i)
+            {
+                Real weight = singlePathValues(values);
+                stats.add(values,weight);
+            }
+            return;
+        }
+
+        // see AccountingEngine::multiplePathValues
+        std::vector<Size> firstPath(numberOfThreads+1);
+        for (Size k=0; k<=numberOfThreads; ++k)
+            firstPath[k] = (k*numberOfPaths)/numberOfThreads;
+        std::vector<boost::shared_ptr<PathwiseAccountingEngine> >
+                                                   engines(numberOfThreads);
+        for (Size k=0; k<numberOfThreads; ++k)
+        {
+            boost::shared_ptr<LogNormalFwdRateEuler> evolver =
+                boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                    boost::shared_ptr<MarketModelEvolver>(
+                                              evolver_->clone().release()));
+            evolver->substream(firstPath[k], 1);
+            engines[k] = boost::shared_ptr<PathwiseAccountingEngine>(
+                new PathwiseAccountingEngine(evolver, product_,
+                                             pseudoRootStructure_,
+                                             initialNumeraireValue_));
+        }
+        evolver_->substream(numberOfPaths, 1);
+
+        std::vector<SequenceStatisticsInc> partialStats(numberOfThreads);
+        std::vector<std::string> messages(numberOfThreads);
+        #pragma omp parallel for
+        for (long k=0; k<long(numberOfThreads); ++k)
+        {
+            try {
+                engines[k]->multiplePathValues(partialStats[k],
+                                               firstPath[k+1]-firstPath[k]);
+            } catch (std::exception& e) {
+                messages[k] = e.what();
+            } catch (...) {
+                messages[k] = "unknown error";
+            }
+        }
+        for (Size k=0; k<numberOfThreads; ++k)
+        {
+            QL_REQUIRE(messages[k].empty(), messages[k]);
+            stats.merge(partialStats[k]);
         }
     }
 
@@ -751,23 +796,21 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
-       std::vector<Matrix> jacobiansThisPathsModel;
-       for (Size i =0; i < numberRates_; ++i)
-              jacobiansThisPathsModel.push_back(Matrix(numberRates_,factors_));
-
-
-
         for (Size i =0; i < numberSteps_; ++i)
         {
               jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
                                 pseudoRootStructure_->displacements()));
-
-              // vector of vector of matrices to store jacobians of rates with respect to pseudo-root elements
-            jacobiansThisPaths_.push_back(jacobiansThisPathsModel);
         }
 
+        // what the backward sweep needs to pull the adjoints back through each step
+        forwardsThisPath_.resize(numberSteps_+1, std::vector<Real>(numberRates_));
+        forwardsThisPath_[0] = pseudoRootStructure_->initialRates();
+        stepsDiscountsThisPath_.resize(numberSteps_, stepsDiscounts_);
+        browniansThisPath_.resize(numberSteps_, std::vector<Real>(factors_));
+        rateAdjoints_.resize(numberRates_);
+
 
 
         Matrix VModel(numberSteps_+1,numberRates_);
@@ -924,11 +967,9 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
+            forwardsThisPath_[storeStep] = currentForwards_;
+            stepsDiscountsThisPath_[thisStep] = stepsDiscounts_;
+            browniansThisPath_[thisStep] = evolver_->browniansThisStep();
 
 //            gaussians_[thisStep] = evolver_->browniansThisStep();
 
@@ -1072,27 +1113,26 @@ namespace QuantLib {
                 {
                     Size nextIndex = j+1;
 
+                    // steps after the last one done did not affect the cash flows
+                    if (static_cast<Integer>(j) > finalStepDone)
+                    {
+                        Matrix& vegas = elementary_vegas_ThisPath_[i][j];
+                        std::fill(vegas.begin(), vegas.end(), 0.0);
+                        continue;
+                    }
+
                     // we know V, we need to pair against the senstivity of the rate to the elementary vega
                     // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
 
-                    for (Size k=0; k < numberRates_; ++k)
-                        for (Size f=0; f < factors_; ++f)
-                        {
-                                Real sensitivity =0.0;
-
-                                for (Size r=0; r < numberRates_; ++r)
-                                {
-                                        sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
-
-                                  }
-/*
-                                  if (j ==distinguishedStep_ && k ==distinguishedRate_ &&f== distinguishedFactor_)
-                                      std::cout << sensitivity << "," <<  jacobiansThisPaths_[j][j][k][f] << "," << gaussians_[j][f] << "," << V_[i][nextIndex][j] << "," << LIBORRates_[nextIndex][j] << "\n";
-  */                
-
+                    for (Size r=0; r < numberRates_; ++r)
+                        rateAdjoints_[r] = V_[i][nextIndex][r];
 
-                                elementary_vegas_ThisPath_[i][j][k][f] = sensitivity;
-                        }
+                    jacobianComputers_[j].getVegas(forwardsThisPath_[j],
+                                                   stepsDiscountsThisPath_[j],
+                                                   forwardsThisPath_[nextIndex],
+                                                   browniansThisPath_[j],
+                                                   rateAdjoints_,
+                                                   elementary_vegas_ThisPath_[i][j]);
                 }
         }
 
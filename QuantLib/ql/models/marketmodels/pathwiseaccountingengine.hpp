@@ -49,8 +49,10 @@ namespace QuantLib {
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          Real initialNumeraireValue);
 
+        //! \sa AccountingEngine::multiplePathValues for the use of several threads
         void multiplePathValues(SequenceStatisticsInc& stats,
-                                Size numberOfPaths);
+                                Size numberOfPaths,
+                                Size numberOfThreads = 1);
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -187,6 +189,9 @@ namespace QuantLib {
     // We do the outermost vector by time step and inner one by which vega.
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
+    // The elementary vegas are obtained in the backward sweep: only the rates, discount ratios and Gaussians of each step
+    // are recorded along the path, and the adjoints V are pulled back through each step without forming the Jacobians,
+    // so that the cost per path of all deltas and elementary vegas is a constant multiple of the cost of the path itself.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasOuterAccountingEngine 
@@ -252,7 +257,11 @@ namespace QuantLib {
         Matrix partials_; // dimensions are factor and rate
 
         std::vector<std::vector<Matrix>   > elementary_vegas_ThisPath_;  // dimensions are product, step,  rate and factor
-        std::vector<std::vector<Matrix> > jacobiansThisPaths_;                      // dimensions are step, rate, rate and factor
+
+        std::vector<std::vector<Real> > forwardsThisPath_; // dimensions are step (from 0 to n) and rate
+        std::vector<std::vector<Real> > stepsDiscountsThisPath_; // dimensions are step and rate
+        std::vector<std::vector<Real> > browniansThisPath_; // dimensions are step and factor
+        std::vector<Real> rateAdjoints_;
 
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
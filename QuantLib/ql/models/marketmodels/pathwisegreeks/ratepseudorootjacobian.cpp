@@ -332,6 +332,60 @@ namespace QuantLib
             }
     }
 
+    void RatePseudoRootJacobianAllElements::getVegas(const std::vector<Rate>& oldRates,
+        const std::vector<Real>& discountRatios,
+        const std::vector<Rate>& newRates,
+        const std::vector<Real>& gaussians,
+        const std::vector<Real>& rateAdjoints,
+        Matrix& vegas)
+    {
+        Size numberRates = taus_.size();
+
+        QL_REQUIRE(rateAdjoints.size() == numberRates, "we need rateAdjoints.size() which is " << rateAdjoints.size() << " to equal numberRates which is "  << numberRates);
+        QL_REQUIRE(vegas.rows() == numberRates && vegas.columns() == factors_, "we need vegas.rows() which is " << vegas.rows() << " to equal numberRates which is "  << numberRates <<
+                   " and vegas.columns() which is " << vegas.columns() << " to be equal to factors which is " << factors_);
+
+        for (Size j=aliveIndex_; j < numberRates; ++j)
+            ratios_[j] = (oldRates[j] + displacements_[j])*discountRatios[j+1];
+
+        for (Size f=0; f < factors_; ++f)
+        {
+            e_[aliveIndex_][f] = 0;
+
+            for (Size j= aliveIndex_+1; j < numberRates; ++j)
+                e_[j][f] = e_[j-1][f] + ratios_[j-1]*pseudoRoot_[j-1][f];
+        }
+
+        for (Size j=0; j < aliveIndex_; ++j)
+            for (Size f=0; f < factors_; ++f)
+                vegas[j][f] = 0.0;
+
+        // the element (k,f) affects rate k through its diffusion and
+        // every later rate j through its drift, by an amount which
+        // factors into a term depending on k and one depending on j;
+        // the latter are accumulated backwards.
+        for (Size f=0; f < factors_; ++f)
+        {
+            Real laterRates = 0.0;
+
+            for (Size j=numberRates; j > aliveIndex_; )
+            {
+                --j;
+
+                Real tmp = 2*ratios_[j]*taus_[j]*pseudoRoot_[j][f];
+                tmp -=  pseudoRoot_[j][f];
+                tmp += e_[j][f]*taus_[j];
+                tmp += gaussians[f];
+                tmp *= (newRates[j]+displacements_[j]);
+
+                vegas[j][f] = rateAdjoints[j]*tmp
+                            + ratios_[j]*taus_[j]*laterRates;
+
+                laterRates += rateAdjoints[j]*newRates[j]*pseudoRoot_[j][f];
+            }
+        }
+    }
+
     
 }
 
@@ -129,6 +129,22 @@ namespace QuantLib
             const std::vector<Real>& gaussians,
             std::vector<Matrix>& B); // one Matrix for each rate, the elements of the matrix are the derivatives of that rate with respect to each pseudo-root element
 
+        /*! Adjoint of getBumps: given the sensitivities of a value to
+            the new rates, it returns the sensitivities of the value to
+            each pseudo-root element, i.e., the sum over j of
+            rateAdjoints[j]*B[j].  The Jacobian is never formed, so the
+            cost is proportional to the number of pseudo-root elements
+            rather than to the number of rates times that.
+
+            Used in the backward sweep of PathwiseVegasOuterAccountingEngine
+        */
+        void getVegas(const std::vector<Rate>& oldRates,
+            const std::vector<Real>& oneStepDFs,
+            const std::vector<Rate>& newRates,
+            const std::vector<Real>& gaussians,
+            const std::vector<Real>& rateAdjoints,
+            Matrix& vegas); // rates times factors
+
     private:
 
         //! this data does not change after construction
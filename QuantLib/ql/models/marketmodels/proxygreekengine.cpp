@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -81,7 +82,14 @@ namespace QuantLib {
     void ProxyGreekEngine::multiplePathValues(
                   SequenceStatisticsInc& stats,
                   std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
-                  Size numberOfPaths) {
+                  Size numberOfPaths,
+                  Size numberOfThreads) {
+        if (numberOfThreads > 1) {
+            parallelPathValues(stats, modifiedStats,
+                               numberOfPaths, numberOfThreads);
+            return;
+        }
+
         Size N = product_->numberOfProducts();
 
         std::vector<Real> values(N);
@@ -113,6 +121,76 @@ namespace QuantLib {
         }
     }
 
+    void ProxyGreekEngine::parallelPathValues(
+                  SequenceStatisticsInc& stats,
+                  std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                  Size numberOfPaths,
+                  Size numberOfThreads) {
+        // see AccountingEngine::multiplePathValues
+        std::vector<Size> firstPath(numberOfThreads+1);
+        for (Size k=0; k<=numberOfThreads; ++k)
+            firstPath[k] = (k*numberOfPaths)/numberOfThreads;
+        std::vector<boost::shared_ptr<ProxyGreekEngine> >
+                                                   engines(numberOfThreads);
+        for (Size k=0; k<numberOfThreads; ++k) {
+            boost::shared_ptr<MarketModelEvolver> evolver(
+                                         originalEvolver_->clone().release());
+            evolver->substream(firstPath[k], 1);
+            std::vector<std::vector<boost::shared_ptr<ConstrainedEvolver> > >
+                constrainedEvolvers(constrainedEvolvers_.size());
+            for (Size i=0; i<constrainedEvolvers_.size(); ++i) {
+                for (Size j=0; j<constrainedEvolvers_[i].size(); ++j) {
+                    boost::shared_ptr<MarketModelEvolver> e(
+                              constrainedEvolvers_[i][j]->clone().release());
+                    e->substream(firstPath[k], 1);
+                    constrainedEvolvers[i].push_back(
+                        boost::dynamic_pointer_cast<ConstrainedEvolver>(e));
+                    QL_REQUIRE(constrainedEvolvers[i].back(),
+                               "constrained evolver cloned "
+                               "into unconstrained one");
+                }
+            }
+            engines[k] = boost::shared_ptr<ProxyGreekEngine>(
+                new ProxyGreekEngine(evolver, constrainedEvolvers,
+                                     diffWeights_, startIndexOfConstraint_,
+                                     endIndexOfConstraint_, product_,
+                                     initialNumeraireValue_));
+        }
+        originalEvolver_->substream(numberOfPaths, 1);
+        for (Size i=0; i<constrainedEvolvers_.size(); ++i)
+            for (Size j=0; j<constrainedEvolvers_[i].size(); ++j)
+                constrainedEvolvers_[i][j]->substream(numberOfPaths, 1);
+
+        std::vector<SequenceStatisticsInc> partialStats(numberOfThreads);
+        std::vector<std::vector<std::vector<SequenceStatisticsInc> > >
+            partialModifiedStats(numberOfThreads);
+        for (Size k=0; k<numberOfThreads; ++k) {
+            partialModifiedStats[k].resize(modifiedStats.size());
+            for (Size j=0; j<modifiedStats.size(); ++j)
+                partialModifiedStats[k][j].resize(modifiedStats[j].size());
+        }
+        std::vector<std::string> messages(numberOfThreads);
+        #pragma omp parallel for
+        for (long k=0; k<long(numberOfThreads); ++k) {
+            try {
+                engines[k]->multiplePathValues(partialStats[k],
+                                               partialModifiedStats[k],
+                                               firstPath[k+1]-firstPath[k]);
+            } catch (std::exception& e) {
+                messages[k] = e.what();
+            } catch (...) {
+                messages[k] = "unknown error";
+            }
+        }
+        for (Size k=0; k<numberOfThreads; ++k) {
+            QL_REQUIRE(messages[k].empty(), messages[k]);
+            stats.merge(partialStats[k]);
+            for (Size j=0; j<modifiedStats.size(); ++j)
+                for (Size l=0; l<modifiedStats[j].size(); ++l)
+                    modifiedStats[j][l].merge(partialModifiedStats[k][j][l]);
+        }
+    }
+
     void ProxyGreekEngine::singleEvolverValues(MarketModelEvolver& evolver,
                                                std::vector<Real>& values,
                                                bool storeRates) {
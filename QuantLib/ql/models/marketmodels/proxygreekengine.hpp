@@ -46,14 +46,24 @@ namespace QuantLib {
             const std::vector<Size>& endIndexOfConstraint,
             const Clone<MarketModelMultiProduct>& product,
             Real initialNumeraireValue);
+        /*! \sa AccountingEngine::multiplePathValues for the use of
+                several threads; all the evolvers are moved to the
+                same substreams.
+        */
         void multiplePathValues(
                   SequenceStatisticsInc& stats,
                   std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
-                  Size numberOfPaths);
+                  Size numberOfPaths,
+                  Size numberOfThreads = 1);
         void singlePathValues(
                 std::vector<Real>& values,
                 std::vector<std::vector<std::vector<Real> > >& modifiedValues);
       private:
+        void parallelPathValues(
+                  SequenceStatisticsInc& stats,
+                  std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                  Size numberOfPaths,
+                  Size numberOfThreads);
         void singleEvolverValues(MarketModelEvolver& evolver,
                                  std::vector<Real>& values,
                                  bool storeRates = false);
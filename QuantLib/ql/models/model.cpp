@@ -22,17 +22,22 @@
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
+#include <ql/pricingengine.hpp>
+#include <set>
 
 namespace QuantLib {
 
     namespace {
         void no_deletion(CalibratedModel*) {}
+        // trees kept for a given parameter set
+        const Size cachedTreesSize = 100;
     }
 
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      concurrentCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -43,37 +48,83 @@ namespace QuantLib {
                   const std::vector<Real>& weights,
                   const Projection& projection)
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights), projection_(projection) { }
+          weights_(weights), projection_(projection),
+          parallel_(model->concurrentCalibration_
+                    && instruments.size() > 2) {
+            if (!parallel_)
+                return;
+            // engines store their arguments and results, hence each
+            // helper needs its own
+            std::set<PricingEngine*> engines;
+            for (Size i=0; i<instruments_.size(); ++i) {
+                PricingEngine* engine =
+                    instruments_[i]->pricingEngine().get();
+                QL_REQUIRE(engine != 0 && engines.insert(engine).second,
+                           "concurrent calibration requires a separate "
+                           "pricing engine for each helper");
+            }
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors();
             Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
-            for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
-            }
+            Array values = calibrationErrors();
+            for (Size i=0; i<instruments_.size(); i++)
+                values[i] *= std::sqrt(weights_[i]);
             return values;
         }
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> calibrationErrors() const {
+            const Size n = instruments_.size();
+            Array errors(n);
+            if (!parallel_) {
+                for (Size i=0; i<n; ++i)
+                    errors[i] = instruments_[i]->calibrationError();
+                return errors;
+            }
+
+            // The first helper is evaluated alone, so that any lazy
+            // calculation shared by the helpers (e.g., of the model
+            // or of the term structures) is done before the others
+            // are evaluated concurrently; see the thread-safety
+            // requirements in enableConcurrentCalibration().
+            errors[0] = instruments_[0]->calibrationError();
+
+            std::vector<std::string> messages(n);
+            #pragma omp parallel for
+            for (long i=1; i<long(n); ++i) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    messages[i] = e.what();
+                } catch (...) {
+                    messages[i] = "unknown error";
+                }
+            }
+            for (Size i=1; i<n; ++i)
+                QL_REQUIRE(messages[i].empty(), messages[i]);
+
+            return errors;
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments_;
         std::vector<Real> weights_;
         const Projection projection_;
+        bool parallel_;
     };
 
     void CalibratedModel::calibrate(
@@ -123,6 +174,10 @@ namespace QuantLib {
         return f.value(params);
     }
 
+    void CalibratedModel::enableConcurrentCalibration(bool flag) {
+        concurrentCalibration_ = flag;
+    }
+
     Disposable<Array> CalibratedModel::params() const {
         Size size = 0, i;
         for (i=0; i<arguments_.size(); i++)
@@ -153,4 +208,34 @@ namespace QuantLib {
     ShortRateModel::ShortRateModel(Size nArguments)
     : CalibratedModel(nArguments) {}
 
+    void ShortRateModel::update() {
+        cachedTrees_.clear();
+        CalibratedModel::update();
+    }
+
+    boost::shared_ptr<Lattice>
+    ShortRateModel::cachedTree(const TimeGrid& grid) const {
+        // the cached trees couldn't be shared safely among threads
+        if (concurrentCalibration_)
+            return tree(grid);
+
+        Array params = this->params();
+        if (params != cachedParams_) {
+            cachedTrees_.clear();
+            cachedParams_ = params;
+        }
+
+        std::vector<Time> times(grid.begin(), grid.end());
+        std::map<std::vector<Time>, boost::shared_ptr<Lattice> >::iterator i =
+            cachedTrees_.find(times);
+        if (i != cachedTrees_.end())
+            return i->second;
+
+        if (cachedTrees_.size() >= cachedTreesSize)
+            cachedTrees_.clear();
+        boost::shared_ptr<Lattice> lattice = tree(grid);
+        cachedTrees_[times] = lattice;
+        return lattice;
+    }
+
 }
@@ -31,6 +31,7 @@
 #include <ql/models/parameter.hpp>
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -117,11 +118,32 @@ namespace QuantLib {
 
         virtual void setParams(const Array& params);
 
+        //! enables the concurrent evaluation of the calibration helpers
+        /*! When enabled, and if the library was compiled with OpenMP
+            support, the helpers are priced concurrently at each
+            evaluation of the calibration cost function.  Each helper
+            must have its own pricing engine, which is checked by
+            calibrate().  The first helper is priced alone, so that
+            the lazy calculations of the model and of the term
+            structures are done before the others are priced.
+
+            \warning It is the responsibility of the user to enable
+                     this only if, after the first helper was priced,
+                     the pricing of a helper does not modify any object
+                     shared with the others.  This excludes, e.g.,
+                     models or engines with internal caches, as well
+                     as shared instruments, quotes or indexes whose
+                     values are set during the pricing.  Concurrent
+                     evaluation is disabled by default.
+        */
+        void enableConcurrentCalibration(bool flag = true);
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
         boost::shared_ptr<Constraint> constraint_;
         EndCriteria::Type shortRateEndCriteria_;
+        bool concurrentCalibration_;
 
       private:
         //! Constraint imposed on arguments
@@ -136,7 +158,25 @@ namespace QuantLib {
     class ShortRateModel : public CalibratedModel {
       public:
         ShortRateModel(Size nArguments);
+        void update();
         virtual boost::shared_ptr<Lattice> tree(const TimeGrid&) const = 0;
+        //! lattice on the given grid, shared among the callers
+        /*! The lattices returned by tree() are cached, keyed on the
+            current parameter values and on the times of the grid,
+            so that engines pricing instruments on the same grid
+            (e.g., calibration helpers, or a swaption, a cap and a
+            swap priced with tree engines) roll back on a single
+            lattice which is built once for each parameter set.  The
+            cache is emptied when the parameters change or when the
+            model is notified of a change, e.g., in its term
+            structure; it is bypassed when concurrent calibration is
+            enabled.
+        */
+        boost::shared_ptr<Lattice> cachedTree(const TimeGrid&) const;
+      private:
+        mutable Array cachedParams_;
+        mutable std::map<std::vector<Time>,
+                         boost::shared_ptr<Lattice> > cachedTrees_;
     };
 
     // inline definitions
@@ -28,6 +28,7 @@
 #include <ql/methods/lattices/bsmlattice.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/pricingengines/barrier/discretizedbarrieroption.hpp>
+#include <ql/pricingengines/blackscholessmoothing.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -41,6 +42,15 @@ namespace QuantLib {
               See Journal of Derivatives, 1/1994,
               "Bumping up against the barrier with the binomial method"
 
+        \note If smoothing is enabled, the values of the surviving
+              nodes one step before maturity are replaced by
+              Black-Scholes values (see blackScholesSmoothedValue),
+              which removes most of the oscillations of the value
+              with the number of steps.  This is only available for
+              knock-out options on plain-vanilla payoffs; with the
+              Derman-Kani correction, the smoothed values replace the
+              corrected ones at that step.
+
         \test the correctness of the returned values is tested by
               checking it against analytic european results.
     */
@@ -56,8 +66,10 @@ namespace QuantLib {
         BinomialBarrierEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps,
-             Size maxTimeSteps=0)
-        : process_(process), timeSteps_(timeSteps), maxTimeSteps_(maxTimeSteps) {
+             Size maxTimeSteps=0,
+             bool smoothing=false)
+        : process_(process), timeSteps_(timeSteps), maxTimeSteps_(maxTimeSteps),
+          smoothing_(smoothing) {
             QL_REQUIRE(timeSteps>0,
                        "timeSteps must be positive, " << timeSteps <<
                        " not allowed");
@@ -74,6 +86,7 @@ namespace QuantLib {
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_;
         Size maxTimeSteps_;
+        bool smoothing_;
     };
 
 
@@ -155,6 +168,39 @@ namespace QuantLib {
         D option(arguments_, *process_, grid);
         option.initialize(lattice, maturity);
 
+        if (smoothing_) {
+            boost::shared_ptr<PlainVanillaPayoff> vanillaPayoff =
+                boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoff);
+            QL_REQUIRE(vanillaPayoff,
+                       "smoothing requires a plain-vanilla payoff");
+            const Barrier::Type type = arguments_.barrierType;
+            QL_REQUIRE(type == Barrier::DownOut || type == Barrier::UpOut,
+                       "smoothing only available for knock-out barriers");
+
+            // replace the last step by the Black-Scholes values
+            const Size i = optimum_steps-1;
+            option.rollback(grid[i]);
+
+            const bool exercisable =
+                arguments_.exercise->type() == Exercise::American
+                && grid.closestTime(process_->time(
+                           arguments_.exercise->date(0))) <= grid[i];
+
+            Array& values = option.values();
+            for (Size j=0; j<values.size(); ++j) {
+                const Real s = lattice->underlying(i, j);
+                if ((type == Barrier::DownOut && s <= arguments_.barrier) ||
+                    (type == Barrier::UpOut && s >= arguments_.barrier))
+                    continue; // knocked out
+                values[j] = blackScholesSmoothedValue(
+                                  *vanillaPayoff, type, arguments_.barrier,
+                                  arguments_.rebate, s, r, q, v,
+                                  maturity-grid[i]);
+                if (exercisable)
+                    values[j] = std::max(values[j], (*payoff)(s));
+            }
+        }
+
         // Partial derivatives calculated from various points in the
         // binomial tree 
         // (see J.C.Hull, "Options, Futures and other derivatives", 6th edition, pp 397/398)
@@ -29,6 +29,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholesmultistrikesolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesrebateengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -49,6 +50,31 @@ namespace QuantLib {
 
     void FdBlackScholesBarrierEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
+            const DividendBarrierOption::arguments& args
+                                            = cachedArgs2results_[i].first;
+            if (   args.barrierType == arguments_.barrierType
+                && args.barrier == arguments_.barrier
+                && args.rebate == arguments_.rebate
+                && args.exercise->type() == arguments_.exercise->type()
+                && args.exercise->dates() == arguments_.exercise->dates()
+                && sameDividends(args.cashFlow, arguments_.cashFlow)) {
+                boost::shared_ptr<PlainVanillaPayoff> p1 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                boost::shared_ptr<PlainVanillaPayoff> p2 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                                args.payoff);
+
+                if (p1 && p2 && p1->strike() == p2->strike()
+                       && p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2results_[i].second;
+                    return;
+                }
+            }
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -118,6 +144,120 @@ namespace QuantLib {
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
                                      maturity, tGrid_, dampingSteps_ };
 
+        const boost::shared_ptr<PlainVanillaPayoff> plainPayoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        std::vector<Real> strikes(1, payoff->strike());
+        strikes.insert(strikes.end(), strikes_.begin(), strikes_.end());
+
+        // a strike-dependent volatility needs one solve per strike
+        if (   !strikes_.empty() && plainPayoff
+            && FdmBlackScholesMultiStrikeSolver::isStrikeIndependent(
+                                    process_, maturity, strikes, localVol_)) {
+            // 5.1 a strip of strikes, rolled back in a single solve
+            std::vector<FdmSolverDesc> solverDescs(1, solverDesc);
+            for (Size i=0; i < strikes_.size(); ++i) {
+                const FdmSolverDesc desc = {
+                    mesher, boundaries, conditions,
+                    boost::shared_ptr<FdmInnerValueCalculator>(
+                        new FdmLogInnerValue(
+                            boost::shared_ptr<Payoff>(new PlainVanillaPayoff(
+                                    plainPayoff->optionType(), strikes_[i])),
+                            mesher, 0)),
+                    maturity, tGrid_, dampingSteps_ };
+                solverDescs.push_back(desc);
+            }
+
+            const FdmBlackScholesMultiStrikeSolver solver(
+                             Handle<GeneralizedBlackScholesProcess>(process_),
+                             payoff->strike(), solverDescs, schemeDesc_,
+                             localVol_, illegalLocalVolOverwrite_);
+
+            std::vector<DividendBarrierOption::results> results(
+                                                               strikes.size());
+            const Real spot = process_->x0();
+            for (Size i=0; i < strikes.size(); ++i) {
+                results[i].reset();
+                results[i].value = solver.valueAt(i, spot);
+                results[i].delta = solver.deltaAt(i, spot);
+                results[i].gamma = solver.gammaAt(i, spot);
+                results[i].theta = solver.thetaAt(i, spot);
+            }
+
+            // 5.2 in-barriers from the vanilla strip and the rebate
+            if (   arguments_.barrierType == Barrier::DownIn
+                || arguments_.barrierType == Barrier::UpIn) {
+                const boost::shared_ptr<FdBlackScholesVanillaEngine>
+                    vanillaEngine(new FdBlackScholesVanillaEngine(
+                        process_, tGrid_, xGrid_,
+                        0, // dampingSteps
+                        schemeDesc_, localVol_, illegalLocalVolOverwrite_));
+                vanillaEngine->enableMultipleStrikesCaching(strikes_);
+
+                boost::shared_ptr<DividendBarrierOption> rebateOption(
+                    new DividendBarrierOption(arguments_.barrierType,
+                                              arguments_.barrier,
+                                              arguments_.rebate,
+                                              payoff, arguments_.exercise,
+                                              dividendCondition->dividendDates(),
+                                              dividendCondition->dividends()));
+
+                const Size min_grid_size = 50;
+                const Size rebateDampingSteps
+                    = (dampingSteps_ > 0) ? std::min(Size(1), dampingSteps_/2)
+                                          : 0;
+
+                rebateOption->setPricingEngine(
+                    boost::shared_ptr<PricingEngine>(
+                        new FdBlackScholesRebateEngine(
+                            process_, tGrid_,
+                            std::max(min_grid_size, xGrid_/5),
+                            rebateDampingSteps, schemeDesc_, localVol_,
+                            illegalLocalVolOverwrite_)));
+
+                for (Size i=0; i < strikes.size(); ++i) {
+                    // the first option fills the cache of the engine
+                    DividendVanillaOption vanillaOption(
+                        boost::shared_ptr<StrikedTypePayoff>(
+                            new PlainVanillaPayoff(plainPayoff->optionType(),
+                                                   strikes[i])),
+                        arguments_.exercise,
+                        dividendCondition->dividendDates(),
+                        dividendCondition->dividends());
+                    vanillaOption.setPricingEngine(vanillaEngine);
+
+                    results[i].value = vanillaOption.NPV()
+                        + rebateOption->NPV() - results[i].value;
+                    results[i].delta = vanillaOption.delta()
+                        + rebateOption->delta() - results[i].delta;
+                    results[i].gamma = vanillaOption.gamma()
+                        + rebateOption->gamma() - results[i].gamma;
+                    results[i].theta = vanillaOption.theta()
+                        + rebateOption->theta() - results[i].theta;
+                }
+            }
+
+            results_.value = results[0].value;
+            results_.delta = results[0].delta;
+            results_.gamma = results[0].gamma;
+            results_.theta = results[0].theta;
+
+            cachedArgs2results_.resize(strikes_.size());
+            for (Size i=0; i < strikes_.size(); ++i) {
+                DividendBarrierOption::arguments& args
+                                            = cachedArgs2results_[i].first;
+                args.barrierType = arguments_.barrierType;
+                args.barrier = arguments_.barrier;
+                args.rebate = arguments_.rebate;
+                args.exercise = arguments_.exercise;
+                args.cashFlow = arguments_.cashFlow;
+                args.payoff = boost::shared_ptr<PlainVanillaPayoff>(
+                    new PlainVanillaPayoff(plainPayoff->optionType(),
+                                           strikes_[i]));
+                cachedArgs2results_[i].second = results[i+1];
+            }
+            return;
+        }
+
         boost::shared_ptr<FdmBlackScholesSolver> solver(
                 new FdmBlackScholesSolver(
                                Handle<GeneralizedBlackScholesProcess>(process_),
@@ -179,4 +319,15 @@ namespace QuantLib {
                                                     - results_.theta;
         }
     }
+
+    void FdBlackScholesBarrierEngine::update() {
+        cachedArgs2results_.clear();
+        DividendBarrierOption::engine::update();
+    }
+
+    void FdBlackScholesBarrierEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
 }
@@ -37,6 +37,17 @@ namespace QuantLib {
     /*!
         \ingroup barrierengines
 
+        If multiple-strikes caching is enabled, the options with
+        the given strikes (and the same barrier, rebate, exercise,
+        option type and dividends as the option being priced) are
+        rolled back in a single finite-difference solve and their
+        results are cached.
+
+        The strip shares a single operator, which requires the
+        volatility not to depend on the strike; with a
+        strike-dependent Black volatility the options are priced
+        one by one and nothing is cached.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
@@ -53,12 +64,21 @@ namespace QuantLib {
 
         void calculate() const;
 
+        // multiple strikes caching engine
+        void update();
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendBarrierOption::arguments,
+                                      DividendBarrierOption::results> >
+                                                            cachedArgs2results_;
     };
 
 
@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/blackscholessmoothing.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+
+namespace QuantLib {
+
+    Real blackScholesSmoothedValue(const PlainVanillaPayoff& payoff,
+                                   Real underlying,
+                                   Rate r, Rate q,
+                                   Volatility v, Time dt) {
+        const Real forward = underlying*std::exp((r-q)*dt);
+        return blackFormula(payoff.optionType(), payoff.strike(), forward,
+                            v*std::sqrt(dt), std::exp(-r*dt));
+    }
+
+    Real blackScholesSmoothedValue(const PlainVanillaPayoff& payoff,
+                                   Barrier::Type barrierType,
+                                   Real barrier, Real rebate,
+                                   Real underlying,
+                                   Rate r, Rate q,
+                                   Volatility v, Time dt) {
+        const Real forward = underlying*std::exp((r-q)*dt);
+        const Real stdDev = v*std::sqrt(dt);
+        const DiscountFactor discount = std::exp(-r*dt);
+        const Real strike = payoff.strike();
+
+        // probability of ending above the barrier
+        const Real above = blackFormulaCashItmProbability(
+                                   Option::Call, barrier, forward, stdDev);
+
+        // the payoff restricted to the surviving region is split into
+        // plain and cash-or-nothing options struck at the barrier
+        Real alive;
+        Probability knockedOut;
+        switch (barrierType) {
+          case Barrier::DownOut:
+            knockedOut = 1.0 - above;
+            if (payoff.optionType() == Option::Call) {
+                const Real k = std::max(strike, barrier);
+                alive = blackFormula(Option::Call, k, forward,
+                                     stdDev, discount)
+                    + (k-strike)*discount*blackFormulaCashItmProbability(
+                                      Option::Call, k, forward, stdDev);
+            } else if (barrier < strike) {
+                alive = blackFormula(Option::Put, strike, forward,
+                                     stdDev, discount)
+                    - blackFormula(Option::Put, barrier, forward,
+                                   stdDev, discount)
+                    - (strike-barrier)*discount*knockedOut;
+            } else {
+                alive = 0.0;
+            }
+            break;
+          case Barrier::UpOut:
+            knockedOut = above;
+            if (payoff.optionType() == Option::Put) {
+                const Real k = std::min(strike, barrier);
+                alive = blackFormula(Option::Put, k, forward,
+                                     stdDev, discount)
+                    + (strike-k)*discount*blackFormulaCashItmProbability(
+                                       Option::Put, k, forward, stdDev);
+            } else if (barrier > strike) {
+                alive = blackFormula(Option::Call, strike, forward,
+                                     stdDev, discount)
+                    - blackFormula(Option::Call, barrier, forward,
+                                   stdDev, discount)
+                    - (barrier-strike)*discount*knockedOut;
+            } else {
+                alive = 0.0;
+            }
+            break;
+          default:
+            QL_FAIL("smoothing only available for knock-out barriers");
+        }
+
+        return alive + rebate*discount*knockedOut;
+    }
+
+}
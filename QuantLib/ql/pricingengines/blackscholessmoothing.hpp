@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackscholessmoothing.hpp
+    \brief Black-Scholes smoothing of the last step of binomial trees
+*/
+
+#ifndef quantlib_black_scholes_smoothing_hpp
+#define quantlib_black_scholes_smoothing_hpp
+
+#include <ql/instruments/barriertype.hpp>
+#include <ql/instruments/payoffs.hpp>
+
+namespace QuantLib {
+
+    //! Black-Scholes value of a payoff over the last step of a tree
+    /*! Returns the discounted expectation of the payoff at the end of
+        a step of length dt starting at the given underlying value,
+        with the lognormal distribution replacing the binomial one.
+        Using it for the nodes one step before maturity removes most
+        of the oscillations of the binomial value with the number of
+        steps (Broadie and Detemple, "American option valuation: new
+        bounds, approximations, and a comparison of existing methods",
+        Review of Financial Studies 9, 1996).
+    */
+    Real blackScholesSmoothedValue(const PlainVanillaPayoff& payoff,
+                                   Real underlying,
+                                   Rate r, Rate q,
+                                   Volatility v, Time dt);
+
+    //! Black-Scholes value of a knock-out payoff over the last step
+    /*! As above, with the barrier checked at the end of the step as
+        on the tree; knocked-out paths pay the rebate.
+    */
+    Real blackScholesSmoothedValue(const PlainVanillaPayoff& payoff,
+                                   Barrier::Type barrierType,
+                                   Real barrier, Real rebate,
+                                   Real underlying,
+                                   Rate r, Rate q,
+                                   Volatility v, Time dt);
+
+}
+
+
+#endif
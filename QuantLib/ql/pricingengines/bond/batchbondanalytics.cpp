@@ -0,0 +1,523 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/bond/batchbondanalytics.hpp>
+#include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/instruments/bond.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/math/comparison.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+using boost::shared_ptr;
+
+namespace QuantLib {
+
+    namespace {
+
+        // Compounding conventions.  The calculations are templated on
+        // these, so that the convention is selected once per batch
+        // rather than once per cash flow.
+
+        class SimpleRates {
+          public:
+            Real compoundFactor(Rate r, Time t) const {
+                return 1.0 + r*t;
+            }
+            // d(log compoundFactor)/dr
+            Real logDerivative(Rate r, Time t) const {
+                return t/(1.0 + r*t);
+            }
+        };
+
+        class CompoundedRates {
+          public:
+            explicit CompoundedRates(Frequency f) : f_(f) {}
+            Real compoundFactor(Rate r, Time t) const {
+                return std::pow(1.0+r/f_, f_*t);
+            }
+            Real logDerivative(Rate r, Time t) const {
+                return t/(1.0+r/f_);
+            }
+          private:
+            Real f_;
+        };
+
+        class ContinuousRates {
+          public:
+            Real compoundFactor(Rate r, Time t) const {
+                return std::exp(r*t);
+            }
+            Real logDerivative(Rate, Time t) const {
+                return t;
+            }
+        };
+
+        class SimpleThenCompoundedRates {
+          public:
+            explicit SimpleThenCompoundedRates(Frequency f) : f_(f) {}
+            Real compoundFactor(Rate r, Time t) const {
+                if (t<=1.0/f_)
+                    return 1.0 + r*t;
+                else
+                    return std::pow(1.0+r/f_, f_*t);
+            }
+            Real logDerivative(Rate r, Time t) const {
+                if (t<=1.0/f_)
+                    return t/(1.0 + r*t);
+                else
+                    return t/(1.0+r/f_);
+            }
+          private:
+            Real f_;
+        };
+
+    }
+
+    BatchBondAnalytics::BatchBondAnalytics(
+                           const std::vector<shared_ptr<Bond> >& bonds,
+                           const DayCounter& dayCounter,
+                           Compounding compounding,
+                           Frequency frequency,
+                           Date settlementDate)
+    : bonds_(bonds), dayCounter_(dayCounter),
+      compounding_(compounding), frequency_(frequency),
+      settlementDates_(bonds.size()),
+      accruedAmounts_(bonds.size()), notionals_(bonds.size()),
+      first_(bonds.size()+1, 0),
+      yields_(bonds.size(), Null<Rate>()),
+      zSpreads_(bonds.size(), Null<Spread>()) {
+
+        QL_REQUIRE(compounding_ == Simple || compounding_ == Continuous ||
+                   frequency_ != Once, "frequency not allowed "
+                   "for this compounding convention");
+
+        for (Size i=0; i<bonds_.size(); ++i) {
+            const Bond& bond = *bonds_[i];
+            Date settlement = settlementDate;
+            if (settlement == Date())
+                settlement = bond.settlementDate();
+
+            QL_REQUIRE(BondFunctions::isTradable(bond, settlement),
+                       "non tradable at " << settlement <<
+                       " (maturity being " << bond.maturityDate() << ")");
+
+            settlementDates_[i] = settlement;
+            accruedAmounts_[i] = bond.accruedAmount(settlement);
+            notionals_[i] = bond.notional(settlement);
+
+            // same logic as CashFlows::npv with a flat yield
+            const Leg& leg = bond.cashflows();
+            Date lastDate = settlement;
+            Date refStartDate, refEndDate;
+            for (Size j=0; j<leg.size(); ++j) {
+                if (leg[j]->hasOccurred(settlement, false))
+                    continue;
+
+                Date couponDate = leg[j]->date();
+                Real amount = leg[j]->amount();
+                if (leg[j]->tradingExCoupon(settlement))
+                    amount = 0.0;
+
+                shared_ptr<Coupon> coupon =
+                    boost::dynamic_pointer_cast<Coupon>(leg[j]);
+                if (coupon) {
+                    refStartDate = coupon->referencePeriodStart();
+                    refEndDate = coupon->referencePeriodEnd();
+                } else {
+                    if (lastDate == settlement) {
+                        // we don't have a previous coupon date,
+                        // so we fake it
+                        refStartDate = couponDate - 1*Years;
+                    } else  {
+                        refStartDate = lastDate;
+                    }
+                    refEndDate = couponDate;
+                }
+
+                amounts_.push_back(amount);
+                periods_.push_back(dayCounter_.yearFraction(lastDate,
+                                                            couponDate,
+                                                            refStartDate,
+                                                            refEndDate));
+                dates_.push_back(couponDate);
+                lastDate = couponDate;
+            }
+            first_[i+1] = amounts_.size();
+        }
+    }
+
+    inline Real BatchBondAnalytics::dirtyPrice(Size i,
+                                               Real cleanPrice) const {
+        // normalized as in BondFunctions
+        return (cleanPrice + accruedAmounts_[i]) / (100.0 / notionals_[i]);
+    }
+
+    // Newton iterations in lockstep; converged bonds are removed
+    // from the active set, diverging ones are moved to the failed set
+
+    template <class Rates>
+    void BatchBondAnalytics::solveYields(const Rates& rates,
+                                         const std::vector<Real>& targets,
+                                         std::vector<Size>& active,
+                                         std::vector<Size>& failed,
+                                         Real accuracy,
+                                         Size maxIterations) {
+        for (Size k=0; k<maxIterations && !active.empty(); ++k) {
+            Size m = 0;
+            for (Size a=0; a<active.size(); ++a) {
+                Size i = active[a];
+                Rate y = yields_[i];
+                Real npv = 0.0, dNpv = 0.0;
+                DiscountFactor discount = 1.0;
+                Real logDiscountDerivative = 0.0;
+                for (Size j=first_[i]; j<first_[i+1]; ++j) {
+                    discount /= rates.compoundFactor(y, periods_[j]);
+                    logDiscountDerivative -=
+                        rates.logDerivative(y, periods_[j]);
+                    npv += amounts_[j] * discount;
+                    dNpv += amounts_[j] * discount * logDiscountDerivative;
+                }
+                Real dy = (npv - targets[i]) / dNpv;
+                y -= dy;
+                if (!boost::math::isfinite(y) ||
+                    !(rates.compoundFactor(y, 1.0) > 0.0)) {
+                    failed.push_back(i);
+                } else {
+                    yields_[i] = y;
+                    if (std::fabs(dy) >= accuracy)
+                        active[m++] = i;
+                }
+            }
+            active.resize(m);
+        }
+    }
+
+    template <class Rates>
+    void BatchBondAnalytics::solveZSpreads(
+                                const Rates& rates,
+                                const std::vector<Real>& targets,
+                                const std::vector<Time>& times,
+                                const std::vector<Rate>& zeros,
+                                const std::vector<Time>& settlementTimes,
+                                const std::vector<Rate>& settlementZeros,
+                                std::vector<Size>& active,
+                                std::vector<Size>& failed,
+                                Real accuracy,
+                                Size maxIterations) {
+        for (Size k=0; k<maxIterations && !active.empty(); ++k) {
+            Size m = 0;
+            for (Size a=0; a<active.size(); ++a) {
+                Size i = active[a];
+                Spread s = zSpreads_[i];
+                Real npv = 0.0, dNpv = 0.0;
+                for (Size j=first_[i]; j<first_[i+1]; ++j) {
+                    Rate r = zeros[j] + s;
+                    DiscountFactor B = 1.0/rates.compoundFactor(r, times[j]);
+                    npv += amounts_[j] * B;
+                    dNpv -= amounts_[j] * B * rates.logDerivative(r, times[j]);
+                }
+                // forward to the settlement date
+                Rate r = settlementZeros[i] + s;
+                Real C = rates.compoundFactor(r, settlementTimes[i]);
+                dNpv = (dNpv +
+                        npv*rates.logDerivative(r, settlementTimes[i])) * C;
+                npv *= C;
+
+                Real ds = (npv - targets[i]) / dNpv;
+                s -= ds;
+                if (!boost::math::isfinite(s)) {
+                    failed.push_back(i);
+                } else {
+                    zSpreads_[i] = s;
+                    if (std::fabs(ds) >= accuracy)
+                        active[m++] = i;
+                }
+            }
+            active.resize(m);
+        }
+    }
+
+    template <class Rates>
+    void BatchBondAnalytics::calculatePrices(
+                                        const Rates& rates,
+                                        const std::vector<Rate>& yields,
+                                        std::vector<Real>& result) const {
+        for (Size i=0; i<result.size(); ++i) {
+            Real npv = 0.0;
+            DiscountFactor discount = 1.0;
+            for (Size j=first_[i]; j<first_[i+1]; ++j) {
+                discount /= rates.compoundFactor(yields[i], periods_[j]);
+                npv += amounts_[j] * discount;
+            }
+            result[i] = npv * 100.0 / notionals_[i] - accruedAmounts_[i];
+        }
+    }
+
+    template <class Rates>
+    void BatchBondAnalytics::calculateDurations(
+                                        const Rates& rates,
+                                        const std::vector<Rate>& yields,
+                                        Duration::Type type,
+                                        std::vector<Time>& result) const {
+        // same conventions as in CashFlows::duration, i.e., the
+        // discount factors are calculated on cumulated times
+        for (Size i=0; i<result.size(); ++i) {
+            Rate y = yields[i];
+            Real P = 0.0, dPdy = 0.0;
+            Time t = 0.0;
+            for (Size j=first_[i]; j<first_[i+1]; ++j) {
+                t += periods_[j];
+                DiscountFactor B = 1.0/rates.compoundFactor(y, t);
+                P += amounts_[j] * B;
+                if (type == Duration::Simple)
+                    dPdy += t * amounts_[j] * B;
+                else
+                    dPdy -= amounts_[j] * B * rates.logDerivative(y, t);
+            }
+            if (P == 0.0) {
+                result[i] = 0.0;
+            } else {
+                switch (type) {
+                  case Duration::Simple:
+                    result[i] = dPdy/P;
+                    break;
+                  case Duration::Modified:
+                    result[i] = -dPdy/P;
+                    break;
+                  case Duration::Macaulay:
+                    result[i] = (1.0+y/frequency_) * (-dPdy/P);
+                    break;
+                  default:
+                    QL_FAIL("unknown duration type");
+                }
+            }
+        }
+    }
+
+    const std::vector<Rate>& BatchBondAnalytics::yields(
+                                         const std::vector<Real>& cleanPrices,
+                                         Real accuracy,
+                                         Size maxIterations) {
+        Size n = bonds_.size();
+        QL_REQUIRE(cleanPrices.size() == n,
+                   "wrong number of prices (" << cleanPrices.size() <<
+                   ") given for " << n << " bonds");
+
+        std::vector<Real> targets(n);
+        std::vector<Rate> guesses(n);
+        std::vector<Size> active;
+        active.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            targets[i] = dirtyPrice(i, cleanPrices[i]);
+            guesses[i] = (yields_[i] == Null<Rate>() ? 0.05 : yields_[i]);
+            yields_[i] = guesses[i];
+            active.push_back(i);
+        }
+
+        std::vector<Size> failed;
+        switch (compounding_) {
+          case Simple:
+            solveYields(SimpleRates(), targets, active, failed,
+                        accuracy, maxIterations);
+            break;
+          case Compounded:
+            solveYields(CompoundedRates(frequency_), targets, active, failed,
+                        accuracy, maxIterations);
+            break;
+          case Continuous:
+            solveYields(ContinuousRates(), targets, active, failed,
+                        accuracy, maxIterations);
+            break;
+          case SimpleThenCompounded:
+            solveYields(SimpleThenCompoundedRates(frequency_), targets,
+                        active, failed, accuracy, maxIterations);
+            break;
+          default:
+            QL_FAIL("unknown compounding convention");
+        }
+        failed.insert(failed.end(), active.begin(), active.end());
+
+        for (Size a=0; a<failed.size(); ++a) {
+            Size i = failed[a];
+            yields_[i] = BondFunctions::yield(*bonds_[i], cleanPrices[i],
+                                              dayCounter_, compounding_,
+                                              frequency_,
+                                              settlementDates_[i],
+                                              accuracy, maxIterations,
+                                              guesses[i]);
+        }
+
+        return yields_;
+    }
+
+    std::vector<Real> BatchBondAnalytics::cleanPrices(
+                                     const std::vector<Rate>& yields) const {
+        Size n = bonds_.size();
+        QL_REQUIRE(yields.size() == n,
+                   "wrong number of yields (" << yields.size() <<
+                   ") given for " << n << " bonds");
+
+        std::vector<Real> result(n);
+        switch (compounding_) {
+          case Simple:
+            calculatePrices(SimpleRates(), yields, result);
+            break;
+          case Compounded:
+            calculatePrices(CompoundedRates(frequency_), yields, result);
+            break;
+          case Continuous:
+            calculatePrices(ContinuousRates(), yields, result);
+            break;
+          case SimpleThenCompounded:
+            calculatePrices(SimpleThenCompoundedRates(frequency_),
+                            yields, result);
+            break;
+          default:
+            QL_FAIL("unknown compounding convention");
+        }
+        return result;
+    }
+
+    std::vector<Time> BatchBondAnalytics::durations(
+                                           const std::vector<Rate>& yields,
+                                           Duration::Type type) const {
+        Size n = bonds_.size();
+        QL_REQUIRE(yields.size() == n,
+                   "wrong number of yields (" << yields.size() <<
+                   ") given for " << n << " bonds");
+        QL_REQUIRE(type != Duration::Macaulay || compounding_ == Compounded,
+                   "compounded rate required");
+
+        std::vector<Time> result(n);
+        switch (compounding_) {
+          case Simple:
+            calculateDurations(SimpleRates(), yields, type, result);
+            break;
+          case Compounded:
+            calculateDurations(CompoundedRates(frequency_), yields, type,
+                               result);
+            break;
+          case Continuous:
+            calculateDurations(ContinuousRates(), yields, type, result);
+            break;
+          case SimpleThenCompounded:
+            calculateDurations(SimpleThenCompoundedRates(frequency_),
+                               yields, type, result);
+            break;
+          default:
+            QL_FAIL("unknown compounding convention");
+        }
+        return result;
+    }
+
+    const std::vector<Spread>& BatchBondAnalytics::zSpreads(
+                            const std::vector<Real>& cleanPrices,
+                            const shared_ptr<YieldTermStructure>& curve,
+                            Real accuracy,
+                            Size maxIterations) {
+        Size n = bonds_.size();
+        QL_REQUIRE(cleanPrices.size() == n,
+                   "wrong number of prices (" << cleanPrices.size() <<
+                   ") given for " << n << " bonds");
+
+        // times and zero rates on the curve; the spreaded discount
+        // factors are then 1/compoundFactor(z+s, t) as in
+        // ZeroSpreadedTermStructure, which also extrapolates the
+        // underlying curve
+        std::vector<Time> times(dates_.size());
+        std::vector<Rate> zeros(dates_.size());
+        std::vector<Time> settlementTimes(n);
+        std::vector<Rate> settlementZeros(n);
+        for (Size j=0; j<dates_.size(); ++j) {
+            times[j] = curve->timeFromReference(dates_[j]);
+            zeros[j] = curve->zeroRate(times[j], compounding_, frequency_,
+                                       true);
+        }
+        std::vector<Real> targets(n);
+        std::vector<Spread> guesses(n);
+        std::vector<Size> active;
+        active.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            settlementTimes[i] =
+                curve->timeFromReference(settlementDates_[i]);
+            settlementZeros[i] =
+                curve->zeroRate(settlementTimes[i], compounding_, frequency_,
+                                true);
+            targets[i] = dirtyPrice(i, cleanPrices[i]);
+            guesses[i] = (zSpreads_[i] == Null<Spread>() ? 0.0 : zSpreads_[i]);
+            zSpreads_[i] = guesses[i];
+            active.push_back(i);
+        }
+
+        std::vector<Size> failed;
+        switch (compounding_) {
+          case Simple:
+            solveZSpreads(SimpleRates(), targets, times, zeros,
+                          settlementTimes, settlementZeros, active, failed,
+                          accuracy, maxIterations);
+            break;
+          case Compounded:
+            solveZSpreads(CompoundedRates(frequency_), targets, times, zeros,
+                          settlementTimes, settlementZeros, active, failed,
+                          accuracy, maxIterations);
+            break;
+          case Continuous:
+            solveZSpreads(ContinuousRates(), targets, times, zeros,
+                          settlementTimes, settlementZeros, active, failed,
+                          accuracy, maxIterations);
+            break;
+          case SimpleThenCompounded:
+            solveZSpreads(SimpleThenCompoundedRates(frequency_), targets,
+                          times, zeros, settlementTimes, settlementZeros,
+                          active, failed, accuracy, maxIterations);
+            break;
+          default:
+            QL_FAIL("unknown compounding convention");
+        }
+        failed.insert(failed.end(), active.begin(), active.end());
+
+        for (Size a=0; a<failed.size(); ++a) {
+            Size i = failed[a];
+            zSpreads_[i] = BondFunctions::zSpread(*bonds_[i], cleanPrices[i],
+                                                  curve, dayCounter_,
+                                                  compounding_, frequency_,
+                                                  settlementDates_[i],
+                                                  accuracy, maxIterations,
+                                                  guesses[i]);
+        }
+
+        return zSpreads_;
+    }
+
+    void BatchBondAnalytics::setYieldGuesses(
+                                        const std::vector<Rate>& guesses) {
+        QL_REQUIRE(guesses.size() == bonds_.size(),
+                   "wrong number of guesses (" << guesses.size() <<
+                   ") given for " << bonds_.size() << " bonds");
+        yields_ = guesses;
+    }
+
+    void BatchBondAnalytics::setZSpreadGuesses(
+                                       const std::vector<Spread>& guesses) {
+        QL_REQUIRE(guesses.size() == bonds_.size(),
+                   "wrong number of guesses (" << guesses.size() <<
+                   ") given for " << bonds_.size() << " bonds");
+        zSpreads_ = guesses;
+    }
+
+}
@@ -0,0 +1,154 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchbondanalytics.hpp
+    \brief yield, duration and z-spread calculations on sets of bonds
+*/
+
+#ifndef quantlib_batch_bond_analytics_hpp
+#define quantlib_batch_bond_analytics_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/compounding.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class Bond;
+    class YieldTermStructure;
+
+    //! Batch bond analytics
+    /*! This class calculates yields, durations and z-spreads for a
+        set of bonds.  The cash flows of each bond are flattened
+        once, at construction, into contiguous arrays of accrual
+        times and amounts; the solvers then run Newton iterations in
+        lockstep on all the bonds, without virtual calls or
+        InterestRate temporaries in the inner loops.
+
+        The results of each solve are stored and used as starting
+        points for the next one, so that repeated calculations after
+        small price moves converge in a couple of iterations.  Bonds
+        for which Newton's method fails to converge are solved with
+        the corresponding BondFunctions method; therefore, results
+        are the same as those of the scalar functions within the
+        required accuracy.
+
+        \warning the cash flows are flattened at construction; if
+                 their amounts change (e.g., for floating-rate bonds
+                 after a change in the forecasting curve) a new
+                 instance must be created.
+
+        \test results are checked against the corresponding
+              BondFunctions methods.
+    */
+    class BatchBondAnalytics {
+      public:
+        /*! Unless a settlement date is passed, the settlement date
+            of each bond is used.
+        */
+        BatchBondAnalytics(
+                     const std::vector<boost::shared_ptr<Bond> >& bonds,
+                     const DayCounter& dayCounter,
+                     Compounding compounding,
+                     Frequency frequency,
+                     Date settlementDate = Date());
+        //! \name Inspectors
+        //@{
+        Size size() const { return bonds_.size(); }
+        const std::vector<Rate>& lastYields() const { return yields_; }
+        const std::vector<Spread>& lastZSpreads() const {
+            return zSpreads_;
+        }
+        //@}
+        //! \name Calculations
+        //@{
+        //! yields implied by the given clean prices
+        const std::vector<Rate>& yields(const std::vector<Real>& cleanPrices,
+                                        Real accuracy = 1.0e-10,
+                                        Size maxIterations = 100);
+        //! clean prices implied by the given yields
+        std::vector<Real> cleanPrices(const std::vector<Rate>& yields) const;
+        //! durations at the given yields
+        std::vector<Time> durations(const std::vector<Rate>& yields,
+                                    Duration::Type type =
+                                                  Duration::Modified) const;
+        //! z-spreads over the given curve implied by the clean prices
+        const std::vector<Spread>& zSpreads(
+                     const std::vector<Real>& cleanPrices,
+                     const boost::shared_ptr<YieldTermStructure>& curve,
+                     Real accuracy = 1.0e-10,
+                     Size maxIterations = 100);
+        //@}
+        //! \name Warm starts
+        //@{
+        //! sets the starting points of the next yield calculation
+        void setYieldGuesses(const std::vector<Rate>& guesses);
+        //! sets the starting points of the next z-spread calculation
+        void setZSpreadGuesses(const std::vector<Spread>& guesses);
+        //@}
+      private:
+        Real dirtyPrice(Size i, Real cleanPrice) const;
+        // the compounding convention is passed as a template
+        // argument, so that it is selected once per batch
+        template <class Rates>
+        void solveYields(const Rates& rates,
+                         const std::vector<Real>& targets,
+                         std::vector<Size>& active,
+                         std::vector<Size>& failed,
+                         Real accuracy,
+                         Size maxIterations);
+        template <class Rates>
+        void solveZSpreads(const Rates& rates,
+                           const std::vector<Real>& targets,
+                           const std::vector<Time>& times,
+                           const std::vector<Rate>& zeros,
+                           const std::vector<Time>& settlementTimes,
+                           const std::vector<Rate>& settlementZeros,
+                           std::vector<Size>& active,
+                           std::vector<Size>& failed,
+                           Real accuracy,
+                           Size maxIterations);
+        template <class Rates>
+        void calculatePrices(const Rates& rates,
+                             const std::vector<Rate>& yields,
+                             std::vector<Real>& result) const;
+        template <class Rates>
+        void calculateDurations(const Rates& rates,
+                                const std::vector<Rate>& yields,
+                                Duration::Type type,
+                                std::vector<Time>& result) const;
+        std::vector<boost::shared_ptr<Bond> > bonds_;
+        DayCounter dayCounter_;
+        Compounding compounding_;
+        Frequency frequency_;
+        std::vector<Date> settlementDates_;
+        std::vector<Real> accruedAmounts_, notionals_;
+        // flattened cash flows; the flows of the i-th bond are
+        // stored at positions first_[i] to first_[i+1]-1
+        std::vector<Size> first_;
+        std::vector<Real> amounts_;
+        std::vector<Time> periods_;   // accrual from previous flow
+        std::vector<Date> dates_;
+        std::vector<Rate> yields_;
+        std::vector<Spread> zSpreads_;
+    };
+
+}
+
+#endif
@@ -61,21 +61,12 @@ namespace QuantLib {
         }
 
         DiscretizedCapFloor capfloor(arguments_, referenceDate, dayCounter);
-        boost::shared_ptr<Lattice> lattice;
-
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = capfloor.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
 
         Time firstTime = dayCounter.yearFraction(referenceDate,
                                                  arguments_.startDates.front());
         Time lastTime = dayCounter.yearFraction(referenceDate,
                                                 arguments_.endDates.back());
-        capfloor.initialize(lattice, lastTime);
+        capfloor.initialize(lattice(capfloor.mandatoryTimes()), lastTime);
         capfloor.rollback(firstTime);
 
         results_.value = capfloor.presentValue();
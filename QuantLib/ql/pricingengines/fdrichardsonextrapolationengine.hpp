@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdrichardsonextrapolationengine.hpp
+    \brief grid-convergence wrapper for finite-difference engines
+*/
+
+#ifndef quantlib_fd_richardson_extrapolation_engine_hpp
+#define quantlib_fd_richardson_extrapolation_engine_hpp
+
+#include <ql/pricingengine.hpp>
+#include <boost/function.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! grid-convergence wrapper for finite-difference engines
+    /*! The wrapped engine is priced on a sequence of grids, each
+        one refined by a factor of two in every dimension (time
+        included) with respect to the previous one.  The factory is
+        passed the refinement factor (1, 2, 4, ...) and must return
+        an engine whose grid sizes are multiplied by it.
+
+        After each refinement, the value is extrapolated as
+        \f[
+            V^* = V_h + \frac{V_h - V_{2h}}{2^p - 1}
+        \f]
+        where \f$ p \f$ is the order of convergence of the scheme,
+        and \f$ |V_h - V_{2h}|/(2^p - 1) \f$ is used as an estimate
+        of the error.  The sequence stops at the first grid whose
+        error estimate is below the required tolerance, or after
+        the given maximum number of refinements.
+
+        The error estimate is returned as the error estimate of the
+        instrument and, together with the refinement factor of the
+        last grid, in the additional results.  The other results
+        (e.g., the Greeks) are those of the finest grid used.
+
+        \warning the estimate assumes that the scheme converges with
+                 the given order; this is not the case, e.g., for
+                 non-smooth payoffs without damping steps.
+
+        \ingroup vanillaengines
+    */
+    template <class ArgumentsType, class ResultsType>
+    class FdRichardsonExtrapolationEngine
+        : public GenericEngine<ArgumentsType, ResultsType> {
+      public:
+        typedef boost::function<boost::shared_ptr<PricingEngine>(Size)>
+                                                                EngineFactory;
+
+        FdRichardsonExtrapolationEngine(const EngineFactory& factory,
+                                        Real tolerance,
+                                        Size maxRefinements = 4,
+                                        Real order = 2.0);
+        void calculate() const;
+
+      private:
+        Real tolerance_, order_;
+        std::vector<boost::shared_ptr<PricingEngine> > engines_;
+    };
+
+
+    // template definitions
+
+    template <class A, class R>
+    FdRichardsonExtrapolationEngine<A,R>::FdRichardsonExtrapolationEngine(
+                                                const EngineFactory& factory,
+                                                Real tolerance,
+                                                Size maxRefinements,
+                                                Real order)
+    : tolerance_(tolerance), order_(order) {
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required (" << tolerance << " given)");
+        QL_REQUIRE(order > 0.0,
+                   "positive order required (" << order << " given)");
+        QL_REQUIRE(maxRefinements > 0, "at least one refinement required");
+
+        for (Size i=0; i <= maxRefinements; ++i) {
+            engines_.push_back(factory(Size(1) << i));
+            QL_REQUIRE(engines_.back(), "null engine returned by factory");
+            this->registerWith(engines_.back());
+        }
+    }
+
+    template <class A, class R>
+    void FdRichardsonExtrapolationEngine<A,R>::calculate() const {
+        const Real scale = 1.0/(std::pow(2.0, order_) - 1.0);
+
+        Real previous = Null<Real>(), value = Null<Real>();
+        Real error = Null<Real>();
+        Size refinement = 0;
+        for (Size i=0; i < engines_.size(); ++i) {
+            A* arguments = dynamic_cast<A*>(engines_[i]->getArguments());
+            QL_REQUIRE(arguments, "wrong engine type");
+            *arguments = this->arguments_;
+
+            engines_[i]->reset();
+            engines_[i]->calculate();
+
+            const R* results =
+                dynamic_cast<const R*>(engines_[i]->getResults());
+            QL_REQUIRE(results, "wrong engine type");
+            this->results_ = *results;
+            refinement = Size(1) << i;
+
+            const Real current = results->value;
+            if (previous != Null<Real>()) {
+                error = std::fabs(current - previous)*scale;
+                value = current + (current - previous)*scale;
+                if (error <= tolerance_)
+                    break;
+            }
+            previous = current;
+        }
+
+        this->results_.value = value;
+        this->results_.errorEstimate = error;
+        this->results_.additionalResults["errorEstimate"] = error;
+        this->results_.additionalResults["gridRefinement"] = refinement;
+    }
+
+}
+
+#endif
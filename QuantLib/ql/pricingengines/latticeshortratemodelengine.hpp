@@ -33,6 +33,18 @@ namespace QuantLib {
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
         method
+
+        Unless a time grid is given, the lattice is built on the
+        mandatory times of the instrument; otherwise, all the
+        instruments priced with the engine are rolled back on the
+        given grid.  In both cases, the lattice is obtained from the
+        cache of the model (see ShortRateModel::cachedTree) and is
+        thus shared with any other engine, e.g., for swaptions, caps
+        or swaps, using the same model and grid; it is built again
+        only when the model parameters change.  To calibrate on a
+        single lattice, build the grid on the union of the times of
+        the calibration helpers (see CalibrationHelper::addTimesTo)
+        and pass it to their engines.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -47,11 +59,12 @@ namespace QuantLib {
         LatticeShortRateModelEngine(
                                const boost::shared_ptr<ShortRateModel>& model,
                                const TimeGrid& timeGrid);
-        void update();
       protected:
+        //! lattice to be used for the given mandatory times
+        boost::shared_ptr<Lattice> lattice(
+                                     const std::vector<Time>& times) const;
         TimeGrid timeGrid_;
         Size timeSteps_;
-        boost::shared_ptr<Lattice> lattice_;
     };
 
     template <class Arguments, class Results>
@@ -81,16 +94,17 @@ namespace QuantLib {
             const boost::shared_ptr<ShortRateModel>& model,
             const TimeGrid& timeGrid)
     : GenericModelEngine<ShortRateModel, Arguments, Results>(model),
-      timeGrid_(timeGrid), timeSteps_(0) {
-        lattice_ = this->model_->tree(timeGrid);
-    }
+      timeGrid_(timeGrid), timeSteps_(0) {}
 
     template <class Arguments, class Results>
-    void LatticeShortRateModelEngine<Arguments, Results>::update()
-    {
+    boost::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::lattice(
+                                     const std::vector<Time>& times) const {
         if (!timeGrid_.empty())
-            lattice_ = this->model_->tree(timeGrid_);
-        GenericModelEngine<ShortRateModel, Arguments, Results>::update();
+            return this->model_->cachedTree(timeGrid_);
+
+        TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+        return this->model_->cachedTree(timeGrid);
     }
 
 }
@@ -63,15 +63,7 @@ namespace QuantLib {
         DiscretizedSwap swap(arguments_, referenceDate, dayCounter);
         std::vector<Time> times = swap.mandatoryTimes();
 
-        boost::shared_ptr<Lattice> lattice;
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
-
-        swap.initialize(lattice, times.back());
+        swap.initialize(lattice(times), times.back());
         swap.rollback(0.0);
 
         results_.value = swap.presentValue();
@@ -73,15 +73,6 @@ namespace QuantLib {
         }
 
         DiscretizedSwaption swaption(arguments_, referenceDate, dayCounter);
-        boost::shared_ptr<Lattice> lattice;
-
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = swaption.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
 
         std::vector<Time> stoppingTimes(arguments_.exercise->dates().size());
         for (Size i=0; i<stoppingTimes.size(); ++i)
@@ -89,7 +80,8 @@ namespace QuantLib {
                 dayCounter.yearFraction(referenceDate,
                                         arguments_.exercise->date(i));
 
-        swaption.initialize(lattice, stoppingTimes.back());
+        swaption.initialize(lattice(swaption.mandatoryTimes()),
+                            stoppingTimes.back());
 
         Time nextExercise =
             *std::find_if(stoppingTimes.begin(),
@@ -32,6 +32,7 @@
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/pricingengines/vanilla/discretizedvanillaoption.hpp>
 #include <ql/pricingengines/greeks.hpp>
+#include <ql/pricingengines/blackscholessmoothing.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -41,6 +42,15 @@ namespace QuantLib {
     //! Pricing engine for vanilla options using binomial trees
     /*! \ingroup vanillaengines
 
+        If smoothing is enabled, the engine uses the BBSR method of
+        Broadie and Detemple: the values one step before maturity are
+        replaced by Black-Scholes values (see
+        blackScholesSmoothedValue) and the results on timeSteps and
+        timeSteps/2 steps are combined by Richardson extrapolation.
+        This removes most of the oscillations of the results with the
+        number of steps, so that far fewer steps are needed; theta is
+        then also taken from the tree.
+
         \test the correctness of the returned values is tested by
               checking it against analytic results.
 
@@ -55,17 +65,27 @@ namespace QuantLib {
       public:
         BinomialVanillaEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
-             Size timeSteps)
-        : process_(process), timeSteps_(timeSteps) {
+             Size timeSteps,
+             bool smoothing = false)
+        : process_(process), timeSteps_(timeSteps), smoothing_(smoothing) {
             QL_REQUIRE(timeSteps>0,
                        "timeSteps must be positive, " << timeSteps <<
                        " not allowed");
+            QL_REQUIRE(!smoothing || timeSteps>=6,
+                       "at least 6 steps needed for smoothing, "
+                       << timeSteps << " not allowed");
             registerWith(process_);
         }
         void calculate() const;
       private:
+        void calculateOnTree(
+                  const boost::shared_ptr<StochasticProcess1D>& bs,
+                  const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                  Rate r, Rate q, Volatility v, Time maturity,
+                  Size timeSteps, OneAssetOption::results& results) const;
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_;
+        bool smoothing_;
     };
 
 
@@ -112,18 +132,79 @@ namespace QuantLib {
                                       process_->stateVariable(),
                                       flatDividends, flatRiskFree, flatVol));
 
-        TimeGrid grid(maturity, timeSteps_);
+        calculateOnTree(bs, payoff, r, q, v, maturity, timeSteps_, results_);
+
+        if (smoothing_) {
+            // two-point Richardson extrapolation, the error of the
+            // smoothed tree being proportional to 1/timeSteps
+            OneAssetOption::results coarse;
+            const Size n = timeSteps_/2;
+            calculateOnTree(bs, payoff, r, q, v, maturity, n, coarse);
+
+            const Real w = Real(n)/(timeSteps_-n);
+            results_.value += w*(results_.value - coarse.value);
+            results_.delta += w*(results_.delta - coarse.delta);
+            results_.gamma += w*(results_.gamma - coarse.gamma);
+            results_.theta += w*(results_.theta - coarse.theta);
+        } else {
+            results_.theta = blackScholesTheta(process_,
+                                               results_.value,
+                                               results_.delta,
+                                               results_.gamma);
+        }
+    }
+
+    template <class T>
+    void BinomialVanillaEngine<T>::calculateOnTree(
+                  const boost::shared_ptr<StochasticProcess1D>& bs,
+                  const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                  Rate r, Rate q, Volatility v, Time maturity,
+                  Size timeSteps, OneAssetOption::results& results) const {
+
+        TimeGrid grid(maturity, timeSteps);
 
-        boost::shared_ptr<T> tree(new T(bs, maturity, timeSteps_,
+        boost::shared_ptr<T> tree(new T(bs, maturity, timeSteps,
                                         payoff->strike()));
 
         boost::shared_ptr<BlackScholesLattice<T> > lattice(
-            new BlackScholesLattice<T>(tree, r, maturity, timeSteps_));
+            new BlackScholesLattice<T>(tree, r, maturity, timeSteps));
 
         DiscretizedVanillaOption option(arguments_, *process_, grid);
 
         option.initialize(lattice, maturity);
 
+        if (smoothing_) {
+            // replace the last step by the Black-Scholes values
+            const Size i = timeSteps-1;
+            option.rollback(grid[i]);
+
+            bool exercisable = false;
+            switch (arguments_.exercise->type()) {
+              case Exercise::American:
+                exercisable = (grid.closestTime(process_->time(
+                                   arguments_.exercise->date(0))) <= grid[i]);
+                break;
+              case Exercise::Bermudan:
+                for (Size k=0; k<arguments_.exercise->dates().size(); ++k) {
+                    if (close_enough(grid.closestTime(process_->time(
+                                     arguments_.exercise->date(k))), grid[i]))
+                        exercisable = true;
+                }
+                break;
+              default:
+                break;
+            }
+
+            Array& values = option.values();
+            for (Size j=0; j<values.size(); ++j) {
+                const Real s = lattice->underlying(i, j);
+                values[j] = blackScholesSmoothedValue(*payoff, s, r, q, v,
+                                                      maturity-grid[i]);
+                if (exercisable)
+                    values[j] = std::max(values[j], (*payoff)(s));
+            }
+        }
+
         // Partial derivatives calculated from various points in the
         // binomial tree 
         // (see J.C.Hull, "Options, Futures and other derivatives", 6th edition, pp 397/398)
@@ -162,13 +243,14 @@ namespace QuantLib {
         Real p0 = option.presentValue();
 
         // Store results
-        results_.value = p0;
-        results_.delta = delta;
-        results_.gamma = gamma;
-        results_.theta = blackScholesTheta(process_,
-                                           results_.value,
-                                           results_.delta,
-                                           results_.gamma);
+        results.value = p0;
+        results.delta = delta;
+        results.gamma = gamma;
+        // theta from the mid value at the third-last step, moved back
+        // to the current underlying value for trees whose middle node
+        // drifts away from it
+        Real ds = s2m - lattice->underlying(0, 0);
+        results.theta = (p2m - delta*ds - 0.5*gamma*ds*ds - p0) / grid[2];
     }
 
 }
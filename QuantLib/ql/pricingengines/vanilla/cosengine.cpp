@@ -0,0 +1,145 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosengine.cpp
+    \brief base class for Fourier-cosine option pricing engines
+*/
+
+#include <ql/pricingengines/vanilla/cosengine.hpp>
+#include <ql/exercise.hpp>
+#include <ql/instruments/payoffs.hpp>
+
+namespace QuantLib {
+
+    COSEngine::COSEngine(Real L, Size N)
+    : L_(L), N_(N) {
+        QL_REQUIRE(L > 0.0, "positive truncation width required");
+        QL_REQUIRE(N > 1, "at least two terms required");
+    }
+
+    void COSEngine::update() {
+        // the model has changed so cached expansions are no longer valid
+        expansions_.clear();
+
+        VanillaOption::engine::update();
+    }
+
+    void COSEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const Real spot = underlying();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        const Date maturity = arguments_.exercise->lastDate();
+        const DiscountFactor riskFreeDiscount =
+            riskFreeRate()->discount(maturity);
+        const DiscountFactor dividendDiscount =
+            dividendYield()->discount(maturity);
+        const Real forward = spot*dividendDiscount/riskFreeDiscount;
+        const Real strike = payoff->strike();
+
+        const Expansion& e =
+            expansion(riskFreeRate()->timeFromReference(maturity));
+        const Real put = undiscountedPut(e, forward, strike);
+
+        switch (payoff->optionType()) {
+          case Option::Put:
+            results_.value = riskFreeDiscount*put;
+            break;
+          case Option::Call:
+            results_.value = riskFreeDiscount*(put + forward - strike);
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+    const COSEngine::Expansion& COSEngine::expansion(Time t) const {
+        std::map<Time, Expansion>::const_iterator iter = expansions_.find(t);
+        if (iter != expansions_.end())
+            return iter->second;
+
+        QL_REQUIRE(t > 0.0, "positive time to maturity required");
+
+        // cumulants from the expansion of the log of the
+        // characteristic function around zero
+        const Real h = 1e-2;
+        const std::complex<Real> lnPhi1 =
+            std::log(characteristicFunction(h, t));
+        const std::complex<Real> lnPhi2 =
+            std::log(characteristicFunction(2.0*h, t));
+        const Real c1 = lnPhi1.imag()/h;
+        const Real c4 = 2.0*(lnPhi2.real() - 4.0*lnPhi1.real())/(h*h*h*h);
+        const Real c2 = -2.0*lnPhi1.real()/(h*h) + c4*h*h/12.0;
+
+        const Real width =
+            L_*std::sqrt(std::fabs(c2) + std::sqrt(std::fabs(c4)));
+        Expansion& e = expansions_[t];
+        e.a = c1 - width;
+        e.b = c1 + width;
+        e.weights = Array(N_);
+
+        const Real du = M_PI/(e.b - e.a);
+        for (Size k=0; k < N_; ++k) {
+            const Real u = k*du;
+            e.weights[k] = (characteristicFunction(u, t)
+                            *std::exp(std::complex<Real>(0.0, -u*e.a))).real();
+        }
+        e.weights[0] *= 0.5;
+
+        return e;
+    }
+
+    Real COSEngine::undiscountedPut(const Expansion& e,
+                                    Real forward, Real strike) const {
+        // the put pays strike*(1 - exp(x0 + x))^+ with x = ln(S/F);
+        // its cosine coefficients on [a, b] are taken over [a, d]
+        const Real x0 = std::log(forward/strike);
+        const Real a = e.a, b = e.b;
+        const Real d = std::min(std::max(-x0, a), b);
+        if (d == a)
+            return 0.0;
+
+        const Real du = M_PI/(b - a);
+        const Real ea = std::exp(x0 + a), ed = std::exp(x0 + d);
+
+        // the cosine and sine of k*du*(d-a) are obtained by rotation
+        const Real cosStep = std::cos(du*(d - a));
+        const Real sinStep = std::sin(du*(d - a));
+        Real c = 1.0, s = 0.0;
+
+        Real sum = e.weights[0]*((d - a) - (ed - ea));
+        for (Size k=1; k < N_; ++k) {
+            const Real tmp = c*cosStep - s*sinStep;
+            s = s*cosStep + c*sinStep;
+            c = tmp;
+
+            const Real u = k*du;
+            const Real chi = (ed*(c + u*s) - ea)/(1.0 + u*u);
+            const Real psi = s/u;
+            sum += e.weights[k]*(psi - chi);
+        }
+
+        return 2.0*strike/(b - a)*sum;
+    }
+
+}
@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosengine.hpp
+    \brief base class for Fourier-cosine option pricing engines
+*/
+
+#ifndef quantlib_cos_engine_hpp
+#define quantlib_cos_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/array.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! Base class for Fourier-cosine engines for European vanilla options
+    /*! The density of the log-return is expanded in a cosine series
+        on a truncated range, whose coefficients are given by the
+        characteristic function; the cosine coefficients of the
+        payoff are known in closed form.  Puts are priced by the
+        expansion and calls by put-call parity.
+
+        The characteristic function only depends on the maturity.
+        Its contribution to the expansion is calculated once for each
+        maturity and cached, so that each further option with the
+        same maturity (e.g., in a calibration to a whole surface)
+        only costs a cosine sum.  The cache is cleared when the
+        engine is notified of a change.
+
+        The default settings of the derived engines (L = 8, N = 512)
+        are accurate to \f$ 10^{-6} \f$ or better for usual
+        parameters; short maturities combined with a large
+        volatility of variance need more terms.
+
+        References:
+
+        F. Fang and C.W. Oosterlee, 2008. A novel pricing method for
+        European options based on Fourier-cosine series expansions.
+        SIAM Journal on Scientific Computing 31(2), 826-848.
+
+        \ingroup vanillaengines
+    */
+    class COSEngine : public VanillaOption::engine {
+      public:
+        void calculate() const;
+        void update();
+
+      protected:
+        /*! \param L  half-width of the truncation range in units of
+                      \f$ \sqrt{c_2 + \sqrt{c_4}} \f$, where
+                      \f$ c_n \f$ are the cumulants of the log-return
+            \param N  number of terms of the cosine expansion
+        */
+        COSEngine(Real L, Size N);
+
+        //! characteristic function of \f$ \ln(S_t/F_t) \f$
+        /*! \f$ F_t \f$ is the forward of the underlying for time
+            \f$ t \f$, hence the function is independent of rates
+            and dividends.
+        */
+        virtual std::complex<Real> characteristicFunction(Real u,
+                                                          Time t) const = 0;
+        virtual Real underlying() const = 0;
+        virtual Handle<YieldTermStructure> riskFreeRate() const = 0;
+        virtual Handle<YieldTermStructure> dividendYield() const = 0;
+
+        const Real L_;
+        const Size N_;
+
+      private:
+        struct Expansion {
+            Real a, b;
+            Array weights;
+        };
+        const Expansion& expansion(Time t) const;
+        Real undiscountedPut(const Expansion& e,
+                             Real forward, Real strike) const;
+
+        mutable std::map<Time, Expansion> expansions_;
+    };
+
+}
+
+#endif
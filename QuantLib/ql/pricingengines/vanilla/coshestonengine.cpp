@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coshestonengine.cpp
+    \brief Fourier-cosine engines for the Heston and Bates models
+*/
+
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
+
+namespace QuantLib {
+
+    COSHestonEngine::COSHestonEngine(
+                              const boost::shared_ptr<HestonModel>& model,
+                              Real L, Size N)
+    : COSEngine(L, N), model_(model) {
+        registerWith(model_);
+    }
+
+    std::complex<Real> COSHestonEngine::characteristicFunction(
+                                                        Real u, Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const std::complex<Real> iu(0.0, u);
+
+        if (sigma < 1e-8) {
+            // deterministic variance
+            const Real var = (kappa > 1e-8)
+                ? theta*t + (v0-theta)*(1.0-std::exp(-kappa*t))/kappa
+                : v0*t;
+            return std::exp(-0.5*(u*u + iu)*var);
+        }
+
+        const Real sigma2 = sigma*sigma;
+        const std::complex<Real> t1 = kappa - rho*sigma*iu;
+        const std::complex<Real> d = std::sqrt(t1*t1 + sigma2*(u*u + iu));
+        const std::complex<Real> g = (t1-d)/(t1+d);
+        const std::complex<Real> e = std::exp(-d*t);
+
+        const std::complex<Real> D = (t1-d)/sigma2*(1.0-e)/(1.0-g*e);
+        const std::complex<Real> C = kappa*theta/sigma2
+            *((t1-d)*t - 2.0*std::log((1.0-g*e)/(1.0-g)));
+
+        return std::exp(C + D*v0);
+    }
+
+    Real COSHestonEngine::underlying() const {
+        return model_->process()->s0()->value();
+    }
+
+    Handle<YieldTermStructure> COSHestonEngine::riskFreeRate() const {
+        return model_->process()->riskFreeRate();
+    }
+
+    Handle<YieldTermStructure> COSHestonEngine::dividendYield() const {
+        return model_->process()->dividendYield();
+    }
+
+
+    COSBatesEngine::COSBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                                   Real L, Size N)
+    : COSHestonEngine(model, L, N) {}
+
+    std::complex<Real> COSBatesEngine::characteristicFunction(
+                                                        Real u, Time t) const {
+        const boost::shared_ptr<BatesModel> model =
+            boost::static_pointer_cast<BatesModel>(model_);
+        const Real nu = model->nu();
+        const Real delta2 = 0.5*model->delta()*model->delta();
+        const Real lambda = model->lambda();
+
+        // compensated log-normal jumps
+        const std::complex<Real> iu(0.0, u);
+        const std::complex<Real> jumps = t*lambda
+            *(std::exp(nu*iu - delta2*u*u) - 1.0
+              - iu*(std::exp(nu + delta2) - 1.0));
+
+        return COSHestonEngine::characteristicFunction(u, t)
+            *std::exp(jumps);
+    }
+
+}
@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coshestonengine.hpp
+    \brief Fourier-cosine engines for the Heston and Bates models
+*/
+
+#ifndef quantlib_cos_heston_engine_hpp
+#define quantlib_cos_heston_engine_hpp
+
+#include <ql/pricingengines/vanilla/cosengine.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+
+namespace QuantLib {
+
+    //! Fourier-cosine engine for the Heston model
+    /*! The characteristic function is written in the form given by
+        Albrecher et al., which avoids the discontinuities of the
+        complex logarithm.
+
+        References:
+
+        H. Albrecher, P. Mayer, W. Schoutens and J. Tistaert, 2007.
+        The little Heston trap.  Wilmott Magazine, January, 83-92.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class COSHestonEngine : public COSEngine {
+      public:
+        COSHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Real L = 8.0, Size N = 512);
+
+      protected:
+        std::complex<Real> characteristicFunction(Real u, Time t) const;
+        Real underlying() const;
+        Handle<YieldTermStructure> riskFreeRate() const;
+        Handle<YieldTermStructure> dividendYield() const;
+
+        boost::shared_ptr<HestonModel> model_;
+    };
+
+
+    //! Fourier-cosine engine for the Bates model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Bates engine.
+    */
+    class COSBatesEngine : public COSHestonEngine {
+      public:
+        COSBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                       Real L = 8.0, Size N = 512);
+
+      protected:
+        std::complex<Real> characteristicFunction(Real u, Time t) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosptdhestonengine.cpp
+    \brief Fourier-cosine piecewise time dependent Heston-model engine
+*/
+
+#include <ql/pricingengines/vanilla/cosptdhestonengine.hpp>
+
+namespace QuantLib {
+
+    COSPTDHestonEngine::COSPTDHestonEngine(
+            const boost::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Real L, Size N)
+    : COSEngine(L, N), model_(model) {
+        registerWith(model_);
+    }
+
+    std::complex<Real> COSPTDHestonEngine::characteristicFunction(
+                                                        Real u, Time t) const {
+        const TimeGrid& timeGrid = model_->timeGrid();
+        QL_REQUIRE(t < timeGrid.back(), "maturity is too large");
+
+        const std::complex<Real> iu(0.0, u);
+
+        std::complex<Real> D = 0.0;
+        std::complex<Real> C = 0.0;
+        for (Size i=timeGrid.size()-1; i > 0; --i) {
+            const Time begin = timeGrid[i-1];
+            if (begin < t) {
+                const Time end = std::min(t, timeGrid[i]);
+                const Time tau = end-begin;
+                const Time tm  = 0.5*(end+begin);
+                const Real rho = model_->rho(tm);
+                const Real sigma = model_->sigma(tm);
+                const Real kappa = model_->kappa(tm);
+                const Real theta = model_->theta(tm);
+                const Real sigma2 = sigma*sigma;
+
+                const std::complex<Real> t1 = kappa - rho*sigma*iu;
+                const std::complex<Real> d
+                    = std::sqrt(t1*t1 + sigma2*(u*u + iu));
+                const std::complex<Real> g = (t1-d)/(t1+d);
+                const std::complex<Real> gt
+                    = (t1-d - D*sigma2)/(t1+d - D*sigma2);
+                const std::complex<Real> e = std::exp(-d*tau);
+
+                D = (t1+d)/sigma2*(g-gt*e)/(1.0-gt*e);
+                C += kappa*theta/sigma2
+                    *((t1-d)*tau - 2.0*std::log((1.0-gt*e)/(1.0-gt)));
+            }
+        }
+
+        return std::exp(C + D*model_->v0());
+    }
+
+    Real COSPTDHestonEngine::underlying() const {
+        return model_->s0();
+    }
+
+    Handle<YieldTermStructure> COSPTDHestonEngine::riskFreeRate() const {
+        return model_->riskFreeRate();
+    }
+
+    Handle<YieldTermStructure> COSPTDHestonEngine::dividendYield() const {
+        return model_->dividendYield();
+    }
+
+}
@@ -0,0 +1,64 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosptdhestonengine.hpp
+    \brief Fourier-cosine piecewise time dependent Heston-model engine
+*/
+
+#ifndef quantlib_cos_piecewise_time_dependent_heston_engine_hpp
+#define quantlib_cos_piecewise_time_dependent_heston_engine_hpp
+
+#include <ql/pricingengines/vanilla/cosengine.hpp>
+#include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+
+namespace QuantLib {
+
+    //! Fourier-cosine piecewise constant time dependent Heston-model engine
+    /*! The characteristic function is built by solving the Riccati
+        equations backwards over the intervals of the model time
+        grid, as in the analytic engine.
+
+        References:
+
+        A. Elices, Models with time-dependent parameters using
+        transform methods: application to Heston's model,
+        http://arxiv.org/pdf/0708.2020
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic engine.
+    */
+    class COSPTDHestonEngine : public COSEngine {
+      public:
+        COSPTDHestonEngine(
+            const boost::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Real L = 8.0, Size N = 512);
+
+      protected:
+        std::complex<Real> characteristicFunction(Real u, Time t) const;
+        Real underlying() const;
+        Handle<YieldTermStructure> riskFreeRate() const;
+        Handle<YieldTermStructure> dividendYield() const;
+
+      private:
+        boost::shared_ptr<PiecewiseTimeDependentHestonModel> model_;
+    };
+
+}
+
+#endif
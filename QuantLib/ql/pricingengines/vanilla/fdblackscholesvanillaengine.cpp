@@ -26,6 +26,8 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholesmultistrikesolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 
@@ -47,11 +49,49 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
+            if (   cachedArgs2results_[i].first.exercise->type()
+                        == arguments_.exercise->type()
+                && cachedArgs2results_[i].first.exercise->dates()
+                        == arguments_.exercise->dates()
+                && sameDividends(cachedArgs2results_[i].first.cashFlow,
+                                 arguments_.cashFlow)) {
+                boost::shared_ptr<PlainVanillaPayoff> p1 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                boost::shared_ptr<PlainVanillaPayoff> p2 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                          cachedArgs2results_[i].first.payoff);
+
+                if (p1 && p2 && p1->strike() == p2->strike()
+                       && p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2results_[i].second;
+                    return;
+                }
+            }
+        }
+
+        const Time maturity = process_->time(arguments_.exercise->lastDate());
+
+        const boost::shared_ptr<PlainVanillaPayoff> plainPayoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        if (!strikes_.empty() && plainPayoff) {
+            std::vector<Real> strikes(1, plainPayoff->strike());
+            strikes.insert(strikes.end(), strikes_.begin(), strikes_.end());
+
+            // a strike-dependent volatility needs one solve per strike
+            if (FdmBlackScholesMultiStrikeSolver::isStrikeIndependent(
+                                    process_, maturity, strikes, localVol_)) {
+                calculateStrip(plainPayoff, strikes);
+                return;
+            }
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
-        const Time maturity = process_->time(arguments_.exercise->lastDate());
         const boost::shared_ptr<Fdm1dMesher> equityMesher(
             new FdmBlackScholesMesher(
                     xGrid_, process_, maturity, payoff->strike(), 
@@ -92,4 +132,86 @@ namespace QuantLib {
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
     }
+
+    void FdBlackScholesVanillaEngine::calculateStrip(
+            const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+            const std::vector<Real>& strikes) const {
+
+        // 1. Mesher, not concentrated so that all strikes of the strip
+        //    are resolved alike
+        const Time maturity = process_->time(arguments_.exercise->lastDate());
+
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                    xGrid_, process_, maturity, strikes));
+
+        const boost::shared_ptr<FdmMesher> mesher (
+            new FdmMesherComposite(equityMesher));
+
+        // 2. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 3. Calculators and step conditions, one per strike
+        std::vector<FdmSolverDesc> solverDescs;
+        for (Size i=0; i < strikes.size(); ++i) {
+            const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                new FdmLogInnerValue(
+                    boost::shared_ptr<Payoff>(new PlainVanillaPayoff(
+                                        payoff->optionType(), strikes[i])),
+                    mesher, 0));
+
+            const boost::shared_ptr<FdmStepConditionComposite> conditions =
+                FdmStepConditionComposite::vanillaComposite(
+                                    arguments_.cashFlow, arguments_.exercise,
+                                    mesher, calculator,
+                                    process_->riskFreeRate()->referenceDate(),
+                                    process_->riskFreeRate()->dayCounter());
+
+            const FdmSolverDesc solverDesc = {
+                mesher, boundaries, conditions, calculator,
+                maturity, tGrid_, dampingSteps_ };
+            solverDescs.push_back(solverDesc);
+        }
+
+        // 4. Solver
+        const FdmBlackScholesMultiStrikeSolver solver(
+                             Handle<GeneralizedBlackScholesProcess>(process_),
+                             payoff->strike(), solverDescs, schemeDesc_,
+                             localVol_, illegalLocalVolOverwrite_);
+
+        const Real spot = process_->x0();
+        results_.value = solver.valueAt(0, spot);
+        results_.delta = solver.deltaAt(0, spot);
+        results_.gamma = solver.gammaAt(0, spot);
+        results_.theta = solver.thetaAt(0, spot);
+
+        cachedArgs2results_.resize(strikes_.size());
+        for (Size i=0; i < strikes_.size(); ++i) {
+            DividendVanillaOption::arguments& args
+                                            = cachedArgs2results_[i].first;
+            args.exercise = arguments_.exercise;
+            args.cashFlow = arguments_.cashFlow;
+            args.payoff = boost::shared_ptr<PlainVanillaPayoff>(
+                    new PlainVanillaPayoff(payoff->optionType(), strikes_[i]));
+
+            DividendVanillaOption::results&
+                                results = cachedArgs2results_[i].second;
+            results.reset();
+            results.value = solver.valueAt(i+1, spot);
+            results.delta = solver.deltaAt(i+1, spot);
+            results.gamma = solver.gammaAt(i+1, spot);
+            results.theta = solver.thetaAt(i+1, spot);
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
 }
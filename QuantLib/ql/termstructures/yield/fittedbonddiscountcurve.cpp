@@ -21,11 +21,14 @@
 #include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
 #include <ql/math/optimization/simplex.hpp>
+#include <ql/math/optimization/bfgs.hpp>
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/constraint.hpp>
+#include <ql/math/optimization/problem.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
 
 using boost::shared_ptr;
 using std::vector;
@@ -39,9 +42,18 @@ namespace QuantLib {
         FittingCost(FittedBondDiscountCurve::FittingMethod* fittingMethod);
         Real value(const Array& x) const;
         Disposable<Array> values(const Array& x) const;
+        void gradient(Array& grad, const Array& x) const;
+        Real valueAndGradient(Array& grad, const Array& x) const;
       private:
         FittedBondDiscountCurve::FittingMethod* fittingMethod_;
-        mutable vector<Size> firstCashFlow_;
+        // tabulated cash flows; the flows of the i-th bond are
+        // stored at positions first_[i] to first_[i+1]-1
+        vector<Size> first_;
+        vector<Time> times_;
+        vector<Real> amounts_;
+        // settlement times (null if settlement is at the reference date)
+        vector<Time> settlementTimes_;
+        vector<Real> accruedAmounts_, marketPrices_;
     };
 
 
@@ -175,8 +187,64 @@ namespace QuantLib {
     }
 
 
-    FittedBondDiscountCurve::FittingMethod::FittingMethod(bool constrainAtZero)
-    : constrainAtZero_(constrainAtZero) {}
+    FittedBondDiscountCurve::FittingMethod::FittingMethod(
+                      bool constrainAtZero,
+                      const shared_ptr<OptimizationMethod>& optimizationMethod)
+    : constrainAtZero_(constrainAtZero),
+      optimizationMethod_(optimizationMethod),
+      gradientOptimization_(false) {}
+
+
+    FittedBondDiscountCurve::FittingMethod::FittingMethod(
+                                                  const FittingMethod& other)
+    : constrainAtZero_(other.constrainAtZero_), curve_(other.curve_),
+      solution_(other.solution_), guessSolution_(other.guessSolution_),
+      costFunction_(other.costFunction_),
+      optimizationMethod_(other.optimizationMethod_),
+      startingPoints_(other.startingPoints_),
+      gradientOptimization_(other.gradientOptimization_),
+      weights_(other.weights_),
+      numberOfIterations_(other.numberOfIterations_),
+      costValue_(other.costValue_) {
+        // copies (e.g., the ones held by different curves) must not
+        // share the state of the optimization method
+        if (optimizationMethod_) {
+            std::auto_ptr<OptimizationMethod> copy =
+                optimizationMethod_->clone();
+            if (copy.get())
+                optimizationMethod_ = shared_ptr<OptimizationMethod>(copy);
+        }
+    }
+
+
+    void FittedBondDiscountCurve::FittingMethod::setStartingPoints(
+                                               const vector<Array>& points) {
+        for (Size i=0; i<points.size(); ++i)
+            QL_REQUIRE(points[i].size() == size(),
+                       io::ordinal(i+1) << " starting point has size " <<
+                       points[i].size() << ", " << size() << " required");
+        startingPoints_ = points;
+    }
+
+    void FittedBondDiscountCurve::FittingMethod::enableGradientOptimization(
+                                                                 bool flag) {
+        gradientOptimization_ = flag;
+    }
+
+
+    void FittedBondDiscountCurve::FittingMethod::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        Array xx(x);
+        for (Size i=0; i<x.size(); ++i) {
+            Real h = 1.0e-6 * std::max(std::fabs(x[i]), 1.0);
+            xx[i] = x[i] + h;
+            Real fp = discountFunction(xx, t);
+            xx[i] = x[i] - h;
+            Real fm = discountFunction(xx, t);
+            grad[i] = 0.5*(fp - fm)/h;
+            xx[i] = x[i];
+        }
+    }
 
 
     void FittedBondDiscountCurve::FittingMethod::init() {
@@ -186,17 +254,23 @@ namespace QuantLib {
         Compounding yieldComp = Compounded;
         Frequency yieldFreq = Annual;
 
+        Date refDate = curve_->referenceDate();
+        const DayCounter& dc = curve_->dayCounter();
+
         Size n = curve_->bondHelpers_.size();
         costFunction_ = shared_ptr<FittingCost>(new FittingCost(this));
-        costFunction_->firstCashFlow_.resize(n);
+        FittingCost& cost = *costFunction_;
+        cost.first_.reserve(n+1);
+        cost.settlementTimes_.resize(n);
+        cost.accruedAmounts_.resize(n);
+        cost.marketPrices_.resize(n);
         weights_ = Array(n);
         Real squaredSum = 0.0;
         for (Size i=0; i<curve_->bondHelpers_.size(); ++i) {
             shared_ptr<Bond> bond = curve_->bondHelpers_[i]->bond();
 
-            Leg leg = bond->cashflows();
             Real cleanPrice = curve_->bondHelpers_[i]->quote()->value();
-            
+
             Date bondSettlement = bond->settlementDate();
             Rate ytm = BondFunctions::yield(*bond, cleanPrice,
                                             yieldDC, yieldComp, yieldFreq,
@@ -209,14 +283,22 @@ namespace QuantLib {
             weights_[i] = 1.0/dur;
             squaredSum += weights_[i]*weights_[i];
 
+            cost.marketPrices_[i] = cleanPrice;
+            cost.accruedAmounts_[i] = bond->accruedAmount(bondSettlement);
+            cost.settlementTimes_[i] = (bondSettlement != refDate) ?
+                dc.yearFraction(refDate, bondSettlement) : Null<Time>();
+
+            cost.first_.push_back(cost.times_.size());
             const Leg& cf = bond->cashflows();
-            for (Size k=0; k<cf.size(); ++k) {
-                if (!cf[k]->hasOccurred(bondSettlement, false)) {
-                    costFunction_->firstCashFlow_[i] = k;
-                    break;
-                }
+            Size k = 0;
+            while (k<cf.size() && cf[k]->hasOccurred(bondSettlement, false))
+                ++k;
+            for (; k<cf.size(); ++k) {
+                cost.times_.push_back(dc.yearFraction(refDate, cf[k]->date()));
+                cost.amounts_.push_back(cf[k]->amount());
             }
         }
+        cost.first_.push_back(cost.times_.size());
         weights_ /= std::sqrt(squaredSum);
 
     }
@@ -233,8 +315,9 @@ namespace QuantLib {
             x = curve_->guessSolution_;
         }
 
-        Simplex simplex(curve_->simplexLambda_);
-        Problem problem(costFunction, constraint, x);
+        vector<Array> guesses(1, x);
+        guesses.insert(guesses.end(),
+                       startingPoints_.begin(), startingPoints_.end());
 
         Natural maxStationaryStateIterations = 100;
         Real rootEpsilon = curve_->accuracy_;
@@ -247,11 +330,89 @@ namespace QuantLib {
                                 functionEpsilon,
                                 gradientNormEpsilon);
 
-        simplex.minimize(problem,endCriteria);
-        solution_ = problem.currentValue();
+        Size nGuesses = guesses.size();
+        vector<Array> solutions(nGuesses);
+        vector<Real> costs(nGuesses, QL_MAX_REAL);
+        vector<Integer> evaluations(nGuesses, 0);
+        vector<std::string> errors(nGuesses);
+
+        // The cost function only reads the tabulated cash flows, so
+        // it can be shared across threads.  Each run gets its own
+        // copy of a user-provided optimization method; if the method
+        // can't be copied, the runs share it and are sequential.
+        vector<shared_ptr<OptimizationMethod> > methods(nGuesses);
+        #ifdef _OPENMP
+        bool parallel = nGuesses > 1;
+        #endif
+        if (optimizationMethod_) {
+            for (Size j=0; j<nGuesses; ++j) {
+                std::auto_ptr<OptimizationMethod> copy =
+                    optimizationMethod_->clone();
+                if (copy.get()) {
+                    methods[j] = shared_ptr<OptimizationMethod>(copy);
+                } else {
+                    methods[j] = optimizationMethod_;
+                    #ifdef _OPENMP
+                    parallel = false;
+                    #endif
+                }
+            }
+        }
+        bool noGuess = curve_->guessSolution_.empty();
+
+        #pragma omp parallel for if(parallel)
+        for (long j=0; j<long(nGuesses); ++j) {
+            try {
+                Problem problem(costFunction, constraint, guesses[j]);
+                Integer previousEvaluations = 0;
+                if (methods[j]) {
+                    methods[j]->minimize(problem, endCriteria);
+                } else if (!gradientOptimization_ || (j == 0 && noGuess)) {
+                    // Simplex is the default, and it is more robust
+                    // far from the solution
+                    Simplex simplex(curve_->simplexLambda_);
+                    simplex.minimize(problem, endCriteria);
+                } else {
+                    // from a guess or a previous solution, BFGS uses
+                    // the analytic gradient and converges faster.
+                    // Should it fail, we start again with Simplex.
+                    bool succeeded = false;
+                    try {
+                        BFGS bfgs;
+                        bfgs.minimize(problem, endCriteria);
+                        succeeded =
+                            boost::math::isfinite(problem.functionValue());
+                    } catch (Error&) {}
+                    if (!succeeded) {
+                        previousEvaluations = problem.functionEvaluation();
+                        problem.setCurrentValue(guesses[j]);
+                        Simplex simplex(curve_->simplexLambda_);
+                        simplex.minimize(problem, endCriteria);
+                    }
+                }
+                solutions[j] = problem.currentValue();
+                costs[j] = problem.functionValue();
+                evaluations[j] =
+                    previousEvaluations + problem.functionEvaluation();
+            } catch (std::exception& e) {
+                errors[j] = e.what();
+            } catch (...) {
+                errors[j] = "unknown error";
+            }
+        }
+
+        Size best = nGuesses;
+        numberOfIterations_ = 0;
+        for (Size j=0; j<nGuesses; ++j) {
+            numberOfIterations_ += evaluations[j];
+            if (errors[j].empty() && (best == nGuesses || costs[j] < costs[best]))
+                best = j;
+        }
+        QL_REQUIRE(best != nGuesses,
+                   "fitting failed: " << errors[0]);
 
-        numberOfIterations_ = problem.functionEvaluation();
-        costValue_ = problem.functionValue();
+        solution_ = solutions[best];
+        costValue_ = costs[best];
 
         // save the results as the guess solution, in case of recalculation
         curve_->guessSolution_ = solution_;
@@ -266,40 +427,75 @@ namespace QuantLib {
     Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
                                                        const Array& x) const {
 
-        Date refDate  = fittingMethod_->curve_->referenceDate();
-        const DayCounter& dc = fittingMethod_->curve_->dayCounter();
-
+        const FittingMethod& method = *fittingMethod_;
         Real squaredError = 0.0;
-        Size n = fittingMethod_->curve_->bondHelpers_.size();
+        Size n = marketPrices_.size();
         for (Size i=0; i<n; ++i) {
 
-            shared_ptr<Bond> bond =
-                            fittingMethod_->curve_->bondHelpers_[i]->bond();
-            Date bondSettlement = bond->settlementDate();
-
             // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
-            Real modelPrice = - bond->accruedAmount(bondSettlement);
-            const Leg& cf = bond->cashflows();
-            for (Size k=firstCashFlow_[i]; k<cf.size(); ++k) {
-                Time tenor = dc.yearFraction(refDate, cf[k]->date());
-                modelPrice += cf[k]->amount() *
-                                    fittingMethod_->discountFunction(x, tenor);
-            }
+            Real modelPrice = - accruedAmounts_[i];
+            for (Size k=first_[i]; k<first_[i+1]; ++k)
+                modelPrice += amounts_[k] *
+                              method.discountFunction(x, times_[k]);
 
             // adjust price (NPV) for forward settlement
-            if (bondSettlement != refDate ) {
-                Time tenor = dc.yearFraction(refDate, bondSettlement);
-                modelPrice /= fittingMethod_->discountFunction(x, tenor);
-            }
-            Real marketPrice =
-                fittingMethod_->curve_->bondHelpers_[i]->quote()->value();
-            Real error = modelPrice - marketPrice;
-            Real weightedError = fittingMethod_->weights_[i] * error;
+            if (settlementTimes_[i] != Null<Time>())
+                modelPrice /= method.discountFunction(x, settlementTimes_[i]);
+
+            Real error = modelPrice - marketPrices_[i];
+            Real weightedError = method.weights_[i] * error;
             squaredError += weightedError * weightedError;
         }
         return squaredError;
     }
 
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::gradient(
+                                       Array& grad, const Array& x) const {
+        valueAndGradient(grad, x);
+    }
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::valueAndGradient(
+                                       Array& grad, const Array& x) const {
+
+        const FittingMethod& method = *fittingMethod_;
+        Size m = x.size();
+        Array d(m), priceGradient(m);
+        std::fill(grad.begin(), grad.end(), 0.0);
+
+        Real squaredError = 0.0;
+        Size n = marketPrices_.size();
+        for (Size i=0; i<n; ++i) {
+
+            Real modelPrice = - accruedAmounts_[i];
+            std::fill(priceGradient.begin(), priceGradient.end(), 0.0);
+            for (Size k=first_[i]; k<first_[i+1]; ++k) {
+                modelPrice += amounts_[k] *
+                              method.discountFunction(x, times_[k]);
+                method.discountFunctionGradient(d, x, times_[k]);
+                for (Size l=0; l<m; ++l)
+                    priceGradient[l] += amounts_[k] * d[l];
+            }
+
+            // P = N/d(t_s) => dP = (dN - P dd(t_s))/d(t_s)
+            if (settlementTimes_[i] != Null<Time>()) {
+                Time ts = settlementTimes_[i];
+                DiscountFactor ds = method.discountFunction(x, ts);
+                modelPrice /= ds;
+                method.discountFunctionGradient(d, x, ts);
+                for (Size l=0; l<m; ++l)
+                    priceGradient[l] =
+                        (priceGradient[l] - modelPrice*d[l])/ds;
+            }
+
+            Real w2 = method.weights_[i] * method.weights_[i];
+            Real error = modelPrice - marketPrices_[i];
+            squaredError += w2 * error * error;
+            for (Size l=0; l<m; ++l)
+                grad[l] += 2.0 * w2 * error * priceGradient[l];
+        }
+        return squaredError;
+    }
+
     Disposable<Array>
     FittedBondDiscountCurve::FittingMethod::FittingCost::values(
                                                        const Array &x) const {
@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class OptimizationMethod;
+
     //! Discount curve fitted to a set of fixed-coupon bonds
     /*! This class fits a discount function \f$ d(t) \f$ over a set of
         bonds, using a user defined fitting method. The discount
@@ -191,6 +193,29 @@ namespace QuantLib {
               would typically be much faster computationally than the
               generic non-linear fitting method.
 
+        The cash flows of the bonds are tabulated in init() as
+        times and amounts, so that evaluating the cost function
+        doesn't need to go through the bond instances.  Derived
+        classes can override discountFunctionGradient() to provide
+        an analytic gradient of the discount function, which is then
+        used by gradient-based optimization methods; by default, it
+        is calculated by finite differences.
+
+        If no optimization method is passed to the constructor, the
+        Simplex method is used.  When gradient optimization is
+        enabled, fits starting from a guess solution (either passed
+        to the curve or saved from a previous fit) or from
+        additional starting points use the BFGS method with the
+        analytic gradient instead, and fall back to Simplex if it
+        fails; a fit starting from scratch still uses Simplex, which
+        is more robust far from the solution.
+
+        Additional starting points for the optimization can be set
+        by means of setStartingPoints(); the fit is then performed
+        from each of them and the best solution is kept.  The fits
+        are run in parallel when OpenMP is enabled, unless the
+        given optimization method can't be cloned.
+
         \warning some parameters to the Simplex optimization method
                  may need to be tweaked internally to the class,
                  depending on the fitting method used, in order to get
@@ -212,9 +237,26 @@ namespace QuantLib {
         Real minimumCostValue() const;
         //! clone of the current object
         virtual std::auto_ptr<FittingMethod> clone() const = 0;
+        //! additional starting points for the optimization
+        /*! The fit is run from each of the given points, as well
+            as from the guess solution; the result with the lowest
+            cost is kept.
+        */
+        void setStartingPoints(const std::vector<Array>& points);
+        //! use BFGS for fits starting from a guess (see above)
+        void enableGradientOptimization(bool flag = true);
       protected:
         //! constructor
-        FittingMethod(bool constrainAtZero = true);
+        /*! If no optimization method is given, the Simplex or BFGS
+            method is used as described above; Simplex uses the
+            lambda parameter passed to the curve.
+        */
+        FittingMethod(bool constrainAtZero = true,
+                      const boost::shared_ptr<OptimizationMethod>&
+                                  optimizationMethod =
+                                      boost::shared_ptr<OptimizationMethod>());
+        //! the copy gets its own clone of the optimization method
+        FittingMethod(const FittingMethod&);
         //! rerun every time instruments/referenceDate changes
         void init();
         //! derived classes must set this
@@ -223,6 +265,14 @@ namespace QuantLib {
         */
         virtual DiscountFactor discountFunction(const Array& x,
                                                 Time t) const = 0;
+        //! gradient of the discount function with respect to \f$ x_i \f$
+        /*! The default implementation uses central finite
+            differences; derived classes should override it when an
+            analytic expression is available.
+        */
+        virtual void discountFunctionGradient(Array& grad,
+                                              const Array& x,
+                                              Time t) const;
 
         //! constrains discount function to unity at \f$ T=0 \f$, if true
         bool constrainAtZero_;
@@ -237,6 +287,12 @@ namespace QuantLib {
         Array guessSolution_;
         //! base class sets this cost function used in the optimization routine
         boost::shared_ptr<FittingCost> costFunction_;
+        //! optimization method used; if null, see above
+        boost::shared_ptr<OptimizationMethod> optimizationMethod_;
+        //! additional starting points for the optimization
+        std::vector<Array> startingPoints_;
+        //! whether BFGS is used for fits starting from a guess
+        bool gradientOptimization_;
       private:
         // curve optimization called here- adjust optimization parameters here
         void calculate();
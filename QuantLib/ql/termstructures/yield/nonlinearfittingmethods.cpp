@@ -23,8 +23,10 @@
 
 namespace QuantLib {
 
-    ExponentialSplinesFitting::ExponentialSplinesFitting(bool constrainAtZero)
-    : FittedBondDiscountCurve::FittingMethod(constrainAtZero) {}
+    ExponentialSplinesFitting::ExponentialSplinesFitting(
+                      bool constrainAtZero,
+                      const boost::shared_ptr<OptimizationMethod>& optMethod)
+    : FittedBondDiscountCurve::FittingMethod(constrainAtZero, optMethod) {}
 
     std::auto_ptr<FittedBondDiscountCurve::FittingMethod>
     ExponentialSplinesFitting::clone() const {
@@ -61,10 +63,37 @@ namespace QuantLib {
         return d;
     }
 
+    void ExponentialSplinesFitting::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        Size N = size();
+        Real kappa = x[N-1];
+        Real dkappa = 0.0;
+
+        if (!constrainAtZero_) {
+            for (Size i=0; i<N-1; ++i) {
+                Real e = std::exp(-kappa * (i+1) * t);
+                grad[i] = e;
+                dkappa -= x[i] * (i+1) * t * e;
+            }
+        } else {
+            Real e1 = std::exp(-kappa * t);
+            Real coeff = 1.0;
+            for (Size i=0; i<N-1; ++i) {
+                Real e = std::exp(-kappa * (i+2) * t);
+                grad[i] = e - e1;
+                dkappa -= x[i] * (i+2) * t * e;
+                coeff -= x[i];
+            }
+            dkappa -= coeff * t * e1;
+        }
+        grad[N-1] = dkappa;
+    }
+
 
 
-    NelsonSiegelFitting::NelsonSiegelFitting()
-    : FittedBondDiscountCurve::FittingMethod(true) {}
+    NelsonSiegelFitting::NelsonSiegelFitting(
+                      const boost::shared_ptr<OptimizationMethod>& optMethod)
+    : FittedBondDiscountCurve::FittingMethod(true, optMethod) {}
 
     std::auto_ptr<FittedBondDiscountCurve::FittingMethod>
     NelsonSiegelFitting::clone() const {
@@ -87,9 +116,25 @@ namespace QuantLib {
         return d;
     }
 
+    void NelsonSiegelFitting::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        Real kappa = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real k = kappa+QL_EPSILON, tt = t+QL_EPSILON;
+        Real a = (1.0 - e)/(k*tt);
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e;
+        // d(discount) = -t discount d(zeroRate)
+        Real f = -t * std::exp(-zeroRate * t);
+        grad[0] = f;
+        grad[1] = f * a;
+        grad[2] = f * (a - e);
+        grad[3] = f * ((x[1] + x[2])*(t*e/(k*tt) - a/k) + x[2]*t*e);
+    }
 
-    SvenssonFitting::SvenssonFitting()
-    : FittedBondDiscountCurve::FittingMethod(true) {}
+
+    SvenssonFitting::SvenssonFitting(
+                      const boost::shared_ptr<OptimizationMethod>& optMethod)
+    : FittedBondDiscountCurve::FittingMethod(true, optMethod) {}
 
     std::auto_ptr<FittedBondDiscountCurve::FittingMethod>
     SvenssonFitting::clone() const {
@@ -115,11 +160,32 @@ namespace QuantLib {
         return d;
     }
 
+    void SvenssonFitting::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        Real kappa = x[size()-2];
+        Real kappa_1 = x[size()-1];
+        Real tt = t+QL_EPSILON;
+        Real e = std::exp(-kappa*t), e1 = std::exp(-kappa_1*t);
+        Real k = kappa+QL_EPSILON, k1 = kappa_1+QL_EPSILON;
+        Real a = (1.0 - e)/(k*tt), a1 = (1.0 - e1)/(k1*tt);
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e + x[3]*(a1 - e1);
+        // d(discount) = -t discount d(zeroRate)
+        Real f = -t * std::exp(-zeroRate * t);
+        grad[0] = f;
+        grad[1] = f * a;
+        grad[2] = f * (a - e);
+        grad[3] = f * (a1 - e1);
+        grad[4] = f * ((x[1] + x[2])*(t*e/(k*tt) - a/k) + x[2]*t*e);
+        grad[5] = f * x[3]*(t*e1/(k1*tt) - a1/k1 + t*e1);
+    }
 
 
-    CubicBSplinesFitting::CubicBSplinesFitting(const std::vector<Time>& knots,
-                                               bool constrainAtZero)
-    : FittedBondDiscountCurve::FittingMethod(constrainAtZero),
+
+    CubicBSplinesFitting::CubicBSplinesFitting(
+                      const std::vector<Time>& knots,
+                      bool constrainAtZero,
+                      const boost::shared_ptr<OptimizationMethod>& optMethod)
+    : FittedBondDiscountCurve::FittingMethod(constrainAtZero, optMethod),
       splines_(3, knots.size()-5, knots) {
 
         QL_REQUIRE(knots.size() >= 8,
@@ -183,10 +249,27 @@ namespace QuantLib {
         return d;
     }
 
+    void CubicBSplinesFitting::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                grad[i] = splines_(i,t);
+        } else {
+            const Real T = 0.0;
+            Real ratio = splines_(N_,t)/splines_(N_,T);
+            for (Size i=0; i<size_; ++i) {
+                Size j = (i < N_) ? i : i+1;
+                grad[i] = splines_(j,t) - splines_(j,T)*ratio;
+            }
+        }
+    }
+
 
-    SimplePolynomialFitting::SimplePolynomialFitting(Natural degree,
-                                                     bool constrainAtZero)
-    : FittedBondDiscountCurve::FittingMethod(constrainAtZero),
+    SimplePolynomialFitting::SimplePolynomialFitting(
+                      Natural degree,
+                      bool constrainAtZero,
+                      const boost::shared_ptr<OptimizationMethod>& optMethod)
+    : FittedBondDiscountCurve::FittingMethod(constrainAtZero, optMethod),
       size_(constrainAtZero ? degree : degree+1) {}
 
     std::auto_ptr<FittedBondDiscountCurve::FittingMethod>
@@ -214,5 +297,14 @@ namespace QuantLib {
         return d;
     }
 
+    void SimplePolynomialFitting::discountFunctionGradient(
+                                   Array& grad, const Array& x, Time t) const {
+        for (Size i=0; i<size_; ++i) {
+            grad[i] = constrainAtZero_ ?
+                BernsteinPolynomial::get(i+1,i+1,t) :
+                BernsteinPolynomial::get(i,i,t);
+        }
+    }
+
 }
 
@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -109,6 +110,51 @@ namespace QuantLib {
 
     }
 
+    std::vector<DiscountFactor> YieldTermStructure::discount(
+                                           const std::vector<Date>& dates,
+                                           bool extrapolate) const {
+        std::vector<Time> times(dates.size());
+        for (Size i=0; i<dates.size(); ++i)
+            times[i] = timeFromReference(dates[i]);
+        return discount(times, extrapolate);
+    }
+
+    std::vector<DiscountFactor> YieldTermStructure::discount(
+                                           const std::vector<Time>& times,
+                                           bool extrapolate) const {
+        std::vector<DiscountFactor> result(times.size());
+        if (times.empty())
+            return result;
+
+        // the range is checked at the two ends only
+        Time tMin = *std::min_element(times.begin(), times.end());
+        Time tMax = *std::max_element(times.begin(), times.end());
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        for (Size j=0; j<times.size(); ++j)
+            result[j] = discountImpl(times[j]);
+
+        if (jumps_.empty())
+            return result;
+
+        for (Size i=0; i<nJumps_; ++i) {
+            if (jumpTimes_[i]>0 && jumpTimes_[i]<tMax) {
+                QL_REQUIRE(jumps_[i]->isValid(),
+                           "invalid " << io::ordinal(i+1) << " jump quote");
+                DiscountFactor thisJump = jumps_[i]->value();
+                QL_REQUIRE(thisJump>0.0 && thisJump<=1.0,
+                           "invalid " << io::ordinal(i+1) << " jump value: " <<
+                           thisJump);
+                for (Size j=0; j<times.size(); ++j) {
+                    if (jumpTimes_[i]<times[j])
+                        result[j] *= thisJump;
+                }
+            }
+        }
+        return result;
+    }
+
     InterestRate YieldTermStructure::zeroRate(const Date& d,
                                               const DayCounter& dayCounter,
                                               Compounding comp,
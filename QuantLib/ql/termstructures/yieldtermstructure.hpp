@@ -77,6 +77,20 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Returns the discount factors for a set of dates.  The
+            range check and the jump bookkeeping are performed once
+            for the whole set; this is more efficient than repeated
+            calls to the scalar overload when a number of discount
+            factors are required at once (e.g., when projecting the
+            forward rates of a whole leg.)
+        */
+        std::vector<DiscountFactor> discount(const std::vector<Date>& dates,
+                                             bool extrapolate = false) const;
+        /*! The same day-counting rule used by the term structure
+            should be used for calculating the passed times.
+        */
+        std::vector<DiscountFactor> discount(const std::vector<Time>& times,
+                                             bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -28,6 +28,7 @@
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdshoutengine.hpp>
+#include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -437,6 +438,95 @@ void AmericanOptionTest::testFdValues() {
 }
 
 
+void AmericanOptionTest::testBinomialSmoothing() {
+
+    BOOST_TEST_MESSAGE("Testing smoothed and extrapolated binomial engine "
+                       "for American options...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(0.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.0));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    std::map<std::string,Real> calculated, expected, tolerance;
+    // relative tolerances; the tree theta is the crudest estimate
+    tolerance["value"] = 1.0e-3;
+    tolerance["delta"] = 2.0e-3;
+    tolerance["gamma"] = 1.0e-2;
+    tolerance["theta"] = 5.0e-2;
+
+    for (Size i=0; i<LENGTH(juValues); i++) {
+
+        boost::shared_ptr<StrikedTypePayoff> payoff(new
+            PlainVanillaPayoff(juValues[i].type, juValues[i].strike));
+        Date exDate = today + Integer(juValues[i].t*360+0.5);
+        boost::shared_ptr<Exercise> exercise(
+                                         new AmericanExercise(today, exDate));
+
+        spot ->setValue(juValues[i].s);
+        qRate->setValue(juValues[i].q);
+        rRate->setValue(juValues[i].r);
+        vol  ->setValue(juValues[i].v);
+
+        boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+            BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+        VanillaOption option(payoff, exercise);
+
+        // reference: average of plain trees with many steps, which
+        // removes most of their odd-even oscillation
+        expected["value"] = expected["delta"] = 0.0;
+        expected["gamma"] = expected["theta"] = 0.0;
+        for (Size steps=2000; steps<2002; ++steps) {
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new BinomialVanillaEngine<CoxRossRubinstein>(stochProcess,
+                                                             steps)));
+            expected["value"] += 0.5*option.NPV();
+            expected["delta"] += 0.5*option.delta();
+            expected["gamma"] += 0.5*option.gamma();
+            expected["theta"] += 0.5*option.theta();
+        }
+
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new BinomialVanillaEngine<CoxRossRubinstein>(stochProcess,
+                                                         100, true)));
+        calculated["value"] = option.NPV();
+        calculated["delta"] = option.delta();
+        calculated["gamma"] = option.gamma();
+        calculated["theta"] = option.theta();
+
+        // the reference theta is obtained from the Black-Scholes
+        // equation, which doesn't hold if the option is exercised
+        if (expected["value"] < (*payoff)(juValues[i].s) + 1.0e-4)
+            calculated.erase("theta");
+
+        std::map<std::string,Real>::iterator it;
+        for (it = calculated.begin(); it != calculated.end(); ++it) {
+            std::string greek = it->first;
+            Real error = relativeError(expected[greek], calculated[greek],
+                                       expected[greek]);
+            if (error > tolerance[greek]) {
+                REPORT_FAILURE(greek, payoff, exercise, juValues[i].s,
+                               juValues[i].q, juValues[i].r, today,
+                               juValues[i].v, expected[greek],
+                               calculated[greek], error, tolerance[greek]);
+            }
+        }
+    }
+}
+
+
 namespace {
 
     template <class Engine>
@@ -583,6 +673,8 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testBinomialSmoothing));
     return suite;
 }
 
@@ -33,6 +33,7 @@
 #include <ql/pricingengines/barrier/binomialbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
@@ -436,6 +437,23 @@ void BarrierOptionTest::testHaugValues() {
                            expected, calculated, error, tol);
         }
 
+        if (values[i].barrierType == Barrier::DownOut ||
+            values[i].barrierType == Barrier::UpOut) {
+            // smoothing is only available for knock-out options
+            engine = boost::make_shared<BinomialBarrierEngine<CoxRossRubinstein,DiscretizedBarrierOption> >(stochProcess, 400, 0, true);
+            barrierOption.setPricingEngine(engine);
+
+            calculated = barrierOption.NPV();
+            expected = values[i].result;
+            error = std::fabs(calculated-expected);
+            if (error>tol) {
+                REPORT_FAILURE("Binomial (smoothed) value", values[i].barrierType, values[i].barrier,
+                               values[i].rebate, payoff, exercise, values[i].s,
+                               values[i].q, values[i].r, today, values[i].v,
+                               expected, calculated, error, tol);
+            }
+        }
+
         // Note: here, to test Derman convergence, we force maxTimeSteps to 
         // timeSteps, effectively disabling Boyle-Lau barrier adjustment.
         // Production code should always enable Boyle-Lau. In most cases it
@@ -1297,6 +1315,171 @@ void BarrierOptionTest::testVannaVolgaDoubleBarrierValues() {
     }
 }
 
+void BarrierOptionTest::testFdMultipleStrikesEngines() {
+    BOOST_TEST_MESSAGE("Testing multiple-strikes FD Black-Scholes engines...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual360();
+    const Date today = Date(28, July, 2014);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        boost::make_shared<BlackScholesMertonProcess>(
+            spot,
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    Real k[] = { 100.0, 80.0, 90.0, 110.0, 120.0 };
+    const std::vector<Real> strikes(k, k+LENGTH(k));
+
+    const Date exDate = today + 360;
+    const boost::shared_ptr<Exercise> europeanExercise =
+        boost::make_shared<EuropeanExercise>(exDate);
+    const boost::shared_ptr<Exercise> americanExercise =
+        boost::make_shared<AmericanExercise>(today, exDate);
+
+    const Size tGrid = 100, xGrid = 400;
+    const Real tol = 2.5e-3;
+
+    // vanilla strip; without a damping step the gamma at the strike
+    // oscillates and is no reference for the strip
+    const Size dampingSteps = 1;
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> singleVanillaEngine =
+        boost::make_shared<FdBlackScholesVanillaEngine>(
+                                       process, tGrid, xGrid, dampingSteps);
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> multiVanillaEngine =
+        boost::make_shared<FdBlackScholesVanillaEngine>(
+                                       process, tGrid, xGrid, dampingSteps);
+    multiVanillaEngine->enableMultipleStrikesCaching(strikes);
+
+    for (Size i=0; i < strikes.size(); ++i) {
+        VanillaOption option(
+            boost::make_shared<PlainVanillaPayoff>(Option::Put, strikes[i]),
+            americanExercise);
+
+        option.setPricingEngine(multiVanillaEngine);
+        const Real npvCalculated = option.NPV();
+        const Real deltaCalculated = option.delta();
+        const Real gammaCalculated = option.gamma();
+
+        option.setPricingEngine(singleVanillaEngine);
+        const Real npvExpected = option.NPV();
+        const Real deltaExpected = option.delta();
+        const Real gammaExpected = option.gamma();
+
+        if (std::fabs(npvCalculated - npvExpected) > tol
+            || std::fabs(deltaCalculated - deltaExpected) > tol
+            || std::fabs(gammaCalculated - gammaExpected) > tol) {
+            BOOST_ERROR("failed to reproduce american put with "
+                        "multiple-strikes FD engine"
+                        << "\n    strike:         " << strikes[i]
+                        << "\n    npv calculated: " << npvCalculated
+                        << "\n    npv expected:   " << npvExpected
+                        << "\n    delta calc.:    " << deltaCalculated
+                        << "\n    delta expected: " << deltaExpected
+                        << "\n    gamma calc.:    " << gammaCalculated
+                        << "\n    gamma expected: " << gammaExpected);
+        }
+    }
+
+    // barrier strips; the up-and-in option is a put, since a call
+    // knocked in at the barrier has a payoff jump there with which the
+    // FD engines converge only to first order in the grid size
+    const Barrier::Type types[] = { Barrier::DownOut, Barrier::UpIn };
+    const Option::Type optionTypes[] = { Option::Call, Option::Put };
+    const Real barriers[] = { 85.0, 130.0 };
+    const Real rebate = 2.0;
+
+    const boost::shared_ptr<PricingEngine> analyticEngine =
+        boost::make_shared<AnalyticBarrierEngine>(process);
+
+    for (Size j=0; j < LENGTH(types); ++j) {
+        const boost::shared_ptr<FdBlackScholesBarrierEngine> multiEngine =
+            boost::make_shared<FdBlackScholesBarrierEngine>(
+                                                   process, tGrid, xGrid);
+        multiEngine->enableMultipleStrikesCaching(strikes);
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            BarrierOption option(types[j], barriers[j], rebate,
+                boost::make_shared<PlainVanillaPayoff>(optionTypes[j],
+                                                       strikes[i]),
+                europeanExercise);
+
+            option.setPricingEngine(multiEngine);
+            const Real calculated = option.NPV();
+
+            option.setPricingEngine(analyticEngine);
+            const Real expected = option.NPV();
+
+            if (std::fabs(calculated - expected) > 5.0e-3) {
+                BOOST_ERROR("failed to reproduce barrier option with "
+                            "multiple-strikes FD engine"
+                            << "\n    barrier type: " << types[j]
+                            << "\n    option type:  " << optionTypes[j]
+                            << "\n    barrier:      " << barriers[j]
+                            << "\n    strike:       " << strikes[i]
+                            << "\n    calculated:   " << calculated
+                            << "\n    expected:     " << expected);
+            }
+        }
+    }
+
+    // with a smile the strip cannot share one operator and the
+    // options must be priced one by one
+    std::vector<Date> volDates;
+    volDates.push_back(today + 180);
+    volDates.push_back(today + 360);
+    std::vector<Real> volStrikes;
+    volStrikes.push_back(80.0);
+    volStrikes.push_back(100.0);
+    volStrikes.push_back(120.0);
+    Matrix vols(volStrikes.size(), volDates.size());
+    vols[0][0] = 0.32; vols[0][1] = 0.30;
+    vols[1][0] = 0.25; vols[1][1] = 0.25;
+    vols[2][0] = 0.22; vols[2][1] = 0.23;
+
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> smileProcess =
+        boost::make_shared<BlackScholesMertonProcess>(
+            spot,
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(
+                boost::make_shared<BlackVarianceSurface>(
+                    today, NullCalendar(), volDates, volStrikes, vols, dc)));
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> singleSmileEngine =
+        boost::make_shared<FdBlackScholesVanillaEngine>(
+                                  smileProcess, tGrid, xGrid, dampingSteps);
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> multiSmileEngine =
+        boost::make_shared<FdBlackScholesVanillaEngine>(
+                                  smileProcess, tGrid, xGrid, dampingSteps);
+    multiSmileEngine->enableMultipleStrikesCaching(strikes);
+
+    for (Size i=0; i < strikes.size(); ++i) {
+        VanillaOption option(
+            boost::make_shared<PlainVanillaPayoff>(Option::Put, strikes[i]),
+            americanExercise);
+
+        option.setPricingEngine(multiSmileEngine);
+        const Real calculated = option.NPV();
+
+        option.setPricingEngine(singleSmileEngine);
+        const Real expected = option.NPV();
+
+        if (std::fabs(calculated - expected) > 1e-12) {
+            BOOST_ERROR("failed to price american put with a smile "
+                        "using the multiple-strikes FD engine"
+                        << std::setprecision(12)
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        }
+    }
+}
+
 
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
@@ -1305,6 +1488,8 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBeagleholeValues));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &BarrierOptionTest::testFdMultipleStrikesEngines));
     return suite;
 }
 
@@ -32,6 +32,7 @@ class BarrierOptionTest {
     static void testBeagleholeValues();
     static void testPerturbative();
     static void testLocalVolAndHestonComparison();
+    static void testFdMultipleStrikesEngines();
     static void testVannaVolgaSimpleBarrierValues();
     static void testVannaVolgaDoubleBarrierValues();
     static boost::unit_test_framework::test_suite* suite();
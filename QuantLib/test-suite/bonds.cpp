@@ -44,6 +44,8 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/pricingengines/bond/batchbondanalytics.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1296,6 +1298,128 @@ void BondTest::testExCouponAustralianBond() {
 }
 
 
+void BondTest::testBatchAnalytics() {
+
+    BOOST_TEST_MESSAGE(
+              "Testing batch bond analytics against scalar calculations...");
+
+    CommonVars vars;
+
+    Real accuracy = 1.0e-10;
+    Real tolerance = 1.0e-8;
+
+    // the second curve ends before the longest maturities and must
+    // be extrapolated
+    std::vector<Date> curveDates;
+    curveDates.push_back(vars.today);
+    curveDates.push_back(vars.today + 2*Years);
+    curveDates.push_back(vars.today + 10*Years);
+    std::vector<Rate> curveRates;
+    curveRates.push_back(0.02);
+    curveRates.push_back(0.03);
+    curveRates.push_back(0.04);
+    shared_ptr<YieldTermStructure> shortCurve(
+                        new ZeroCurve(curveDates, curveRates, Actual360()));
+    shortCurve->enableExtrapolation();
+
+    shared_ptr<YieldTermStructure> discountCurves[] = {
+        flatRate(vars.today,0.03,Actual360()),
+        shortCurve
+    };
+
+    Integer issueMonths[] = { -24, -18, -12, -6, 0, 6, 12 };
+    Integer lengths[] = { 3, 5, 10, 20 };
+    Natural settlementDays = 3;
+    Real coupons[] = { 0.02, 0.05, 0.08 };
+    Frequency frequency = Semiannual;
+    DayCounter bondDayCount = Thirty360();
+    Compounding compounding[] = { Compounded, Continuous };
+
+    std::vector<shared_ptr<Bond> > bonds;
+    for (Size i=0; i<LENGTH(issueMonths); i++) {
+        for (Size j=0; j<LENGTH(lengths); j++) {
+            for (Size k=0; k<LENGTH(coupons); k++) {
+                Date issue = vars.calendar.advance(vars.today,
+                                                   issueMonths[i], Months);
+                Date maturity = vars.calendar.advance(issue,
+                                                      lengths[j], Years);
+                Schedule sch(issue, maturity, Period(frequency),
+                             vars.calendar, Unadjusted, Unadjusted,
+                             DateGeneration::Backward, false);
+                bonds.push_back(shared_ptr<Bond>(
+                    new FixedRateBond(settlementDays, vars.faceAmount, sch,
+                                      std::vector<Rate>(1, coupons[k]),
+                                      bondDayCount, ModifiedFollowing,
+                                      100.0, issue)));
+            }
+        }
+    }
+
+    for (Size n=0; n<LENGTH(compounding); n++) {
+
+        BatchBondAnalytics batch(bonds, bondDayCount,
+                                 compounding[n], frequency);
+
+        std::vector<Real> prices(bonds.size());
+        for (Size i=0; i<bonds.size(); ++i)
+            prices[i] = 80.0 + 2.5*(i%17);
+
+        // the second pass is warm-started from the first
+        for (Size pass=0; pass<2; ++pass) {
+            if (pass == 1) {
+                for (Size i=0; i<bonds.size(); ++i)
+                    prices[i] += 0.01;
+            }
+
+            std::vector<Rate> yields = batch.yields(prices, accuracy);
+            std::vector<Time> durations =
+                batch.durations(yields, Duration::Modified);
+
+            for (Size i=0; i<bonds.size(); ++i) {
+                Rate yield = BondFunctions::yield(*bonds[i], prices[i],
+                                                  bondDayCount,
+                                                  compounding[n], frequency,
+                                                  Date(), accuracy);
+                Time duration = BondFunctions::duration(*bonds[i], yields[i],
+                                                        bondDayCount,
+                                                        compounding[n],
+                                                        frequency,
+                                                        Duration::Modified);
+                Real price = batch.cleanPrices(yields)[i];
+
+                ASSERT_CLOSE("batch yield", bonds[i]->settlementDate(),
+                             yields[i], yield, tolerance);
+                ASSERT_CLOSE("batch duration", bonds[i]->settlementDate(),
+                             durations[i], duration, tolerance);
+                ASSERT_CLOSE("batch clean price", bonds[i]->settlementDate(),
+                             price, prices[i], tolerance);
+            }
+
+            for (Size c=0; c<LENGTH(discountCurves); c++) {
+                if (c > 0) {
+                    // the warm start refers to the previous curve
+                    batch.setZSpreadGuesses(
+                               std::vector<Spread>(bonds.size(), 0.0));
+                }
+                std::vector<Spread> spreads =
+                    batch.zSpreads(prices, discountCurves[c], accuracy);
+                for (Size i=0; i<bonds.size(); ++i) {
+                    Spread spread =
+                        BondFunctions::zSpread(*bonds[i], prices[i],
+                                               discountCurves[c],
+                                               bondDayCount,
+                                               compounding[n], frequency,
+                                               Date(), accuracy);
+                    ASSERT_CLOSE("batch z-spread",
+                                 bonds[i]->settlementDate(),
+                                 spreads[i], spread, tolerance);
+                }
+            }
+        }
+    }
+}
+
+
 test_suite* BondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bond tests");
 
@@ -1310,6 +1434,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testBrazilianCached));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testExCouponGilt));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testExCouponAustralianBond));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatchAnalytics));
     return suite;
 }
 
@@ -38,6 +38,7 @@ class BondTest {
     static void testBrazilianCached();
     static void testExCouponGilt();
     static void testExCouponAustralianBond();
+    static void testBatchAnalytics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -264,11 +264,82 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+void CashFlowsTest::testLegSwapletRates() {
+    BOOST_TEST_MESSAGE("Testing leg-level swaplet rates in Black pricer...");
+
+    SavedSettings backup;
+
+    Date today(7, April, 2010);
+    Settings::instance().evaluationDate() = today;
+    Calendar calendar = TARGET();
+
+    Handle<YieldTermStructure> forwarding(
+        flatRate(today, 0.04, Actual365Fixed()));
+    Handle<OptionletVolatilityStructure> vol(
+        boost::shared_ptr<OptionletVolatilityStructure>(
+            new ConstantOptionletVolatility(0, calendar, ModifiedFollowing,
+                                            0.20, Actual365Fixed())));
+
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months, forwarding));
+    index->clearFixings();
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-9*Months).to(today+10*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(calendar)
+        .withConvention(ModifiedFollowing)
+        .backwards();
+
+    // fixings for the seasoned part of the legs (both in advance
+    // and in arrears)
+    for (Size i=0; i<schedule.size(); ++i) {
+        Date fixingDate =
+            index->fixingCalendar().advance(schedule[i], -2, Days);
+        if (fixingDate < today)
+            index->addFixing(fixingDate, 0.01 + 0.001*i);
+    }
+
+    for (Size k=0; k<2; ++k) {
+        bool inArrears = (k == 1);
+        Leg leg = IborLeg(schedule, index)
+            .withNotionals(100.0)
+            .withSpreads(0.0025)
+            .withGearings(1.5)
+            .inArrears(inArrears);
+
+        boost::shared_ptr<IborCouponPricer> pricer(
+                                            new BlackIborCouponPricer(vol));
+        setCouponPricer(leg, pricer);
+
+        std::vector<Rate> rates = pricer->swapletRates(leg);
+
+        if (rates.size() != leg.size())
+            BOOST_FAIL("wrong number of rates returned: " << rates.size()
+                       << " instead of " << leg.size());
+
+        for (Size i=0; i<leg.size(); ++i) {
+            boost::shared_ptr<FloatingRateCoupon> c =
+                boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            Rate expected = c->rate();
+            if (std::fabs(rates[i] - expected) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce coupon rate"
+                            << (inArrears ? " (in arrears)" : "") << ":"
+                            << "\n    fixing date: " << c->fixingDate()
+                            << "\n    calculated:  " << rates[i]
+                            << "\n    expected:    " << expected);
+        }
+    }
+
+    index->clearFixings();
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testAccessViolation));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testDefaultSettlementDate));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testLegSwapletRates));
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
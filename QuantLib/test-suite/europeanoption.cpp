@@ -30,6 +30,7 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/fdrichardsonextrapolationengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
@@ -39,6 +40,7 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <boost/bind.hpp>
 #include <boost/progress.hpp>
 #include <map>
 
@@ -1513,6 +1515,77 @@ void EuropeanOptionTest::testLocalVolatility() {
     }
 }
 
+namespace {
+
+    boost::shared_ptr<PricingEngine> makeFdBlackScholesEngine(
+           const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+           Size refinement) {
+        return boost::shared_ptr<PricingEngine>(
+            new FdBlackScholesVanillaEngine(process, 10*refinement,
+                                            25*refinement, 2));
+    }
+
+}
+
+void EuropeanOptionTest::testFdRichardsonExtrapolation() {
+
+    BOOST_TEST_MESSAGE("Testing grid convergence of FD engines "
+                       "with Richardson extrapolation...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual360();
+    const Date today = Date(28, July, 2014);
+    Settings::instance().evaluationDate() = today;
+
+    const boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, flatRate(today, 0.02, dc),
+                    flatRate(today, 0.05, dc), flatVol(today, 0.2, dc));
+
+    const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, 100.0));
+    const boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(today + 360));
+
+    EuropeanOption option(payoff, exercise);
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    const Real expected = option.NPV();
+
+    const Real tolerance = 1e-3;
+    typedef FdRichardsonExtrapolationEngine<DividendVanillaOption::arguments,
+                                            DividendVanillaOption::results>
+                                                        RichardsonEngine;
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new RichardsonEngine(boost::bind(&makeFdBlackScholesEngine,
+                                         process, _1),
+                             tolerance)));
+
+    const Real calculated = option.NPV();
+    const Real errorEstimate = option.errorEstimate();
+    const Size refinement = option.result<Size>("gridRefinement");
+
+    if (errorEstimate > tolerance || refinement > 8) {
+        BOOST_ERROR("failed to reach the required tolerance"
+                    << "\n    tolerance:      " << tolerance
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    refinement:     " << refinement);
+    }
+    if (std::fabs(calculated - expected) > 2.0*tolerance) {
+        BOOST_ERROR("failed to reproduce option price "
+                    "with Richardson extrapolation"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error:          "
+                    << std::fabs(calculated - expected)
+                    << "\n    error estimate: " << errorEstimate);
+    }
+    if (option.result<Real>("errorEstimate") != errorEstimate) {
+        BOOST_ERROR("error estimate not available in additional results");
+    }
+}
+
 
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
@@ -1541,6 +1614,8 @@ test_suite* EuropeanOptionTest::suite() {
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &EuropeanOptionTest::testFdRichardsonExtrapolation));
 
     return suite;
 }
@@ -58,6 +58,7 @@
 #include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmsquarerootfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdmfwdsurfacesolver.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -345,6 +346,88 @@ void FdHestonTest::testFdmHestonAmerican() {
 }
 
 
+void FdHestonTest::testFdmHestonImplicitSolvers() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing FDM Heston engine with implicit Euler "
+                       "Krylov solvers and ILU preconditioner...");
+
+    SavedSettings backup;
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8))));
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(new
+                                      PlainVanillaPayoff(Option::Put, 100));
+    VanillaOption option(payoff, exercise);
+
+    // the solvers are run to the same relative tolerance, so that the
+    // results must agree with those of the default BiCGstab solver
+    // with the preconditioner of the operator
+    const Size tGrid = 20, xGrid = 51, vGrid = 21;
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdHestonVanillaEngine(model, tGrid, xGrid, vGrid, 0,
+                                  FdmSchemeDesc::ImplicitEuler())));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdHestonVanillaEngine(model, tGrid, xGrid, vGrid, 2,
+                                  FdmSchemeDesc::Douglas())));
+    const Real expectedDamped = option.NPV();
+
+    const ImplicitEulerScheme::SolverType solverTypes[] =
+        { ImplicitEulerScheme::BiCGstab, ImplicitEulerScheme::GMRES };
+    const std::string solverNames[] = { "BiCGstab", "GMRES" };
+    const Integer iluFills[] = { Null<Integer>(), 2 };
+    const Real tol = 1e-6;
+
+    for (Size i=0; i < LENGTH(solverTypes); ++i) {
+        for (Size j=0; j < LENGTH(iluFills); ++j) {
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FdHestonVanillaEngine(model, tGrid, xGrid, vGrid, 0,
+                    FdmSchemeDesc::ImplicitEuler(solverTypes[i],
+                                                 iluFills[j]))));
+            Real calculated = option.NPV();
+            if (std::fabs(calculated - expected) > tol) {
+                BOOST_ERROR("failed to reproduce implicit Euler npv"
+                            << std::setprecision(10)
+                            << "\n    solver:            " << solverNames[i]
+                            << "\n    ILU factorization: "
+                            << (iluFills[j] == Null<Integer>() ? "no":"yes")
+                            << "\n    calculated:        " << calculated
+                            << "\n    expected:          " << expected);
+            }
+
+            // the damping steps of other schemes use the same solver
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FdHestonVanillaEngine(model, tGrid, xGrid, vGrid, 2,
+                    FdmSchemeDesc::Douglas().withImplicitSolver(
+                                            solverTypes[i], iluFills[j]))));
+            calculated = option.NPV();
+            if (std::fabs(calculated - expectedDamped) > tol) {
+                BOOST_ERROR("failed to reproduce damped Douglas npv"
+                            << std::setprecision(10)
+                            << "\n    solver:            " << solverNames[i]
+                            << "\n    ILU factorization: "
+                            << (iluFills[j] == Null<Integer>() ? "no":"yes")
+                            << "\n    calculated:        " << calculated
+                            << "\n    expected:          "
+                            << expectedDamped);
+            }
+        }
+    }
+#endif
+}
+
 void FdHestonTest::testFdmHestonIkonenToivanen() {
 
     BOOST_TEST_MESSAGE("Testing FDM Heston for Ikonen and Toivanen tests...");
@@ -1281,6 +1364,106 @@ void FdHestonTest::testHestonFokkerPlanckFwdEquation() {
     }
 }
 
+void FdHestonTest::testFokkerPlanckFwdSurface() {
+    BOOST_TEST_MESSAGE("Testing option surfaces priced with a single "
+                       "Fokker-Planck forward solve...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate = Date(28, Dec, 2012);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Real s0 = 100;
+    const Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(s0)));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+    const Handle<BlackVolTermStructure> vTS(flatVol(0.25, dc));
+
+    const Integer days[] = { 91, 182, 365, 730 };
+    const Real strikes[] = { 70, 85, 100, 115, 130 };
+
+    std::vector<Time> maturities;
+    std::vector<boost::shared_ptr<Exercise> > exercises;
+    for (Size i=0; i < LENGTH(days); ++i) {
+        const Date maturityDate = todaysDate + days[i];
+        maturities.push_back(dc.yearFraction(todaysDate, maturityDate));
+        exercises.push_back(boost::shared_ptr<Exercise>(
+                                      new EuropeanExercise(maturityDate)));
+    }
+
+    // Black-Scholes, with Black and with local volatility
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess(
+        new GeneralizedBlackScholesProcess(spot, qTS, rTS, vTS));
+    const boost::shared_ptr<PricingEngine> bsEngine(
+        new AnalyticEuropeanEngine(bsProcess));
+
+    const bool localVol[] = { false, true };
+    for (Size k=0; k < LENGTH(localVol); ++k) {
+        const FdmBlackScholesFwdSurfaceSolver bsSolver(
+            bsProcess, maturities, 401, 200, 2, localVol[k]);
+
+        const Matrix npvs = bsSolver.npvs(
+            std::vector<Real>(strikes, strikes+LENGTH(strikes)),
+            Option::Call);
+
+        for (Size i=0; i < LENGTH(strikes); ++i) {
+            for (Size j=0; j < maturities.size(); ++j) {
+                VanillaOption option(boost::shared_ptr<StrikedTypePayoff>(
+                    new PlainVanillaPayoff(Option::Call, strikes[i])),
+                    exercises[j]);
+                option.setPricingEngine(bsEngine);
+
+                const Real expected = option.NPV();
+                const Real calculated = npvs[i][j];
+                const Real tol = 0.02;
+                if (std::fabs(expected - calculated) > tol) {
+                    BOOST_ERROR("failed to reproduce Black-Scholes surface"
+                               << "\n   local vol:  " << localVol[k]
+                               << "\n   strike:     " << strikes[i]
+                               << "\n   maturity:   " << maturities[j]
+                               << QL_FIXED << std::setprecision(5)
+                               << "\n   calculated: " << calculated
+                               << "\n   expected:   " << expected
+                               << "\n   tolerance:  " << tol);
+                }
+            }
+        }
+    }
+
+    // Heston
+    const boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, spot, 0.04, 1.5, 0.05, 0.3, -0.6));
+    const boost::shared_ptr<PricingEngine> hestonEngine(
+        new AnalyticHestonEngine(boost::shared_ptr<HestonModel>(
+                                         new HestonModel(hestonProcess))));
+
+    const FdmHestonFwdSurfaceSolver hestonSolver(hestonProcess, maturities);
+
+    for (Size i=0; i < LENGTH(strikes); ++i) {
+        const Option::Type type = (strikes[i] > s0) ? Option::Call
+                                                    : Option::Put;
+        for (Size j=0; j < maturities.size(); ++j) {
+            VanillaOption option(boost::shared_ptr<StrikedTypePayoff>(
+                new PlainVanillaPayoff(type, strikes[i])), exercises[j]);
+            option.setPricingEngine(hestonEngine);
+
+            const Real expected = option.NPV();
+            const Real calculated = hestonSolver.npv(j, strikes[i], type);
+            const Real tol = 0.2;
+            if (std::fabs(expected - calculated) > tol) {
+                BOOST_ERROR("failed to reproduce Heston surface"
+                           << "\n   strike:     " << strikes[i]
+                           << "\n   maturity:   " << maturities[j]
+                           << QL_FIXED << std::setprecision(5)
+                           << "\n   calculated: " << calculated
+                           << "\n   expected:   " << expected
+                           << "\n   tolerance:  " << tol);
+            }
+        }
+    }
+}
+
 test_suite* FdHestonTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBarrier));
@@ -1293,6 +1476,8 @@ test_suite* FdHestonTest::suite() {
                     &FdHestonTest::testFdmHestonEuropeanWithDividends));
 
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonConvergence));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &FdHestonTest::testFdmHestonImplicitSolvers));
     return suite;
 }
 
@@ -1308,6 +1493,8 @@ test_suite* FdHestonTest::experimental() {
         &FdHestonTest::testSquareRootFokkerPlanckFwdEquation));
     suite->add(QUANTLIB_TEST_CASE(
         &FdHestonTest::testHestonFokkerPlanckFwdEquation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testFokkerPlanckFwdSurface));
 
     return suite;
 }
@@ -34,12 +34,14 @@ public:
     static void testFdmHestonEuropeanWithDividends();
     static void testFdmHestonConvergence();
     static void testFdmHestonBlackScholes();
+    static void testFdmHestonImplicitSolvers();
     static void testBlackScholesFokkerPlanckFwdEquation();
     static void testSquareRootZeroFlowBC();
     static void testTransformedZeroFlowBC();
     static void testSquareRootEvolveWithStationaryDensity();
     static void testSquareRootFokkerPlanckFwdEquation();
     static void testHestonFokkerPlanckFwdEquation();
+    static void testFokkerPlanckFwdSurface();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
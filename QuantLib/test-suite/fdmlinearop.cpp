@@ -32,6 +32,7 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/exercise.hpp>
 #include <ql/math/integrals/discreteintegrals.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
@@ -52,6 +53,7 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalcubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
@@ -82,6 +84,8 @@
 #pragma GCC diagnostic pop
 #endif
 #include <numeric>
+#include <iomanip>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1069,6 +1073,142 @@ void FdmLinearOpTest::testFdmHestonHullWhiteOp() {
     }
 }
 
+void FdmLinearOpTest::testLocalCubicInterpolation() {
+    BOOST_TEST_MESSAGE("Testing local cubic interpolation of FDM results...");
+
+    SavedSettings backup;
+
+    // a polynomial of degree three in each direction is reproduced
+    // exactly, including its derivatives
+    const boost::shared_ptr<FdmMesher> polyMesher(new FdmMesherComposite(
+        boost::shared_ptr<Fdm1dMesher>(new Concentrating1dMesher(
+            -1.0, 2.0, 21, std::pair<Real, Real>(0.5, 0.1))),
+        boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0.0, 1.0, 11)),
+        boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(-0.5, 0.5, 3))));
+
+    Array p(polyMesher->layout()->size());
+    const FdmLinearOpIterator polyEnd = polyMesher->layout()->end();
+    for (FdmLinearOpIterator iter = polyMesher->layout()->begin();
+         iter != polyEnd; ++iter) {
+        const Real x = polyMesher->location(iter, 0);
+        const Real y = polyMesher->location(iter, 1);
+        const Real z = polyMesher->location(iter, 2);
+        p[iter.index()] = x*x*x - 2.0*x*y*y + y*y*y*z + 3.0*z*z - 1.0;
+    }
+
+    const FdmLocalCubicInterpolation polyInterp(polyMesher, p);
+    const Real tol = 1e-10;
+    for (Size i=0; i < 20; ++i) {
+        std::vector<Real> v(3);
+        v[0] = -1.0 + 0.15*i; v[1] = 0.05*i; v[2] = -0.5 + 0.05*i;
+        const Real x = v[0], y = v[1], z = v[2];
+
+        const Real expected[] = {
+            x*x*x - 2.0*x*y*y + y*y*y*z + 3.0*z*z - 1.0,
+            3.0*x*x - 2.0*y*y, 6.0*x,
+            -4.0*x*y + 3.0*y*y*z, -4.0*x + 6.0*y*z };
+        const Real calculated[] = {
+            polyInterp(v),
+            polyInterp.derivative(v, 0), polyInterp.derivative(v, 0, 2),
+            polyInterp.derivative(v, 1), polyInterp.derivative(v, 1, 2) };
+
+        for (Size j=0; j < LENGTH(expected); ++j) {
+            if (std::fabs(expected[j] - calculated[j]) > tol) {
+                BOOST_FAIL("failed to reproduce cubic polynomial"
+                           << "\n    point      : " << x << ", " << y
+                           << ", " << z
+                           << "\n    index      : " << j
+                           << "\n    calculated : " << calculated[j]
+                           << "\n    expected   : " << expected[j]);
+            }
+        }
+    }
+
+    // the local interpolation of the Heston Hull-White solution must
+    // agree with the spline interpolation
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {51, 31, 31};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> linearOp(
+        new FdmHestonHullWhiteOp(desc.mesher,
+                                 jointProcess->hestonProcess(),
+                                 hwProcess,
+                                 jointProcess->eta()));
+
+    const FdmSchemeDesc schemeDesc = FdmSchemeDesc::Hundsdorfer();
+    const Fdm3DimSolver spline3d(desc, schemeDesc, linearOp);
+    const Fdm3DimSolver local3d(desc, schemeDesc, linearOp, true);
+    const FdmNdimSolver<3> splineNd(desc, schemeDesc, linearOp);
+    const FdmNdimSolver<3> localNd(desc, schemeDesc, linearOp, true);
+
+    const Real v0 = jointProcess->hestonProcess()->v0();
+    const Real spots[] = { 80.0, 100.0, 120.0 };
+    for (Size i=0; i < LENGTH(spots); ++i) {
+        std::vector<Real> x(3);
+        x[0] = std::log(spots[i]); x[1] = v0; x[2] = 0.0;
+
+        const Real expected[] = {
+            spline3d.interpolateAt(x[0], x[1], x[2]),
+            spline3d.thetaAt(x[0], x[1], x[2]),
+            splineNd.interpolateAt(x),
+            splineNd.thetaAt(x) };
+        const Real calculated[] = {
+            local3d.interpolateAt(x[0], x[1], x[2]),
+            local3d.thetaAt(x[0], x[1], x[2]),
+            localNd.interpolateAt(x),
+            localNd.thetaAt(x) };
+
+        for (Size j=0; j < LENGTH(expected); ++j) {
+            if (std::fabs(expected[j] - calculated[j]) > 1e-3) {
+                BOOST_FAIL("local and spline interpolation differ"
+                           << "\n    spot       : " << spots[i]
+                           << "\n    index      : " << j
+                           << "\n    local      : " << calculated[j]
+                           << "\n    spline     : " << expected[j]);
+            }
+        }
+
+        // derivatives in log-spot from the local stencil
+        const Real h = 1e-2;
+        std::vector<Real> xUp(x), xDown(x);
+        xUp[0] += h; xDown[0] -= h;
+        const Real fUp = splineNd.interpolateAt(xUp);
+        const Real fDown = splineNd.interpolateAt(xDown);
+
+        const Real fdFirst = (fUp - fDown)/(2*h);
+        const Real fdSecond = (fUp + fDown - 2*expected[2])/(h*h);
+        const Real first = localNd.derivativeAt(x, 0);
+        const Real second = localNd.derivativeAt(x, 0, 2);
+
+        if (std::fabs(fdFirst - first) > 1e-3*std::fabs(fdFirst)
+            || std::fabs(fdSecond - second) > 2e-2*std::fabs(fdSecond)) {
+            BOOST_FAIL("local derivatives differ from finite differences"
+                       << "\n    spot       : " << spots[i]
+                       << "\n    first      : " << first
+                       << "\n    fd first   : " << fdFirst
+                       << "\n    second     : " << second
+                       << "\n    fd second  : " << fdSecond);
+        }
+    }
+}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
 namespace {
     Disposable<Array> axpy(
@@ -1086,6 +1226,290 @@ namespace {
 #endif
 
 
+void FdmLinearOpTest::testInPlaceApplication() {
+    BOOST_TEST_MESSAGE("Testing in-place application of FDM operators...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    std::vector<boost::shared_ptr<FdmLinearOpComposite> > ops;
+    ops.push_back(boost::shared_ptr<FdmLinearOpComposite>(
+        new FdmHestonHullWhiteOp(mesher, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta())));
+    ops.push_back(boost::shared_ptr<FdmLinearOpComposite>(
+        new FdmHestonOp(mesher, jointProcess->hestonProcess())));
+
+    const Size n = mesher->layout()->size();
+    Array u(n), result(n), workspace(n);
+    for (Size i=0; i < n; ++i)
+        u[i] = std::sin(0.1*i) + 0.01*i;
+
+    const Real tol = 1e-14;
+    for (Size k=0; k < ops.size(); ++k) {
+        ops[k]->setTime(0.5, 0.6);
+
+        Array expected = ops[k]->apply(u);
+        ops[k]->apply(u, result);
+        Real diff = 0.0;
+        for (Size i=0; i < n; ++i)
+            diff = std::max(diff, std::fabs(expected[i] - result[i]));
+        if (diff > tol*std::sqrt(DotProduct(expected, expected)))
+            BOOST_ERROR("in-place apply differs from apply"
+                        << "\n    operator:   " << k
+                        << "\n    difference: " << diff);
+
+        expected = ops[k]->apply_mixed(u);
+        ops[k]->apply_mixed(u, result);
+        diff = 0.0;
+        for (Size i=0; i < n; ++i)
+            diff = std::max(diff, std::fabs(expected[i] - result[i]));
+        if (diff > tol*std::sqrt(DotProduct(expected, expected)))
+            BOOST_ERROR("in-place apply_mixed differs from apply_mixed"
+                        << "\n    operator:   " << k
+                        << "\n    difference: " << diff);
+
+        for (Size d=0; d < ops[k]->size(); ++d) {
+            expected = ops[k]->apply_direction(d, u);
+            ops[k]->apply_direction(d, u, result);
+            diff = 0.0;
+            for (Size i=0; i < n; ++i)
+                diff = std::max(diff, std::fabs(expected[i] - result[i]));
+            if (diff > tol*std::sqrt(DotProduct(expected, expected)))
+                BOOST_ERROR("in-place apply_direction differs "
+                            "from apply_direction"
+                            << "\n    operator:   " << k
+                            << "\n    direction:  " << d
+                            << "\n    difference: " << diff);
+
+            expected = ops[k]->solve_splitting(d, u, -0.05);
+            ops[k]->solve_splitting(d, u, -0.05, result, workspace);
+            diff = 0.0;
+            for (Size i=0; i < n; ++i)
+                diff = std::max(diff, std::fabs(expected[i] - result[i]));
+            if (diff > tol*std::sqrt(DotProduct(expected, expected)))
+                BOOST_ERROR("in-place solve_splitting differs "
+                            "from solve_splitting"
+                            << "\n    operator:   " << k
+                            << "\n    direction:  " << d
+                            << "\n    difference: " << diff);
+        }
+    }
+}
+
+void FdmLinearOpTest::testMultiThreadedLineSolves() {
+    BOOST_TEST_MESSAGE("Testing line-by-line solution of ADI splittings...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> op(
+        new FdmHestonHullWhiteOp(mesher, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta()));
+    op->setTime(0.5, 0.6);
+
+    // each splitting must solve (1 + a A_d) x = r on all grid lines
+    const Size n = mesher->layout()->size();
+    Array r(n), x(n), ax(n), workspace(n);
+    for (Size i=0; i < n; ++i)
+        r[i] = std::sin(0.1*i) + 0.01*i;
+
+    const Real a = -0.05, tol = 1e-10;
+    for (Size d=0; d < op->size(); ++d) {
+        op->solve_splitting(d, r, a, x, workspace);
+        op->apply_direction(d, x, ax);
+        Real maxError = 0.0;
+        for (Size i=0; i < n; ++i)
+            maxError = std::max(maxError, std::fabs(x[i] + a*ax[i] - r[i]));
+        if (maxError > tol)
+            BOOST_ERROR("failed to solve splitting"
+                        << "\n    direction: " << d
+                        << std::scientific
+                        << "\n    residual:  " << maxError);
+    }
+
+    // results must not depend on the number of threads
+    Array rhs(n);
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        rhs[iter.index()] = desc.calculator->avgInnerValue(iter, maturity);
+    }
+    Array rhs2 = rhs;
+
+    const FdmSchemeDesc scheme = FdmSchemeDesc::Hundsdorfer();
+    FdmBackwardSolver(op, desc.bcSet, boost::shared_ptr<
+                          FdmStepConditionComposite>(), scheme)
+        .rollback(rhs, maturity, 0.0, 10, 0);
+    FdmBackwardSolver(op, desc.bcSet, boost::shared_ptr<
+                          FdmStepConditionComposite>(), scheme.withThreads(2))
+        .rollback(rhs2, maturity, 0.0, 10, 0);
+
+    for (Size i=0; i < n; ++i) {
+        if (rhs[i] != rhs2[i]) {
+            BOOST_ERROR("results depend on the number of threads"
+                        << std::setprecision(16)
+                        << "\n    index:     " << i
+                        << "\n    default:   " << rhs[i]
+                        << "\n    2 threads: " << rhs2[i]);
+            break;
+        }
+    }
+}
+
+namespace {
+
+    // solves the splittings of a convection-diffusion operator along
+    // every direction but the leading one with both tridiagonal solvers
+    void compareTridiagonalSolvers(const std::vector<Size>& dim) {
+        boost::shared_ptr<FdmLinearOpLayout> layout(
+                                                new FdmLinearOpLayout(dim));
+        std::vector<std::pair<Real, Real> > boundaries(
+                                dim.size(), std::pair<Real, Real>(0.0, 1.0));
+        boost::shared_ptr<FdmMesher> mesher(
+                                    new UniformGridMesher(layout, boundaries));
+
+        Array u(layout->size()), x1(layout->size()), x2(layout->size());
+        Array workspace(layout->size());
+        for (Size i=0; i < layout->size(); ++i)
+            u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+        for (Size d=1; d < dim.size(); ++d) {
+            TripleBandLinearOp op(
+                SecondDerivativeOp(d, mesher)
+                    .mult(Array(layout->size(), 0.5))
+                    .add(FirstDerivativeOp(d, mesher)
+                         .mult(Array(layout->size(), 0.05))));
+
+            op.solve_splitting(u, -0.01, 1.0, x1, workspace,
+                               TripleBandLinearOp::LineByLine);
+            op.solve_splitting(u, -0.01, 1.0, x2, workspace,
+                               TripleBandLinearOp::Interleaved);
+
+            const Real tol = 1e-12;
+            for (Size i=0; i < layout->size(); ++i) {
+                const Real diff = std::fabs(x1[i] - x2[i]);
+                if (diff > tol*std::max(1.0, std::fabs(x1[i]))) {
+                    std::ostringstream grid;
+                    for (Size j=0; j < dim.size(); ++j)
+                        grid << (j == 0 ? "" : "x") << dim[j];
+                    BOOST_FAIL("interleaved solver differs from "
+                               "line-by-line solver"
+                               << std::setprecision(16)
+                               << "\n    grid:         " << grid.str()
+                               << "\n    direction:    " << d
+                               << "\n    index:        " << i
+                               << "\n    line by line: " << x1[i]
+                               << "\n    interleaved:  " << x2[i]
+                               << "\n    difference:   " << diff
+                               << "\n    tolerance:    " << tol);
+                }
+            }
+        }
+    }
+
+}
+
+void FdmLinearOpTest::testInterleavedTridiagonalSolve() {
+    BOOST_TEST_MESSAGE("Testing interleaved tridiagonal solver...");
+
+    SavedSettings backup;
+
+    Size dims2[] = {100, 100};
+    compareTridiagonalSolvers(
+                    std::vector<Size>(dims2, dims2+LENGTH(dims2)));
+
+    Size dims3[] = {200, 100, 50};
+    compareTridiagonalSolvers(
+                    std::vector<Size>(dims3, dims3+LENGTH(dims3)));
+}
+
+namespace {
+
+    // solves the splittings of the convection-diffusion operators
+    // used above on 100x100 and 200x100x50 grids with the given
+    // solver; about 13 floating-point operations are performed for
+    // each point of each solution.
+    void timeTridiagonalSolver(TripleBandLinearOp::SolverType type) {
+        Size dims2[] = {100, 100}, dims3[] = {200, 100, 50};
+        std::vector<Size> dims[] = {
+            std::vector<Size>(dims2, dims2+LENGTH(dims2)),
+            std::vector<Size>(dims3, dims3+LENGTH(dims3)) };
+        Size repetitions[] = { 1000, 10 };
+
+        for (Size g=0; g < LENGTH(dims); ++g) {
+            const std::vector<Size>& dim = dims[g];
+            boost::shared_ptr<FdmLinearOpLayout> layout(
+                                                new FdmLinearOpLayout(dim));
+            std::vector<std::pair<Real, Real> > boundaries(
+                                dim.size(), std::pair<Real, Real>(0.0, 1.0));
+            boost::shared_ptr<FdmMesher> mesher(
+                                    new UniformGridMesher(layout, boundaries));
+
+            Array u(layout->size()), x(layout->size());
+            Array workspace(layout->size());
+            for (Size i=0; i < layout->size(); ++i)
+                u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+            for (Size d=1; d < dim.size(); ++d) {
+                TripleBandLinearOp op(
+                    SecondDerivativeOp(d, mesher)
+                        .mult(Array(layout->size(), 0.5))
+                        .add(FirstDerivativeOp(d, mesher)
+                             .mult(Array(layout->size(), 0.05))));
+                for (Size k=0; k < repetitions[g]; ++k)
+                    op.solve_splitting(u, -0.01, 1.0, x, workspace, type);
+            }
+        }
+    }
+
+}
+
+void FdmLinearOpTest::benchmarkLineByLineSolve() {
+    timeTridiagonalSolver(TripleBandLinearOp::LineByLine);
+}
+
+void FdmLinearOpTest::benchmarkInterleavedSolve() {
+    timeTridiagonalSolver(TripleBandLinearOp::Interleaved);
+}
+
 void FdmLinearOpTest::testBiCGstab() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_TEST_MESSAGE("Testing bi-conjugated gradient stabilized algorithm "
@@ -1238,6 +1662,253 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+namespace {
+
+    // rolls back the given number of copies of the option values
+    // at once and returns the value from the first one
+    Real bermudanPutValue(const FdmSchemeDesc& schemeDesc,
+                          Size steps, Size& stepsTaken, Size& stepsRejected,
+                          Size copies = 1) {
+
+        const DayCounter dc = Actual365Fixed();
+        const Date today(28, July, 2014);
+        Settings::instance().evaluationDate() = today;
+
+        const Real s0 = 100.0, strike = 100.0;
+        const boost::shared_ptr<BlackScholesMertonProcess> process(
+            new BlackScholesMertonProcess(
+                Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(s0))),
+                Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+                Handle<BlackVolTermStructure>(flatVol(today, 0.3, dc))));
+
+        std::vector<Date> exerciseDates;
+        for (Size i=1; i <= 8; ++i)
+            exerciseDates.push_back(today + Period(3*i, Months));
+        const boost::shared_ptr<Exercise> exercise(
+                                     new BermudanExercise(exerciseDates));
+        const Time maturity = dc.yearFraction(today, exerciseDates.back());
+
+        const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, strike));
+
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(
+                    200, process, maturity, strike,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(strike, 0.1)))));
+
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                    new FdmLogInnerValue(payoff, mesher, 0));
+        const boost::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                DividendSchedule(), exercise, mesher, calculator, today, dc);
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        Array rhs(layout->size()), x(layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+            x[iter.index()] = mesher->location(iter, 0);
+        }
+
+        FdmBackwardSolver solver(
+            boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmBlackScholesOp(mesher, process, strike)),
+            FdmBoundaryConditionSet(), conditions, schemeDesc);
+        std::vector<Array> strip(copies, rhs);
+        if (copies == 1)
+            solver.rollback(strip.front(), maturity, 0.0, steps, 2);
+        else
+            solver.rollback(strip, maturity, 0.0, steps, 2);
+        stepsTaken = solver.stepsTaken();
+        stepsRejected = solver.stepsRejected();
+
+        return MonotonicCubicNaturalSpline(
+                x.begin(), x.end(), strip.front().begin())(std::log(s0));
+    }
+
+}
+
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping "
+                       "for a Bermudan option...");
+
+    SavedSettings backup;
+
+    Size referenceSteps, referenceRejected;
+    const Real reference = bermudanPutValue(FdmSchemeDesc::Douglas(), 2000,
+                                            referenceSteps, referenceRejected);
+
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::CraigSneyd(),
+                                      FdmSchemeDesc::Hundsdorfer() };
+    const std::string names[] = { "Douglas", "Craig-Sneyd", "Hundsdorfer" };
+
+    const Real tolerance = 1e-4;
+    for (Size i=0; i < LENGTH(schemes); ++i) {
+        Size adaptiveSteps, adaptiveRejected;
+        const Real adaptive = bermudanPutValue(
+            schemes[i].withAdaptiveSteps(tolerance), 5,
+            adaptiveSteps, adaptiveRejected);
+
+        // uniform steps at the same cost; every accepted or rejected
+        // adaptive step takes a full and two half steps, and the
+        // uniform rollback adds two damping steps
+        const Size work = 3*(adaptiveSteps + adaptiveRejected);
+        Size uniformSteps, uniformRejected;
+        const Real uniform = bermudanPutValue(
+            schemes[i], work - 2, uniformSteps, uniformRejected);
+
+        const Real adaptiveError = std::fabs(adaptive - reference);
+        const Real uniformError = std::fabs(uniform - reference);
+
+        if (adaptiveError > 1e-3 || adaptiveSteps >= 200) {
+            BOOST_ERROR("failed to reproduce Bermudan put value "
+                        "with adaptive time steps"
+                        << "\n    scheme:     " << names[i]
+                        << "\n    reference:  " << reference
+                        << "\n    calculated: " << adaptive
+                        << "\n    error:      " << adaptiveError
+                        << "\n    steps:      " << adaptiveSteps);
+        }
+        if (adaptiveError > uniformError) {
+            BOOST_ERROR("adaptive time steps less accurate than uniform ones"
+                        << "\n    scheme:         " << names[i]
+                        << "\n    accepted steps: " << adaptiveSteps
+                        << "\n    rejected steps: " << adaptiveRejected
+                        << "\n    uniform steps:  " << uniformSteps
+                        << "\n    adaptive error: " << adaptiveError
+                        << "\n    uniform error:  " << uniformError);
+        }
+
+        // a strip of identical arrays takes the same adaptive steps
+        Size stripSteps, stripRejected;
+        const Real strip = bermudanPutValue(
+            schemes[i].withAdaptiveSteps(tolerance), 5,
+            stripSteps, stripRejected, 3);
+
+        if (std::fabs(strip - adaptive) > 1e-12
+            || stripSteps != adaptiveSteps
+            || stripRejected != adaptiveRejected) {
+            BOOST_ERROR("failed to reproduce adaptive rollback "
+                        "with several arrays"
+                        << std::setprecision(12)
+                        << "\n    scheme:         " << names[i]
+                        << "\n    single array:   " << adaptive
+                        << "\n    several arrays: " << strip
+                        << "\n    steps:          " << adaptiveSteps
+                        << " / " << stripSteps
+                        << "\n    rejected:       " << adaptiveRejected
+                        << " / " << stripRejected);
+        }
+    }
+}
+
+void FdmLinearOpTest::testImplicitEulerKrylovSolvers() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing implicit Euler scheme with Krylov solvers "
+                       "and cached ILU factorization...");
+
+    SavedSettings backup;
+
+    Size dims[] = {41, 21};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+
+    const boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+    const boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    const boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                    new FdmHestonOp(mesher, hestonProcess));
+
+    Array payoff(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        payoff[iter.index()]
+            = std::max(std::exp(mesher->location(iter, 0)) - 100, 0.0);
+    }
+
+    const Time maturity = 1.0;
+    const Size steps = 20;
+    const Real relTol = 1e-10;
+
+    ImplicitEulerScheme reference(hestonOp, FdmBoundaryConditionSet(),
+                                  relTol);
+    Array expected = payoff;
+    FiniteDifferenceModel<ImplicitEulerScheme>(reference)
+        .rollback(expected, maturity, 0.0, steps);
+
+    const ImplicitEulerScheme::SolverType solverTypes[] =
+        { ImplicitEulerScheme::BiCGstab, ImplicitEulerScheme::GMRES };
+    const std::string solverNames[] = { "BiCGstab", "GMRES" };
+    const Integer iluFills[] = { Null<Integer>(), 2 };
+
+    Size iterations[LENGTH(solverTypes)][LENGTH(iluFills)];
+    for (Size i=0; i < LENGTH(solverTypes); ++i) {
+        for (Size j=0; j < LENGTH(iluFills); ++j) {
+            ImplicitEulerScheme scheme(hestonOp, FdmBoundaryConditionSet(),
+                                       relTol, solverTypes[i], iluFills[j]);
+
+            const Time dt = maturity/steps;
+            scheme.setStep(dt);
+
+            Array calculated = payoff;
+            for (Size k=0; k < steps; ++k)
+                scheme.step(calculated, maturity - k*dt);
+
+            iterations[i][j] = scheme.numberOfIterations();
+
+            const Real diff = std::sqrt(
+                DotProduct(calculated-expected, calculated-expected)
+                / DotProduct(expected, expected));
+            if (diff > 1e-8) {
+                BOOST_ERROR("failed to reproduce implicit Euler rollback"
+                            << "\n    solver:          " << solverNames[i]
+                            << "\n    ILU factorization: "
+                            << (iluFills[j] == Null<Integer>() ? "no":"yes")
+                            << "\n    difference:      " << diff);
+            }
+
+            const Size expectedFactorizations
+                = (iluFills[j] == Null<Integer>()) ? 0 : 1;
+            if (scheme.numberOfFactorizations() != expectedFactorizations) {
+                BOOST_ERROR("unexpected number of ILU factorizations"
+                            << "\n    solver:     " << solverNames[i]
+                            << "\n    calculated: "
+                            << scheme.numberOfFactorizations()
+                            << "\n    expected:   "
+                            << expectedFactorizations);
+            }
+        }
+
+        if (iterations[i][1] >= iterations[i][0]) {
+            BOOST_ERROR("ILU preconditioner does not reduce "
+                        "the number of iterations"
+                        << "\n    solver:                " << solverNames[i]
+                        << "\n    operator preconditioner: "
+                        << iterations[i][0]
+                        << "\n    ILU preconditioner:      "
+                        << iterations[i][1]);
+        }
+    }
+#endif
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1394,9 +2065,20 @@ test_suite* FdmLinearOpTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testLocalCubicInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceApplication));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &FdmLinearOpTest::testMultiThreadedLineSolves));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &FdmLinearOpTest::testInterleavedTridiagonalSolve));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &FdmLinearOpTest::testImplicitEulerKrylovSolvers));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
@@ -39,12 +39,22 @@ public:
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testLocalCubicInterpolation();
+    static void testInPlaceApplication();
+    static void testMultiThreadedLineSolves();
+    static void testInterleavedTridiagonalSolve();
     static void testBiCGstab();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
+    static void testImplicitEulerKrylovSolvers();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
 
+    // used by the benchmark suite
+    static void benchmarkLineByLineSolve();
+    static void benchmarkInterleavedSolve();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
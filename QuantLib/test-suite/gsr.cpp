@@ -227,6 +227,45 @@ void GsrTest::testGsrModel() {
         w += 5.0;
     } while (w <= 50.0);
 
+    // test the vectorized zerobond and numeraire against the scalar ones
+
+    Real tol1 = 1E-14;
+
+    Array y = model->yGrid(7.0, 16);
+    w = 0.0;
+    do {
+        Array num = model->numeraire(w, y);
+        t = w + 0.1;
+        do {
+            Array zb = model->zerobond(t, w, y);
+            Array zb2 = model2->zerobond(t, w, y);
+            for (Size i = 0; i < y.size(); ++i) {
+                Real zbVal = model->zerobond(t, w, y[i]);
+                Real zb2Val = model2->zerobond(t, w, y[i]);
+                if (fabs(zb[i] - zbVal) > tol1 * zbVal)
+                    BOOST_ERROR("Vectorized zerobond P("
+                                << w << "," << t << " | y=" << y[i]
+                                << ") is different from scalar one ("
+                                << zb[i] << " vs " << zbVal << ")");
+                if (fabs(zb2[i] - zb2Val) > tol1 * zb2Val)
+                    BOOST_ERROR("Vectorized zerobond P("
+                                << w << "," << t << " | y=" << y[i]
+                                << ") is different from scalar one in Gsr2 ("
+                                << zb2[i] << " vs " << zb2Val << ")");
+            }
+            t += 7.5;
+        } while (t <= 50.0);
+        for (Size i = 0; i < y.size(); ++i) {
+            Real numVal = model->numeraire(w, y[i]);
+            if (fabs(num[i] - numVal) > tol1 * numVal)
+                BOOST_ERROR("Vectorized numeraire N("
+                            << w << " | y=" << y[i]
+                            << ") is different from scalar one ("
+                            << num[i] << " vs " << numVal << ")");
+        }
+        w += 7.5;
+    } while (w <= 45.0);
+
     // test standard, nonstandard and jamshidian engine against existing Hull
     // White Jamshidian engine
 
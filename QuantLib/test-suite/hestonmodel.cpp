@@ -33,12 +33,16 @@
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
+#include <ql/pricingengines/vanilla/cosptdhestonengine.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -1505,6 +1509,193 @@ void HestonModelTest::testExpansionOnFordeReference() {
     }
 }
 
+void HestonModelTest::testCOSEngines() {
+    BOOST_TEST_MESSAGE("Testing Fourier-cosine Heston engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(
+                                        flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(
+                                        flatRate(0.02, dayCounter));
+    const Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100)));
+
+    const Real v0 = 0.04, kappa = 1.5, theta = 0.04,
+               sigma = 0.3, rho = -0.7;
+    const boost::shared_ptr<HestonProcess> process(
+        new HestonProcess(riskFreeTS, dividendTS, s0,
+                          v0, kappa, theta, sigma, rho));
+    const boost::shared_ptr<HestonModel> hestonModel(
+                                                new HestonModel(process));
+    const boost::shared_ptr<BatesModel> batesModel(
+        new BatesModel(boost::shared_ptr<BatesProcess>(
+            new BatesProcess(riskFreeTS, dividendTS, s0,
+                             v0, kappa, theta, sigma, rho,
+                             0.5, -0.1, 0.15))));
+    const boost::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel(
+        new PiecewiseTimeDependentHestonModel(
+            riskFreeTS, dividendTS, s0, v0,
+            ConstantParameter(theta, PositiveConstraint()),
+            ConstantParameter(kappa, PositiveConstraint()),
+            ConstantParameter(sigma, PositiveConstraint()),
+            ConstantParameter(rho, BoundaryConstraint(-1.0, 1.0)),
+            TimeGrid(20.0, 2)));
+
+    const std::string names[] = { "Heston", "Bates", "PTD Heston" };
+    const boost::shared_ptr<PricingEngine> cosEngines[] = {
+        boost::shared_ptr<PricingEngine>(new COSHestonEngine(hestonModel)),
+        boost::shared_ptr<PricingEngine>(new COSBatesEngine(batesModel)),
+        boost::shared_ptr<PricingEngine>(new COSPTDHestonEngine(ptdModel))
+    };
+    const boost::shared_ptr<PricingEngine> analyticEngines[] = {
+        boost::shared_ptr<PricingEngine>(
+                    new AnalyticHestonEngine(hestonModel, 1e-12, 100000)),
+        boost::shared_ptr<PricingEngine>(new BatesEngine(batesModel, 192)),
+        boost::shared_ptr<PricingEngine>(
+                    new AnalyticPTDHestonEngine(ptdModel, 1e-12, 100000))
+    };
+    const Real tolerances[] = { 1e-7, 1e-5, 1e-7 };
+
+    const Period maturities[] = { 3*Months, 1*Years, 5*Years };
+    const Real strikes[] = { 50, 80, 95, 100, 105, 120, 200 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    for (Size e=0; e < LENGTH(cosEngines); ++e) {
+        for (Size i=0; i < LENGTH(maturities); ++i) {
+            const boost::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(settlementDate + maturities[i]));
+            for (Size j=0; j < LENGTH(strikes); ++j) {
+                for (Size k=0; k < LENGTH(types); ++k) {
+                    VanillaOption option(
+                        boost::shared_ptr<StrikedTypePayoff>(
+                            new PlainVanillaPayoff(types[k], strikes[j])),
+                        exercise);
+
+                    option.setPricingEngine(analyticEngines[e]);
+                    const Real expected = option.NPV();
+                    option.setPricingEngine(cosEngines[e]);
+                    const Real calculated = option.NPV();
+
+                    const Real error = std::fabs(calculated - expected);
+                    if (error > tolerances[e]) {
+                        BOOST_ERROR("failed to reproduce " << names[e]
+                                    << " prices with the COS engine"
+                                    << "\n    maturity:   " << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    type:       " << types[k]
+                                    << QL_SCIENTIFIC
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected
+                                    << "\n    error:      " << error
+                                    << "\n    tolerance:  " << tolerances[e]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void HestonModelTest::testFFTEngines() {
+    BOOST_TEST_MESSAGE("Testing FFT Heston engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(
+                                        flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(
+                                        flatRate(0.02, dayCounter));
+    const Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100)));
+
+    const Real v0 = 0.04, kappa = 1.5, theta = 0.04,
+               sigma = 0.3, rho = -0.7;
+    const boost::shared_ptr<HestonModel> hestonModel(
+        new HestonModel(boost::shared_ptr<HestonProcess>(
+            new HestonProcess(riskFreeTS, dividendTS, s0,
+                              v0, kappa, theta, sigma, rho))));
+    const boost::shared_ptr<BatesModel> batesModel(
+        new BatesModel(boost::shared_ptr<BatesProcess>(
+            new BatesProcess(riskFreeTS, dividendTS, s0,
+                             v0, kappa, theta, sigma, rho,
+                             0.5, -0.1, 0.15))));
+
+    const std::string names[] = {
+        "fractional FFT Heston", "standard FFT Heston", "fractional FFT Bates"
+    };
+    const boost::shared_ptr<FFTEngine> fftEngines[] = {
+        boost::shared_ptr<FFTEngine>(new FFTHestonEngine(hestonModel)),
+        boost::shared_ptr<FFTEngine>(new FFTHestonEngine(hestonModel,
+                                                         0.001, 0)),
+        boost::shared_ptr<FFTEngine>(new FFTBatesEngine(batesModel))
+    };
+    const boost::shared_ptr<PricingEngine> analyticEngines[] = {
+        boost::shared_ptr<PricingEngine>(
+                    new AnalyticHestonEngine(hestonModel, 1e-12, 100000)),
+        boost::shared_ptr<PricingEngine>(
+                    new AnalyticHestonEngine(hestonModel, 1e-12, 100000)),
+        boost::shared_ptr<PricingEngine>(new BatesEngine(batesModel, 192))
+    };
+    const Real tolerances[] = { 1e-4, 5e-3, 1e-4 };
+
+    const Period maturities[] = { 3*Months, 1*Years, 5*Years };
+    const Real strikes[] = { 50, 80, 95, 100, 105, 120, 200 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<boost::shared_ptr<Instrument> > options;
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        const boost::shared_ptr<Exercise> exercise(
+            new EuropeanExercise(settlementDate + maturities[i]));
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            for (Size k=0; k < LENGTH(types); ++k) {
+                options.push_back(boost::shared_ptr<Instrument>(
+                    new VanillaOption(boost::shared_ptr<StrikedTypePayoff>(
+                            new PlainVanillaPayoff(types[k], strikes[j])),
+                        exercise)));
+            }
+        }
+    }
+
+    for (Size e=0; e < LENGTH(fftEngines); ++e) {
+        // all maturities and strikes are priced at once
+        fftEngines[e]->precalculate(options);
+
+        for (Size i=0; i < options.size(); ++i) {
+            const boost::shared_ptr<VanillaOption> option =
+                boost::static_pointer_cast<VanillaOption>(options[i]);
+
+            option->setPricingEngine(analyticEngines[e]);
+            const Real expected = option->NPV();
+            option->setPricingEngine(fftEngines[e]);
+            const Real calculated = option->NPV();
+
+            const Real error = std::fabs(calculated - expected);
+            if (error > tolerances[e]) {
+                const boost::shared_ptr<StrikedTypePayoff> payoff =
+                    boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                        option->payoff());
+                BOOST_ERROR("failed to reproduce analytic prices with the "
+                            << names[e] << " engine"
+                            << "\n    maturity:   "
+                            << option->exercise()->lastDate()
+                            << "\n    strike:     " << payoff->strike()
+                            << "\n    type:       " << payoff->optionType()
+                            << QL_SCIENTIFIC
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    error:      " << error
+                            << "\n    tolerance:  " << tolerances[e]);
+            }
+        }
+    }
+}
+
 test_suite* HestonModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1531,6 +1722,8 @@ test_suite* HestonModelTest::suite() {
                     &HestonModelTest::testExpansionOnAlanLewisReference));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testExpansionOnFordeReference));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCOSEngines));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFFTEngines));
     return suite;
 }
 
@@ -3033,9 +3033,17 @@ void MarketModelTest::testPathwiseVegas()
                 std::vector<Real> oneStepDFs(evolution.numberOfRates()+1);
                 oneStepDFs[0] = 1.0;
 
+                // arbitrary sensitivities to the new rates for testing
+                // the adjoint of the jacobian
+                std::vector<Real> rateAdjoints(evolution.numberOfRates());
+                for (Size i=0; i < rateAdjoints.size(); ++i)
+                    rateAdjoints[i] = 1.0/(i+1.0) - 0.3;
+                Matrix adjointVegas(evolution.numberOfRates(), factors);
+
 
                 Size numberFailures=0;
                 Size numberFailures2=0;
+                Size numberFailures3=0;
 
                 for (Size l=0; l < pathsToDo; ++l)
                 {
@@ -3095,6 +3103,26 @@ void MarketModelTest::testPathwiseVegas()
                             }
                         }
 
+                        // the adjoint must agree with the full jacobian
+                        testees2[currentStep].getVegas(oldRates, oneStepDFs, newRates, gaussians, rateAdjoints, adjointVegas);
+
+                        for (Size k1=0; k1 < numberRates; ++k1)
+                            for (Size f1=0; f1 < factors; ++f1)
+                            {
+                                Real sum =0.0;
+                                for (Size j1=0; j1 < numberRates; ++j1)
+                                    sum += rateAdjoints[j1]*globalB[j1][k1][f1];
+
+                                if (fabs(adjointVegas[k1][f1] - sum) > 1.0e-12)
+                                {
+                                    ++numberFailures3;
+                                    if (printReport_)
+                                        BOOST_TEST_MESSAGE("path " << l << " step "
+                                        << currentStep << " k " << k1
+                                        << " f " << f1 << " adjoint " << adjointVegas[k1][f1] << "  jacobian " << sum);
+                                }
+                            }
+
 
 
                         for (Size j=0; j < B.rows(); ++j)
@@ -3141,6 +3169,9 @@ void MarketModelTest::testPathwiseVegas()
                 
                 if (numberFailures2 >0)
                     BOOST_FAIL("Pathwise rate pseudoroot jacobian all elements test fails : " << numberFailures2 <<"\n");
+
+                if (numberFailures3 >0)
+                    BOOST_FAIL("Pathwise rate pseudoroot jacobian adjoint test fails : " << numberFailures3 <<"\n");
             } // end of k loop over measures
 
 
@@ -4874,6 +4905,335 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing simulation of market models "
+                       "on several threads...");
+
+    setup();
+
+    std::vector<Rate> forwardStrikes(todaysForwards.size());
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i) {
+        forwardStrikes[i] = todaysForwards[i] + 0.01;
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    }
+
+    OneStepForwards forwards(rateTimes, accruals,
+        paymentTimes, forwardStrikes);
+    OneStepOptionlets optionlets(rateTimes, accruals,
+        paymentTimes, optionletPayoffs);
+
+    MultiProductComposite product;
+    product.add(forwards);
+    product.add(optionlets);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, Terminal);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size threads = 4, paths = 1024*threads;
+    const Real tolerance = 1.0e-12;
+
+    // a Sobol generator can skip ahead; the substreams reproduce the
+    // serial simulation, including its continuation.  The second
+    // batch is not a multiple of the number of threads, so that the
+    // threads get different numbers of paths.
+    Size batchPaths[] = { paths, paths-3, paths };
+    SobolBrownianGeneratorFactory sobolFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+    EvolverType evolvers[] = { Pc, Ipc };
+    for (Size i=0; i<LENGTH(evolvers); ++i) {
+        AccountingEngine serialEngine(
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   sobolFactory, evolvers[i]),
+            product, initialNumeraireValue);
+        AccountingEngine parallelEngine(
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   sobolFactory, evolvers[i]),
+            product, initialNumeraireValue);
+        for (Size batch=0; batch<LENGTH(batchPaths); ++batch) {
+            SequenceStatisticsInc serialStats, parallelStats;
+            serialEngine.multiplePathValues(serialStats, batchPaths[batch]);
+            parallelEngine.multiplePathValues(parallelStats,
+                                              batchPaths[batch], threads);
+
+            if (parallelStats.samples() != serialStats.samples())
+                BOOST_FAIL(evolverTypeToString(evolvers[i])
+                           << ", batch " << batch << ": "
+                           << parallelStats.samples() << " samples on "
+                           << threads << " threads, "
+                           << serialStats.samples() << " expected");
+            std::vector<Real> serialMeans = serialStats.mean();
+            std::vector<Real> parallelMeans = parallelStats.mean();
+            std::vector<Real> serialErrors = serialStats.errorEstimate();
+            std::vector<Real> parallelErrors = parallelStats.errorEstimate();
+            for (Size j=0; j<serialMeans.size(); ++j) {
+                if (std::fabs(parallelMeans[j]-serialMeans[j]) >
+                                    tolerance*std::fabs(serialMeans[j]) ||
+                    std::fabs(parallelErrors[j]-serialErrors[j]) >
+                                    1.0e-8*serialErrors[j])
+                    BOOST_FAIL(evolverTypeToString(evolvers[i])
+                               << ", batch " << batch
+                               << ", product " << j << ":"
+                               << std::setprecision(12)
+                               << "\n    serial mean:    " << serialMeans[j]
+                               << "\n    parallel mean:  " << parallelMeans[j]
+                               << "\n    serial error:   " << serialErrors[j]
+                               << "\n    parallel error: " << parallelErrors[j]);
+            }
+        }
+    }
+
+    // Mersenne-twister substreams are reseeded; the results must be
+    // reproducible and consistent with the serial ones
+    MTBrownianGeneratorFactory mtFactory(seed_);
+    AccountingEngine serialEngine(
+        makeMarketModelEvolver(marketModel, numeraires, mtFactory, Pc),
+        product, initialNumeraireValue);
+    SequenceStatisticsInc serialStats;
+    serialEngine.multiplePathValues(serialStats, paths);
+    std::vector<Real> serialMeans = serialStats.mean();
+    std::vector<Real> serialErrors = serialStats.errorEstimate();
+
+    std::vector<std::vector<Real> > means(2);
+    for (Size run=0; run<2; ++run) {
+        AccountingEngine parallelEngine(
+            makeMarketModelEvolver(marketModel, numeraires, mtFactory, Pc),
+            product, initialNumeraireValue);
+        SequenceStatisticsInc parallelStats;
+        parallelEngine.multiplePathValues(parallelStats, paths, threads);
+        means[run] = parallelStats.mean();
+    }
+    for (Size j=0; j<serialMeans.size(); ++j) {
+        if (means[1][j] != means[0][j])
+            BOOST_FAIL("product " << j << ": "
+                       "simulation on " << threads << " threads "
+                       "not reproducible:" << std::setprecision(12)
+                       << "\n    first run:  " << means[0][j]
+                       << "\n    second run: " << means[1][j]);
+        if (std::fabs(means[0][j]-serialMeans[j]) > 5.0*serialErrors[j])
+            BOOST_FAIL("product " << j << ": "
+                       "simulation on " << threads << " threads "
+                       "inconsistent with serial one:"
+                       << std::setprecision(12)
+                       << "\n    serial mean:   " << serialMeans[j]
+                       << "\n    parallel mean: " << means[0][j]
+                       << "\n    serial error:  " << serialErrors[j]);
+    }
+}
+
+void MarketModelTest::testBlockSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing simulation of blocks of paths "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+
+    MultiStepOptionlets product(rateTimes, accruals,
+        paymentTimes, payoffs);
+
+    EvolutionDescription evolution = product.evolution();
+
+    // the number of paths is not a multiple of the block size, so
+    // that the last block is used only in part
+    const Size paths = 1000, blockSize = 64;
+
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    MeasureType measures[] = { MoneyMarket, Terminal };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[m],
+                            ExponentialCorrelationAbcdVolatility);
+        for (Size k=0; k<LENGTH(measures); ++k) {
+            std::vector<Size> numeraires = makeMeasure(product, measures[k]);
+            Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+            MTBrownianGeneratorFactory generatorFactory(seed_);
+            boost::shared_ptr<MarketModelEvolver> pathEvolver(new
+                LogNormalFwdRatePc(marketModel, generatorFactory,
+                                   numeraires));
+            boost::shared_ptr<MarketModelEvolver> blockEvolver(new
+                LogNormalFwdRatePc(marketModel, generatorFactory,
+                                   numeraires, 0, blockSize));
+
+            AccountingEngine pathEngine(pathEvolver, product,
+                                        initialNumeraireValue);
+            AccountingEngine blockEngine(blockEvolver, product,
+                                         initialNumeraireValue);
+            SequenceStatisticsInc pathStats, blockStats;
+            pathEngine.multiplePathValues(pathStats, paths);
+            blockEngine.multiplePathValues(blockStats, paths);
+
+            std::vector<Real> pathMeans = pathStats.mean();
+            std::vector<Real> blockMeans = blockStats.mean();
+            for (Size i=0; i<pathMeans.size(); ++i) {
+                if (std::fabs(blockMeans[i]-pathMeans[i]) >
+                                           1.0e-12*std::fabs(pathMeans[i]))
+                    BOOST_FAIL(testedFactors[m] << " factors, "
+                               << measureTypeToString(measures[k])
+                               << ", optionlet " << i << ":"
+                               << std::setprecision(12)
+                               << "\n    path-by-path: " << pathMeans[i]
+                               << "\n    block:        " << blockMeans[i]);
+            }
+        }
+    }
+
+    // the generator is drawn ahead of the returned paths, so block
+    // evolvers can't be split in substreams among threads
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+    boost::shared_ptr<MarketModelEvolver> blockEvolver(new
+        LogNormalFwdRatePc(marketModel, generatorFactory,
+                           numeraires, 0, blockSize));
+    AccountingEngine blockEngine(blockEvolver, product,
+                                 todaysDiscounts[numeraires.front()]);
+    SequenceStatisticsInc blockStats;
+    bool thrown = false;
+    try {
+        blockEngine.multiplePathValues(blockStats, paths, 2);
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_FAIL("block evolver split in substreams among threads");
+}
+
+void MarketModelTest::testParallelUpperBound() {
+
+    BOOST_TEST_MESSAGE("Testing upper-bound estimation on several threads "
+                       "and with adaptive inner simulations...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+        fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct callableProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                  ExerciseAdapter(nullRebate));
+    EvolutionDescription evolution = callableProduct.evolution();
+    std::vector<Size> numeraires = makeMeasure(callableProduct,
+                                               MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+
+    // All generators are Sobol ones, so that the substreams reproduce
+    // the serial simulation exactly, also when the outer paths are
+    // not a multiple of the number of threads.  An inner tolerance
+    // which is always met must give the same results as a single
+    // batch of inner paths.  A tight one stops the inner simulations
+    // only when the hedge value is known exactly (e.g., when the
+    // strategy exercises right away) so its results must be
+    // consistent with those obtained with the maximum number of inner
+    // paths, while using fewer of them.  Finally, the evolver for the
+    // last exercise time (which runs no inner simulations) can be
+    // shared with the previous one without changing the draws.
+    const Size outerPaths = 32, batchSize = 16;
+    std::string descriptions[] = {
+        "serial", "4 threads", "3 threads", "16 inner paths",
+        "adaptive, loose tolerance", "adaptive, tight tolerance",
+        "shared evolvers, serial", "shared evolvers, 3 threads" };
+    Size threads[] = { 1, 4, 3, 1, 1, 1, 1, 3 };
+    Size innerPaths[] = { 64, 64, 64, 16, 64, 64, 64, 64 };
+    Real innerTolerances[] = { Null<Real>(), Null<Real>(), Null<Real>(),
+                               Null<Real>(), 1.0e10, 1.0e-10,
+                               Null<Real>(), Null<Real>() };
+    bool shared[] = { false, false, false, false, false, false, true, true };
+    Size expected[] = { 0, 0, 0, 3, 3, 0, 0, 6 };
+
+    // inner simulations are run at each exercise time but the last
+    Size innerSimulations = 0;
+    for (Size s=0; s<isExerciseTime.size()-1; ++s)
+        if (isExerciseTime[s])
+            ++innerSimulations;
+    innerSimulations *= 2*outerPaths;
+
+    std::vector<Real> means, errors;
+    for (Size r=0; r<LENGTH(threads); ++r) {
+        SobolBrownianGeneratorFactory outerFactory(
+                               SobolBrownianGenerator::Diagonal, seed_+142);
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+        std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers;
+        for (Size s=0; s<isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                SobolBrownianGeneratorFactory innerFactory(
+                                  SobolBrownianGenerator::Diagonal, seed_+s);
+                innerEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           innerFactory, Pc, s));
+            }
+        }
+        if (shared[r])
+            innerEvolvers.back() = innerEvolvers[innerEvolvers.size()-2];
+        UpperBoundEngine engine(evolver, innerEvolvers,
+                                receiverSwap, nullRebate,
+                                receiverSwap, nullRebate,
+                                naifStrategy, initialNumeraireValue,
+                                innerTolerances[r], batchSize);
+        // the second call checks that the evolvers are left at the
+        // right position
+        Statistics stats;
+        engine.multiplePathValues(stats, outerPaths,
+                                  innerPaths[r], threads[r]);
+        engine.multiplePathValues(stats, outerPaths,
+                                  innerPaths[r], threads[r]);
+        if (stats.samples() != 2*outerPaths)
+            BOOST_FAIL(descriptions[r] << ": " << stats.samples()
+                       << " samples, " << 2*outerPaths << " expected");
+        means.push_back(stats.mean());
+        errors.push_back(stats.errorEstimate());
+
+        Size used = engine.innerPathsUsed();
+        bool tight = (innerTolerances[r] < 1.0);
+        if ((!tight && used != innerSimulations*
+                        (innerTolerances[r] == Null<Real>() ? innerPaths[r]
+                                                            : batchSize)) ||
+            (tight && (used <= innerSimulations*batchSize ||
+                       used >= innerSimulations*innerPaths[r])))
+            BOOST_FAIL(descriptions[r] << ": " << used << " inner paths "
+                       "used for " << innerSimulations
+                       << " inner simulations");
+
+        Size e = expected[r];
+        Real tolerance = (innerTolerances[r] < 1.0 ? errors[e] :
+                                            1.0e-12*std::fabs(means[e]));
+        if (std::fabs(means[r]-means[e]) > tolerance)
+            BOOST_FAIL(descriptions[r] << " upper bound inconsistent with "
+                       << descriptions[e] << " one:"
+                       << std::setprecision(12)
+                       << "\n    " << descriptions[e] << ": " << means[e]
+                       << "\n    " << descriptions[r] << ": " << means[r]);
+    }
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4908,6 +5268,9 @@ test_suite* MarketModelTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelSimulation));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockSimulation));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelUpperBound));
 
     return suite;
 }
@@ -50,6 +50,9 @@ class MarketModelTest {
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
+    static void testParallelSimulation();
+    static void testBlockSimulation();
+    static void testParallelUpperBound();
     static boost::unit_test_framework::test_suite* suite();
 };
 
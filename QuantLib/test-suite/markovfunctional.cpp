@@ -50,6 +50,7 @@
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/models/shortrate/calibrationhelpers/caphelper.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1750,6 +1751,71 @@ void MarkovFunctionalTest::testBermudanSwaption() {
     Settings::instance().evaluationDate() = savedEvalDate;
 }
 
+void MarkovFunctionalTest::testWarmStart() {
+
+    Real tol0 = 1E-5; // relative tolerance for the numeraire against a
+                      // cold started calibration
+
+    BOOST_MESSAGE("Testing Markov functional warm started calibration...");
+
+    Date savedEvalDate = Settings::instance().evaluationDate();
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.03));
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), Handle<Quote>(rate), Actual365Fixed())));
+    Handle<SwaptionVolatilityStructure> vts(
+        boost::shared_ptr<SwaptionVolatilityStructure>(
+            new ConstantSwaptionVolatility(0, TARGET(), ModifiedFollowing,
+                                           Handle<Quote>(vol),
+                                           Actual365Fixed())));
+
+    boost::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+
+    std::vector<Date> volStepDates;
+    std::vector<Real> vols;
+    vols.push_back(1.0);
+
+    boost::shared_ptr<MarkovFunctional> cold(new MarkovFunctional(
+        yts, 0.01, volStepDates, vols, vts, expiriesCalBasket1(),
+        tenorsCalBasket1(), swapIndexBase,
+        MarkovFunctional::ModelSettings().withYGridPoints(32)));
+    boost::shared_ptr<MarkovFunctional> warm(new MarkovFunctional(
+        yts, 0.01, volStepDates, vols, vts, expiriesCalBasket1(),
+        tenorsCalBasket1(), swapIndexBase,
+        MarkovFunctional::ModelSettings().withYGridPoints(32).withWarmStart(
+            true)));
+
+    // in the far tails the rates are close to the bounds where the digital
+    // prices are flat, so that they are not determined to the accuracy
+    // of the calibration, which is why we compare on a narrower grid
+    Array y = cold->yGrid(3.0, 16);
+    std::vector<Date> expiries = expiriesCalBasket1();
+
+    for (Size k = 0; k < 5; k++) {
+        // small market moves as seen e.g. intraday
+        rate->setValue(0.03 + 0.0005 * k);
+        vol->setValue(0.20 - 0.002 * k);
+        for (Size i = 0; i < expiries.size(); i++) {
+            Array coldNum = cold->numeraire(expiries[i], y);
+            Array warmNum = warm->numeraire(expiries[i], y);
+            for (Size j = 0; j < y.size(); j++) {
+                if (fabs(warmNum[j] - coldNum[j]) > tol0 * coldNum[j])
+                    BOOST_ERROR("Numeraire of warm started model ("
+                                << warmNum[j]
+                                << ") deviates from cold started one ("
+                                << coldNum[j] << ") at expiry " << expiries[i]
+                                << ", y=" << y[j] << ", move " << k);
+            }
+        }
+    }
+
+    Settings::instance().evaluationDate() = savedEvalDate;
+}
+
 test_suite *MarkovFunctionalTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Markov functional model tests");
     suite->add(QUANTLIB_TEST_CASE(&MarkovFunctionalTest::testMfStateProcess));
@@ -1761,5 +1827,6 @@ test_suite *MarkovFunctionalTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
         &MarkovFunctionalTest::testCalibrationTwoInstrumentSets));
     suite->add(QUANTLIB_TEST_CASE(&MarkovFunctionalTest::testBermudanSwaption));
+    suite->add(QUANTLIB_TEST_CASE(&MarkovFunctionalTest::testWarmStart));
     return suite;
 }
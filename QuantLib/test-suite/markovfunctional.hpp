@@ -33,6 +33,7 @@ class MarkovFunctionalTest {
     static void testCalibrationTwoInstrumentSets();
     static void testVanillaEngines();
     static void testBermudanSwaption();
+    static void testWarmStart();
     static boost::unit_test_framework::test_suite *suite();
 };
 
@@ -25,6 +25,9 @@
 #include <ql/methods/finitedifferences/dplusdminus.hpp>
 #include <ql/methods/finitedifferences/bsmoperator.hpp>
 #include <ql/methods/finitedifferences/bsmtermoperator.hpp>
+#include <ql/methods/finitedifferences/cranknicolson.hpp>
+#include <ql/methods/finitedifferences/impliciteuler.hpp>
+#include <ql/methods/finitedifferences/expliciteuler.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -36,6 +39,60 @@ namespace {
 
 Real average = 0.0, sigma = 1.0;
 
+// provides only the value-returning interface required by the schemes
+class GenericOperator {
+  public:
+    typedef Array array_type;
+    GenericOperator() {}
+    GenericOperator(const TridiagonalOperator& L) : L_(L) {}
+    Size size() const { return L_.size(); }
+    bool isTimeDependent() const { return false; }
+    void setTime(Time) {}
+    Array applyTo(const Array& v) const { return L_.applyTo(v); }
+    Array solveFor(const Array& rhs) const { return L_.solveFor(rhs); }
+    static GenericOperator identity(Size size) {
+        return GenericOperator(TridiagonalOperator::identity(size));
+    }
+    friend GenericOperator operator*(Real a, const GenericOperator& D) {
+        return GenericOperator(a*D.L_);
+    }
+    friend GenericOperator operator+(const GenericOperator& D1,
+                                     const GenericOperator& D2) {
+        return GenericOperator(D1.L_+D2.L_);
+    }
+    friend GenericOperator operator-(const GenericOperator& D1,
+                                     const GenericOperator& D2) {
+        return GenericOperator(D1.L_-D2.L_);
+    }
+  private:
+    TridiagonalOperator L_;
+};
+
+template <template <class> class Scheme>
+void testScheme(const std::string& name, const TridiagonalOperator& L,
+                const Array& initialValues) {
+    OperatorTraits<TridiagonalOperator>::bc_set tridiagonalBCs;
+    OperatorTraits<GenericOperator>::bc_set genericBCs;
+    GenericOperator G(L);
+    Scheme<TridiagonalOperator> tridiagonalScheme(L, tridiagonalBCs);
+    Scheme<GenericOperator> genericScheme(G, genericBCs);
+    Time dt = 0.01;
+    tridiagonalScheme.setStep(dt);
+    genericScheme.setStep(dt);
+    Array a1 = initialValues, a2 = initialValues;
+    for (Size i=10; i>0; --i) {
+        tridiagonalScheme.step(a1, i*dt);
+        genericScheme.step(a2, i*dt);
+    }
+    Real tolerance = 1e-14;
+    for (Size i=0; i<a1.size(); ++i) {
+        if (std::fabs(a1[i]-a2[i]) > tolerance)
+            BOOST_FAIL("\n " << name << " results differ:"
+                       "\n    tridiagonal operator: " << a1 <<
+                       "\n    generic operator:     " << a2);
+    }
+}
+
 }
 
 
@@ -121,6 +178,88 @@ void OperatorTest::testTridiagonal() {
                    "\n                  tolerance: " << tolerance);
 }
 
+void OperatorTest::testTridiagonalFactorizationCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached factorization of tridiagonal operator...");
+
+    Size n = 8;
+
+    TridiagonalOperator T(n);
+    T.setFirstRow(2.0, -1.0);
+    T.setMidRows(-1.0, 3.0, -1.0);
+    T.setLastRow(-1.0, 2.0);
+
+    Array original(n);
+    for (Size i=0; i<n; ++i)
+        original[i] = 1.0 + 0.5*i;
+
+    Array intermediate(n);
+    T.applyTo(original, intermediate);
+    Array expected = T.applyTo(original);
+    for (Size i=0; i<n; ++i) {
+        if (intermediate[i]!=expected[i])
+            BOOST_FAIL("\n in-place applyTo differs from applyTo:"
+                       "\n    in-place: " << intermediate <<
+                       "\n    expected: " << expected);
+    }
+
+    Real tolerance = 1e-14;
+    // the first solve factorizes the operator, the following ones
+    // reuse the factorization; the boundary rows are reset to the
+    // same values in between, as boundary conditions do
+    for (Size k=0; k<3; ++k) {
+        T.setFirstRow(2.0, -1.0);
+        T.setLastRow(-1.0, 2.0);
+        Array final(intermediate);
+        T.solveFor(final, final);
+        for (Size i=0; i<n; ++i) {
+            if (std::fabs(final[i]-original[i]) > tolerance)
+                BOOST_FAIL("\n applyTo + solveFor does not equal identity:"
+                           "\n            original vector: " << original <<
+                           "\n         transformed vector: " << intermediate <<
+                           "\n inverse transformed vector: " << final);
+        }
+    }
+
+    // modifying the operator must invalidate the factorization
+    T.setMidRow(3, -0.5, 4.0, -2.0);
+    T.setLastRow(-2.0, 3.0);
+    T.applyTo(original, intermediate);
+    Array final(n);
+    T.solveFor(intermediate, final);
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(final[i]-original[i]) > tolerance)
+            BOOST_FAIL("\n solveFor uses a stale factorization:"
+                       "\n            original vector: " << original <<
+                       "\n         transformed vector: " << intermediate <<
+                       "\n inverse transformed vector: " << final);
+    }
+}
+
+void OperatorTest::testSchemesWithGenericOperator() {
+
+    BOOST_TEST_MESSAGE("Testing finite-difference schemes "
+                       "with a generic operator...");
+
+    Size n = 8;
+
+    TridiagonalOperator L(n);
+    L.setFirstRow(-2.0, 1.0);
+    L.setMidRows(1.0, -2.0, 1.0);
+    L.setLastRow(1.0, -2.0);
+
+    Array initialValues(n);
+    for (Size i=0; i<n; ++i)
+        initialValues[i] = 1.0 + 0.5*i;
+
+    // the schemes use the in-place interface of the tridiagonal
+    // operator; they must give the same results with an operator
+    // implementing only the value-returning one
+    testScheme<CrankNicolson>("Crank-Nicolson", L, initialValues);
+    testScheme<ImplicitEuler>("implicit Euler", L, initialValues);
+    testScheme<ExplicitEuler>("explicit Euler", L, initialValues);
+}
+
 void OperatorTest::testConsistency() {
 
     BOOST_TEST_MESSAGE("Testing differential operators...");
@@ -253,6 +392,10 @@ void OperatorTest::testBSMOperatorConsistency() {
 test_suite* OperatorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Operator tests");
     suite->add(QUANTLIB_TEST_CASE(&OperatorTest::testTridiagonal));
+    suite->add(
+        QUANTLIB_TEST_CASE(&OperatorTest::testTridiagonalFactorizationCache));
+    suite->add(
+        QUANTLIB_TEST_CASE(&OperatorTest::testSchemesWithGenericOperator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&OperatorTest::testConsistency));
     // FLOATING_POINT_EXCEPTION
@@ -29,6 +29,8 @@
 class OperatorTest {
   public:
     static void testTridiagonal();
+    static void testTridiagonalFactorizationCache();
+    static void testSchemesWithGenericOperator();
     static void testConsistency();
     static void testBSMOperatorConsistency();
     static boost::unit_test_framework::test_suite* suite();
@@ -34,6 +34,7 @@
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
@@ -425,12 +426,144 @@ void OvernightIndexedSwapTest::testBootstrap() {
 }
 
 
+namespace {
+
+    Rate expectedOvernightRate(const OvernightIndexedCoupon& coupon,
+                               const Handle<YieldTermStructure>& curve) {
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Date today = Settings::instance().evaluationDate();
+        Real compoundFactor = 1.0;
+        Size i = 0;
+        while (i<dt.size() && fixingDates[i]<today) {
+            compoundFactor *=
+                1.0 + coupon.index()->fixing(fixingDates[i])*dt[i];
+            ++i;
+        }
+        if (i<dt.size())
+            compoundFactor *= curve->discount(valueDates[i]) /
+                              curve->discount(valueDates.back());
+        return (compoundFactor - 1.0) / coupon.accrualPeriod();
+    }
+
+}
+
+void OvernightIndexedSwapTest::testSeasonedCoupons() {
+
+    BOOST_TEST_MESSAGE("Testing seasoned overnight-indexed coupons...");
+
+    CommonVars vars;
+
+    // the projected part of seasoned coupons starts today
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    shared_ptr<Eonia> index = vars.eoniaIndex;
+    index->clearFixings();
+
+    // two years of fixings
+    Date d = vars.calendar.advance(vars.today, -2*Years);
+    for (Size k=0; d<vars.today; ++k) {
+        index->addFixing(d, 0.01 + 0.0005*(k%17));
+        d = vars.calendar.advance(d, 1, Days);
+    }
+
+    Date starts[] = {
+        vars.calendar.advance(vars.today, -18*Months),
+        vars.calendar.advance(vars.today, -6*Months),
+        vars.today - 3*Days,
+        vars.today - 1*Years    // possibly a holiday
+    };
+    Date end = vars.calendar.advance(vars.today, 6*Months);
+
+    Real tolerance = 1.0e-12;
+
+    for (Size n=0; n<3; ++n) {
+        for (Size j=0; j<LENGTH(starts); ++j) {
+            OvernightIndexedCoupon coupon(end, 1.0, starts[j], end, index);
+            Rate calculated = coupon.rate();
+            Rate expected =
+                expectedOvernightRate(coupon, vars.eoniaTermStructure);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce overnight coupon rate:"
+                            << std::setprecision(12)
+                            << "\n    start date: " << starts[j]
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        if (n == 0) {
+            // overwrite a fixing in the middle of the history; the
+            // compounding table must be updated
+            Date overwritten = vars.calendar.advance(vars.today, -9*Months);
+            index->addFixing(overwritten, 0.05, true);
+        } else if (n == 1) {
+            // clear the history and store it again with different
+            // values; the table must not be reused
+            TimeSeries<Real> history = index->timeSeries();
+            index->clearFixings();
+            for (TimeSeries<Real>::const_iterator i = history.begin();
+                 i != history.end(); ++i)
+                index->addFixing(i->first, i->second + 0.001);
+        }
+    }
+
+    // copies of the index keep their own tables, which must all be
+    // updated when the history changes through any of them.  The
+    // second time, enough updates are made that the ones since the
+    // tables were last used are no longer recorded.
+    shared_ptr<Eonia> copies[] = { index, shared_ptr<Eonia>(new Eonia(*index)) };
+    for (Size n=0; n<3; ++n) {
+        for (Size c=0; c<LENGTH(copies); ++c) {
+            OvernightIndexedCoupon coupon(end, 1.0, starts[0], end, copies[c]);
+            Rate calculated = coupon.rate();
+            Rate expected =
+                expectedOvernightRate(coupon, vars.eoniaTermStructure);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce overnight coupon rate "
+                            "with copy #" << c << " of the index:"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+        Date overwritten = vars.calendar.advance(vars.today, -12*Months);
+        Size updates = (n == 1 ? 150 : 1);
+        for (Size k=0; k<updates; ++k)
+            copies[1]->addFixing(overwritten, 0.02 + 0.0001*k, true);
+    }
+
+    // a missing fixing in the range must still be detected
+    Date missing = vars.calendar.advance(vars.today, -3*Months);
+    TimeSeries<Real> history = index->timeSeries();
+    index->clearFixings();
+    for (TimeSeries<Real>::const_iterator i = history.begin();
+         i != history.end(); ++i) {
+        if (i->first != missing)
+            index->addFixing(i->first, i->second);
+    }
+    OvernightIndexedCoupon coupon(end, 1.0, starts[1], end, index);
+    bool thrown = false;
+    try {
+        coupon.rate();
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_ERROR("missing fixing on " << missing << " not detected");
+
+    index->clearFixings();
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testCachedValue));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &OvernightIndexedSwapTest::testSeasonedCoupons));
     return suite;
 }
 
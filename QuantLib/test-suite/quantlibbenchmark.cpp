@@ -117,6 +117,7 @@
 #include "dividendoption.hpp"
 #include "europeanoption.hpp"
 #include "fdheston.hpp"
+#include "fdmlinearop.hpp"
 #include "hestonmodel.hpp"
 #include "interpolations.hpp"
 #include "jumpdiffusion.hpp"
@@ -263,6 +264,12 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &EuropeanOptionTest::testPriceCurve, 414.76));
     bm.push_back(Benchmark("FdHestonTest::testFdmHestonAmerican",
         &FdHestonTest::testFdmHestonAmerican, 234.21));
+    // the flop count of the tridiagonal solvers is estimated from
+    // the number of operations per grid point
+    bm.push_back(Benchmark("FdmLinearOp::LineByLineSolve",
+        &FdmLinearOpTest::benchmarkLineByLineSolve, 390.0));
+    bm.push_back(Benchmark("FdmLinearOp::InterleavedSolve",
+        &FdmLinearOpTest::benchmarkInterleavedSolve, 390.0));
     bm.push_back(Benchmark("HestonModel::DAXCalibration",
         &HestonModelTest::testDAXCalibration, 555.19));
     bm.push_back(Benchmark("InterpolationTest::testSabrInterpolation",
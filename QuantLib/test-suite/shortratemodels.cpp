@@ -25,7 +25,10 @@
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/models/shortrate/calibrationhelpers/caphelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/capfloor/treecapfloorengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
@@ -50,6 +53,18 @@ namespace {
         Volatility volatility;
     };
 
+    // counts the lattices actually built
+    class CountingHullWhite : public HullWhite {
+      public:
+        CountingHullWhite(const Handle<YieldTermStructure>& termStructure)
+        : HullWhite(termStructure), trees(0) {}
+        boost::shared_ptr<Lattice> tree(const TimeGrid& grid) const {
+            ++trees;
+            return HullWhite::tree(grid);
+        }
+        mutable Size trees;
+    };
+
 }
 
 
@@ -287,6 +302,298 @@ void ShortRateModelTest::testCachedHullWhite2() {
     }
 }
 
+void ShortRateModelTest::testSharedLatticeCalibration() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration on a shared lattice...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    Array params[2];
+    Real values[2][LENGTH(data)];
+    for (Size k=0; k<2; ++k) {
+        boost::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+
+        std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+        std::list<Time> times;
+        for (Size i=0; i<LENGTH(data); i++) {
+            boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            helper->addTimesTo(times);
+            swaptions.push_back(helper);
+        }
+
+        // either a lattice for each helper, or a single one on the
+        // union of their times; all swaptions end at the same date,
+        // hence the two lattices have comparable steps
+        boost::shared_ptr<PricingEngine> engine;
+        if (k == 0)
+            engine = boost::shared_ptr<PricingEngine>(
+                                          new TreeSwaptionEngine(model, 40));
+        else
+            engine = boost::shared_ptr<PricingEngine>(
+                  new TreeSwaptionEngine(model,
+                                         TimeGrid(times.begin(), times.end(),
+                                                  40)));
+        for (Size i=0; i<LENGTH(data); i++)
+            swaptions[i]->setPricingEngine(engine);
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        params[k] = model->params();
+        for (Size i=0; i<LENGTH(data); i++)
+            values[k][i] = swaptions[i]->modelValue();
+    }
+
+    // the shared lattice has different inner points, and the mean
+    // reversion is only loosely determined by the helpers
+    if (std::fabs(params[0][0]-params[1][0]) > 2.5e-3
+        || std::fabs(params[0][1]-params[1][1]) > 1.0e-4) {
+        BOOST_ERROR("Failed to reproduce calibration on a shared lattice:\n"
+                    << "separate lattices: a = " << params[0][0] << ", "
+                    << "sigma = " << params[0][1] << "\n"
+                    << "shared lattice:    a = " << params[1][0] << ", "
+                    << "sigma = " << params[1][1]);
+    }
+    for (Size i=0; i<LENGTH(data); i++) {
+        if (std::fabs(values[0][i]-values[1][i]) > 1.0e-2*values[0][i]) {
+            BOOST_ERROR("Failed to reproduce swaption value on a shared lattice:\n"
+                        << "swaption:          " << data[i].start << "x"
+                        << data[i].length << "\n"
+                        << "separate lattices: " << values[0][i] << "\n"
+                        << "shared lattice:    " << values[1][i]);
+        }
+    }
+}
+
+void ShortRateModelTest::testCachedLattice() {
+    BOOST_TEST_MESSAGE("Testing lattice sharing among tree engines...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    boost::shared_ptr<CountingHullWhite> model(
+                                     new CountingHullWhite(termStructure));
+    boost::shared_ptr<HullWhite> plainModel(new HullWhite(termStructure));
+
+    boost::shared_ptr<Quote> swaptionVol(new SimpleQuote(0.1108));
+    boost::shared_ptr<SwaptionHelper> swaption(
+                             new SwaptionHelper(Period(2, Years),
+                                                Period(4, Years),
+                                                Handle<Quote>(swaptionVol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+    boost::shared_ptr<Quote> capVol(new SimpleQuote(0.15));
+    boost::shared_ptr<CapHelper> cap(
+                             new CapHelper(Period(5, Years),
+                                           Handle<Quote>(capVol),
+                                           index, Annual, Thirty360(),
+                                           false, termStructure));
+    boost::shared_ptr<VanillaSwap> swap = swaption->underlyingSwap();
+
+    std::list<Time> times;
+    swaption->addTimesTo(times);
+    cap->addTimesTo(times);
+    TimeGrid grid(times.begin(), times.end(), 40);
+
+    // engines of different types on the same model and grid must
+    // share a single lattice...
+    swaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeSwaptionEngine(model, grid)));
+    cap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeCapFloorEngine(model, grid)));
+    swap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeVanillaSwapEngine(model, grid)));
+    Real values[] = { swaption->modelValue(), cap->modelValue(), swap->NPV() };
+    if (model->trees != 1)
+        BOOST_ERROR(model->trees << " lattices built for three engines "
+                    "on the same grid (1 expected)");
+
+    // ...which must give the same results as separate ones
+    Real plainValues[3];
+    swaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                new TreeSwaptionEngine(plainModel, grid)));
+    plainValues[0] = swaption->modelValue();
+    cap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                new TreeCapFloorEngine(plainModel, grid)));
+    plainValues[1] = cap->modelValue();
+    swap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                new TreeVanillaSwapEngine(plainModel, grid)));
+    plainValues[2] = swap->NPV();
+    std::string names[] = { "swaption", "cap", "swap" };
+    for (Size i=0; i<LENGTH(values); ++i) {
+        if (std::fabs(values[i]-plainValues[i]) > 1.0e-12)
+            BOOST_ERROR("Failed to reproduce " << names[i]
+                        << " value on a shared lattice:"
+                        << std::setprecision(12)
+                        << "\n    separate lattice: " << plainValues[i]
+                        << "\n    shared lattice:   " << values[i]);
+    }
+
+    // the lattice is built again, once, for each new parameter set
+    swaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeSwaptionEngine(model, grid)));
+    cap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeCapFloorEngine(model, grid)));
+    swap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new TreeVanillaSwapEngine(model, grid)));
+    Array params = model->params();
+    Array newParams = params;
+    newParams[1] *= 1.1;
+    model->setParams(newParams);
+    swaption->modelValue();
+    cap->modelValue();
+    swap->NPV();
+    model->setParams(params);
+    Real newValues[] = { swaption->modelValue(), cap->modelValue(),
+                         swap->NPV() };
+    if (model->trees != 3)
+        BOOST_ERROR(model->trees << " lattices built for three parameter "
+                    "sets (3 expected)");
+    for (Size i=0; i<LENGTH(values); ++i) {
+        if (newValues[i] != values[i])
+            BOOST_ERROR("Failed to reproduce " << names[i]
+                        << " value after resetting the parameters:"
+                        << std::setprecision(12)
+                        << "\n    original: " << values[i]
+                        << "\n    reset:    " << newValues[i]);
+    }
+
+    // engines without a grid share the lattice built on the
+    // mandatory times of the same instrument
+    model->trees = 0;
+    boost::shared_ptr<PricingEngine> engine1(
+                                          new TreeSwaptionEngine(model, 40));
+    boost::shared_ptr<PricingEngine> engine2(
+                                          new TreeSwaptionEngine(model, 40));
+    swaption->setPricingEngine(engine1);
+    swaption->modelValue();
+    swaption->setPricingEngine(engine2);
+    swaption->modelValue();
+    if (model->trees != 1)
+        BOOST_ERROR(model->trees << " lattices built for two engines "
+                    "on the same instrument (1 expected)");
+}
+
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with one engine per helper...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    // with a separate engine for each helper, the helpers can be
+    // evaluated concurrently; the results must not change
+    Array params[2];
+    for (Size k=0; k<2; ++k) {
+        const bool separateEngines = (k == 1);
+        boost::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        model->enableConcurrentCalibration(separateEngines);
+        boost::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+
+        std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+        for (Size i=0; i<LENGTH(data); i++) {
+            boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            if (separateEngines)
+                engine = boost::shared_ptr<PricingEngine>(
+                                         new JamshidianSwaptionEngine(model));
+            helper->setPricingEngine(engine);
+            swaptions.push_back(helper);
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        params[k] = model->params();
+    }
+
+    // concurrent evaluation must be refused for a shared engine
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+    model->enableConcurrentCalibration();
+    boost::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+    std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+        helper->setPricingEngine(engine);
+        swaptions.push_back(helper);
+    }
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+    try {
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+        BOOST_ERROR("concurrent calibration with a shared engine "
+                    "was not refused");
+    } catch (Error&) {
+        // as expected
+    }
+
+    Real tolerance = 1.0e-12;
+    if (std::fabs(params[0][0]-params[1][0]) > tolerance
+        || std::fabs(params[0][1]-params[1][1]) > tolerance) {
+        BOOST_ERROR("Failed to reproduce calibration with separate engines:\n"
+                    << std::setprecision(12)
+                    << "shared engine:    a = " << params[0][0] << ", "
+                    << "sigma = " << params[0][1] << "\n"
+                    << "separate engines: a = " << params[1][0] << ", "
+                    << "sigma = " << params[1][1]);
+    }
+}
+
 void ShortRateModelTest::testSwaps() {
     BOOST_TEST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
@@ -432,6 +739,11 @@ test_suite* ShortRateModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &ShortRateModelTest::testSharedLatticeCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedLattice));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &ShortRateModelTest::testParallelCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     return suite;
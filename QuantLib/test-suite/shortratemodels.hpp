@@ -31,6 +31,9 @@ class ShortRateModelTest {
     static void testCachedHullWhite();
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
+    static void testSharedLatticeCalibration();
+    static void testCachedLattice();
+    static void testParallelCalibration();
     static void testSwaps();
     static boost::unit_test_framework::test_suite* suite();
 };
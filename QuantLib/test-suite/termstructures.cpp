@@ -25,10 +25,17 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/nonlinearfittingmethods.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/math/optimization/bfgs.hpp>
+#include <ql/math/optimization/simplex.hpp>
+#include <ql/time/schedule.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
@@ -316,6 +323,166 @@ void TermStructureTest::testLinkToNullUnderlying() {
     underlying.linkTo(boost::shared_ptr<YieldTermStructure>());
 }
 
+void TermStructureTest::testFittedBondCurveGradients() {
+    BOOST_TEST_MESSAGE(
+        "Testing fitted bond curves with analytic gradients...");
+
+    CommonVars vars;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> curve(vars.termStructure);
+    boost::shared_ptr<PricingEngine> engine(
+                                        new DiscountingBondEngine(curve));
+
+    Integer maturities[] = { 2, 3, 4, 5, 7, 10, 12, 15, 20, 25 };
+    Rate coupons[] = { 0.0400, 0.0425, 0.0450, 0.0500, 0.0475,
+                       0.0550, 0.0525, 0.0575, 0.0600, 0.0550 };
+
+    std::vector<boost::shared_ptr<BondHelper> > helpers;
+    for (Size i=0; i<LENGTH(maturities); ++i) {
+        Date issue = vars.calendar.advance(today, -6, Months);
+        Schedule schedule(issue, issue + maturities[i]*Years,
+                          Period(Semiannual), vars.calendar,
+                          Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+        boost::shared_ptr<BondHelper> helper(
+            new FixedRateBondHelper(Handle<Quote>(quote),
+                                    vars.settlementDays, 100.0, schedule,
+                                    std::vector<Rate>(1, coupons[i]),
+                                    ActualActual(ActualActual::Bond)));
+        helper->bond()->setPricingEngine(engine);
+        quote->setValue(helper->bond()->cleanPrice());
+        helpers.push_back(helper);
+    }
+
+    std::vector<Time> knots;
+    Real knotTimes[] = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                         20.0, 25.0, 30.0, 40.0, 50.0 };
+    knots.assign(knotTimes, knotTimes+LENGTH(knotTimes));
+
+    boost::shared_ptr<OptimizationMethod> simplex(new Simplex(1.0));
+    boost::shared_ptr<OptimizationMethod> bfgs(new BFGS);
+
+    // the default methods use BFGS when starting from a guess only
+    // if gradient optimization is enabled; otherwise, they use Simplex
+    std::vector<boost::shared_ptr<FittedBondDiscountCurve::FittingMethod> >
+        simplexMethods, gradientMethods, defaultMethods;
+    std::vector<std::string> names;
+    std::vector<Array> guesses;
+
+    names.push_back("Nelson-Siegel");
+    simplexMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                                        new NelsonSiegelFitting(simplex)));
+    defaultMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(new NelsonSiegelFitting));
+    gradientMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                                           new NelsonSiegelFitting(bfgs)));
+    Real nsGuess[] = { 0.05, -0.01, 0.0, 0.5 };
+    guesses.push_back(Array(nsGuess, nsGuess+4));
+
+    names.push_back("Svensson");
+    simplexMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(new SvenssonFitting(simplex)));
+    defaultMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(new SvenssonFitting));
+    gradientMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(new SvenssonFitting(bfgs)));
+    Real svGuess[] = { 0.05, -0.01, 0.0, 0.0, 0.5, 0.1 };
+    guesses.push_back(Array(svGuess, svGuess+6));
+
+    names.push_back("exponential splines");
+    simplexMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                             new ExponentialSplinesFitting(true, simplex)));
+    defaultMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                                            new ExponentialSplinesFitting));
+    gradientMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                                new ExponentialSplinesFitting(true, bfgs)));
+    Array esGuess(9, 0.0);
+    esGuess[8] = 0.05;
+    guesses.push_back(esGuess);
+
+    names.push_back("cubic B-splines");
+    simplexMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                         new CubicBSplinesFitting(knots, true, simplex)));
+    defaultMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                                        new CubicBSplinesFitting(knots)));
+    gradientMethods.push_back(boost::shared_ptr<
+        FittedBondDiscountCurve::FittingMethod>(
+                            new CubicBSplinesFitting(knots, true, bfgs)));
+    guesses.push_back(Array(6, 0.5));
+
+    for (Size i=0; i<names.size(); ++i) {
+        FittedBondDiscountCurve plainCurve(today, helpers, Actual365Fixed(),
+                                           *defaultMethods[i], 1.0e-10,
+                                           10000, guesses[i]);
+        defaultMethods[i]->enableGradientOptimization();
+        FittedBondDiscountCurve simplexCurve(today, helpers, Actual365Fixed(),
+                                             *simplexMethods[i], 1.0e-10,
+                                             10000, guesses[i]);
+        FittedBondDiscountCurve gradientCurve(today, helpers,
+                                              Actual365Fixed(),
+                                              *gradientMethods[i], 1.0e-10,
+                                              10000, guesses[i]);
+        FittedBondDiscountCurve defaultCurve(today, helpers,
+                                             Actual365Fixed(),
+                                             *defaultMethods[i], 1.0e-10,
+                                             10000, guesses[i]);
+        Real simplexCost = simplexCurve.fitResults().minimumCostValue();
+        Real gradientCost = gradientCurve.fitResults().minimumCostValue();
+        Real defaultCost = defaultCurve.fitResults().minimumCostValue();
+        Real plainCost = plainCurve.fitResults().minimumCostValue();
+        if (plainCost != simplexCost)
+            BOOST_ERROR("default " << names[i] << " fit doesn't use Simplex:"
+                        << std::scientific
+                        << "\n    cost with Simplex: " << simplexCost
+                        << "\n    cost by default:   " << plainCost);
+        // the gradient-based fits must do at least as well
+        if (gradientCost > simplexCost*1.01 + 1.0e-10)
+            BOOST_ERROR("gradient-based " << names[i] << " fit failed:"
+                        << std::scientific
+                        << "\n    cost with Simplex: " << simplexCost
+                        << "\n    cost with BFGS:    " << gradientCost);
+        if (defaultCost > simplexCost*1.01 + 1.0e-10)
+            BOOST_ERROR("gradient-enabled " << names[i] << " fit failed:"
+                        << std::scientific
+                        << "\n    cost with Simplex: " << simplexCost
+                        << "\n    cost with gradient: " << defaultCost);
+    }
+
+    // multiple starting points can only improve the fit
+    NelsonSiegelFitting nelsonSiegel;
+    nelsonSiegel.enableGradientOptimization();
+    FittedBondDiscountCurve singleStart(today, helpers, Actual365Fixed(),
+                                        nelsonSiegel, 1.0e-10, 10000,
+                                        guesses[0]);
+    std::vector<Array> startingPoints(3, guesses[0]);
+    startingPoints[0][3] = 0.1;
+    startingPoints[1][3] = 1.0;
+    startingPoints[2][0] = 0.03;
+    nelsonSiegel.setStartingPoints(startingPoints);
+    FittedBondDiscountCurve multiStart(today, helpers, Actual365Fixed(),
+                                       nelsonSiegel, 1.0e-10, 10000,
+                                       guesses[0]);
+    Real singleCost = singleStart.fitResults().minimumCostValue();
+    Real multiCost = multiStart.fitResults().minimumCostValue();
+    if (multiCost > singleCost)
+        BOOST_ERROR("multi-start fit worse than single-start fit:"
+                    << std::scientific
+                    << "\n    single start: " << singleCost
+                    << "\n    multi start:  " << multiCost);
+    if (multiStart.fitResults().numberOfIterations() <=
+        singleStart.fitResults().numberOfIterations())
+        BOOST_ERROR("evaluations of multi-start fit not accounted for");
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -327,6 +494,8 @@ test_suite* TermStructureTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreadedObs));
     suite->add(QUANTLIB_TEST_CASE(
                              &TermStructureTest::testLinkToNullUnderlying));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &TermStructureTest::testFittedBondCurveGradients));
     return suite;
 }
 
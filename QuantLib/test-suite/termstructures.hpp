@@ -35,6 +35,7 @@ class TermStructureTest {
     static void testZSpreaded();
     static void testZSpreadedObs();
     static void testLinkToNullUnderlying();
+    static void testFittedBondCurveGradients();
     static boost::unit_test_framework::test_suite* suite();
 };
 
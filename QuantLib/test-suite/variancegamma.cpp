@@ -23,6 +23,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/instruments/europeanoption.hpp>
 #include <ql/experimental/variancegamma/analyticvariancegammaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/cosvariancegammaengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -202,6 +203,53 @@ void VarianceGammaTest::testVarianceGamma() {
                     error, tol);
             }
         }
+
+        // Test FFT engine with a fractional transform, whose strike grid
+        // only covers the requested strikes
+        boost::shared_ptr<FFTVarianceGammaEngine> fractionalEngine(
+            new FFTVarianceGammaEngine(stochProcess, 0.001, 512));
+        fractionalEngine->precalculate(optionList);
+        for (Size j=0; j<LENGTH(options); j++)
+        {
+            boost::shared_ptr<VanillaOption> option = boost::static_pointer_cast<VanillaOption>(optionList[j]);
+            option->setPricingEngine(fractionalEngine);
+
+            Real calculated = option->NPV();
+            Real expected = results[i][j];
+            Real error = std::fabs(calculated-expected);
+            if (error>tol) {
+                boost::shared_ptr<StrikedTypePayoff> payoff = 
+                    boost::dynamic_pointer_cast<StrikedTypePayoff>(option->payoff());
+                REPORT_FAILURE("fractional fft value", payoff, option->exercise(),
+                    processes[i].s, processes[i].q, processes[i].r,
+                    today, processes[i].sigma, processes[i].nu,
+                    processes[i].theta, expected, calculated,
+                    error, tol);
+            }
+        }
+
+        // Test COS engine
+        boost::shared_ptr<PricingEngine> cosEngine(
+            new COSVarianceGammaEngine(boost::shared_ptr<VarianceGammaModel>(
+                                 new VarianceGammaModel(stochProcess))));
+        for (Size j=0; j<LENGTH(options); j++)
+        {
+            boost::shared_ptr<VanillaOption> option = boost::static_pointer_cast<VanillaOption>(optionList[j]);
+            option->setPricingEngine(cosEngine);
+
+            Real calculated = option->NPV();
+            Real expected = results[i][j];
+            Real error = std::fabs(calculated-expected);
+            if (error>tol) {
+                boost::shared_ptr<StrikedTypePayoff> payoff = 
+                    boost::dynamic_pointer_cast<StrikedTypePayoff>(option->payoff());
+                REPORT_FAILURE("cos value", payoff, option->exercise(),
+                    processes[i].s, processes[i].q, processes[i].r,
+                    today, processes[i].sigma, processes[i].nu,
+                    processes[i].theta, expected, calculated,
+                    error, tol);
+            }
+        }
     }
 }
 